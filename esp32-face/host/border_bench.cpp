@@ -0,0 +1,96 @@
+// Frame cost of the conversation border renderers (conv_border.cpp) against
+// their per-pixel references (border_ref.h), in us per frame on a full
+// 320x240 canvas:
+//   attention — the last frame of the ATTENTION sweep, its widest (worst) case;
+//   ring      — a settled frame glow over background (ring copy) and over
+//               drawn content (ring blend), without the orbit dots;
+//   dots      — the three THINKING orbit dots, sprites vs per-pixel coverage.
+//
+// Usage: border_bench [--passes N]
+
+#include "border_ref.h"
+#include "config.h"
+#include "conv_border.h"
+#include "pixel.h"
+#include "protocol.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+
+constexpr float ATTENTION_LAST_FRAME_S = 0.4f - 1.0f / ANIM_FPS / 4.0f; // sweep ~19.8 px
+
+// Runs fn on a fresh copy of src each pass; only fn is timed.
+template <typename Fn> double us_per_frame(const std::vector<pixel_t>& src, int passes, Fn fn)
+{
+    std::vector<pixel_t> buf(src.size());
+    double               ns = 0.0;
+    for (int p = 0; p < passes; p++) {
+        buf = src;
+        const auto t0 = std::chrono::steady_clock::now();
+        fn(buf.data());
+        const auto t1 = std::chrono::steady_clock::now();
+        ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+    }
+    return ns / passes / 1000.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int passes = 500;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--passes") == 0 && i + 1 < argc) {
+            passes = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: %s [--passes N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    DirtyRegion full;
+    full.full = true;
+
+    std::vector<pixel_t> background(SCREEN_W * SCREEN_H, px_rgb(0, 0, 0));
+    std::vector<pixel_t> content(SCREEN_W * SCREEN_H);
+    srand(1);
+    for (auto& p : content) p = static_cast<pixel_t>(rand());
+
+    conv_border_set_state(static_cast<uint8_t>(FaceConvState::ATTENTION));
+    conv_border_update(ATTENTION_LAST_FRAME_S);
+    const double att = us_per_frame(content, passes, [&](pixel_t* b) { conv_border_render(b, full); });
+    const double att_ref =
+        us_per_frame(content, passes, [](pixel_t* b) { border_ref_attention(b, ATTENTION_LAST_FRAME_S); });
+
+    // Settled glow; DONE has no orbit dots, so this times the frame alone.
+    conv_border_set_state(static_cast<uint8_t>(FaceConvState::LISTENING));
+    for (int i = 0; i < ANIM_FPS * 2; i++) conv_border_update(1.0f / ANIM_FPS);
+    conv_border_set_state(static_cast<uint8_t>(FaceConvState::DONE));
+    uint8_t r, g, b, a;
+    conv_border_get_glow(r, g, b, a);
+    const double ring_bg = us_per_frame(background, passes, [&](pixel_t* p) { conv_border_render(p, full); });
+    const double ring_content = us_per_frame(content, passes, [&](pixel_t* p) { conv_border_render(p, full); });
+    const double ring_ref = us_per_frame(background, passes, [&](pixel_t* p) { border_ref_draw(p, r, g, b, a); });
+
+    // Settled THINKING: ring copy plus the dot sprites.
+    conv_border_set_state(static_cast<uint8_t>(FaceConvState::THINKING));
+    for (int i = 0; i < ANIM_FPS * 3; i++) conv_border_update(1.0f / ANIM_FPS);
+    const double thinking = us_per_frame(background, passes, [&](pixel_t* p) { conv_border_render(p, full); });
+    const double dots_ref = us_per_frame(background, passes, [](pixel_t* p) { border_ref_dots(p, 0.3f); });
+
+    std::printf("%-44s %8s\n", "border frame", "us");
+    std::printf("%-44s %8.2f\n", "attention last frame, per-pixel (reference)", att_ref);
+    std::printf("%-44s %8.2f\n", "attention last frame", att);
+    std::printf("%-44s %8.2f\n", "frame glow, per-pixel SDF (reference)", ring_ref);
+    std::printf("%-44s %8.2f\n", "frame glow, ring over background", ring_bg);
+    std::printf("%-44s %8.2f\n", "frame glow, ring over content", ring_content);
+    std::printf("%-44s %8.2f\n", "orbit dots, per-pixel (reference)", dots_ref);
+    std::printf("%-44s %8.2f\n", "thinking: ring over background + dot sprites", thinking);
+    return 0;
+}
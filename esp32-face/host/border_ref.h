@@ -0,0 +1,191 @@
+#pragma once
+// Reference border renderers from conv_border.cpp before their caches: the
+// per-pixel frame glow blend_frame_mask() drew (rounded inner SDF, solid
+// outside it and a quadratic glow ramp inside), the per-pixel ATTENTION sweep
+// and the analytic THINKING orbit dots. Host-only: the source for
+// test_border_ring and border_bench.
+
+#include "config.h"
+#include "pixel.h"
+
+#include <cmath>
+
+constexpr int   BORDER_REF_FRAME_W = 4;
+constexpr int   BORDER_REF_GLOW_W = 3;
+constexpr float BORDER_REF_CORNER_R = 3.0f;
+constexpr float BORDER_REF_ATTENTION_DURATION = 0.4f;
+constexpr int   BORDER_REF_ATTENTION_DEPTH = 20;
+constexpr float BORDER_REF_DOT_R = 4.0f;
+constexpr float BORDER_REF_DOT_SPACING = 0.12f;
+
+inline float border_ref_clampf(float v, float lo, float hi)
+{
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+inline uint8_t border_ref_alpha_u8(float a)
+{
+    if (a < 0.0f) a = 0.0f;
+    if (a > 1.0f) a = 1.0f;
+    return static_cast<uint8_t>(a * 255.0f + 0.5f);
+}
+
+// Frame alpha at pixel (x, y), 8-bit.
+inline uint8_t border_ref_mask(int x, int y)
+{
+    const float r = BORDER_REF_CORNER_R;
+    const float px = static_cast<float>(x) + 0.5f;
+    const float py = static_cast<float>(y) + 0.5f;
+    const float dx = fabsf(px - SCREEN_W / 2.0f) - (SCREEN_W / 2.0f - BORDER_REF_FRAME_W) + r;
+    const float dy = fabsf(py - SCREEN_H / 2.0f) - (SCREEN_H / 2.0f - BORDER_REF_FRAME_W) + r;
+    const float mx = fmaxf(dx, 0.0f);
+    const float my = fmaxf(dy, 0.0f);
+    const float d = fminf(fmaxf(dx, dy), 0.0f) + sqrtf(mx * mx + my * my) - r;
+    if (d > 0.0f) return 255;
+    if (d <= -BORDER_REF_GLOW_W) return 0;
+    const float t = (d + BORDER_REF_GLOW_W) / static_cast<float>(BORDER_REF_GLOW_W);
+    return border_ref_alpha_u8(t * t);
+}
+
+// Blends the frame in (r, g, b) scaled by alpha (0..255) over buf
+// (SCREEN_W x SCREEN_H), every pixel independently.
+inline void border_ref_draw(pixel_t* buf, uint8_t r, uint8_t g, uint8_t b, uint8_t alpha)
+{
+    if (alpha == 0) return;
+    for (int y = 0; y < SCREEN_H; y++) {
+        for (int x = 0; x < SCREEN_W; x++) {
+            const uint8_t m = border_ref_mask(x, y);
+            if (m == 0) continue;
+            const uint8_t a = static_cast<uint8_t>((static_cast<uint16_t>(m) * alpha + 127U) / 255U);
+            buf[y * SCREEN_W + x] = px_blend_u8(buf[y * SCREEN_W + x], r, g, b, a);
+        }
+    }
+}
+
+// ATTENTION sweep at timer seconds into the state: every pixel within the
+// sweep depth of an edge, evaluated per pixel.
+inline void border_ref_attention(pixel_t* buf, float timer)
+{
+    const float progress = timer / BORDER_REF_ATTENTION_DURATION;
+    const float sweep = static_cast<float>(BORDER_REF_ATTENTION_DEPTH) * progress;
+    const float fade_global = 1.0f - progress * 0.5f;
+    const int   limit = static_cast<int>(sweep) + 1;
+
+    const uint8_t r = 180, g = 240, b = 255; // CONV_COLORS[ATTENTION]
+
+    for (int y = 0; y < SCREEN_H; y++) {
+        const int dv = (y < SCREEN_H - 1 - y) ? y : (SCREEN_H - 1 - y);
+        const int row = y * SCREEN_W;
+        if (dv > limit) {
+            // Only left/right edges
+            for (int x = 0; x < limit && x < SCREEN_W; x++) {
+                const float dist = static_cast<float>(x);
+                if (dist < sweep) {
+                    const float f = (1.0f - dist / fmaxf(1.0f, sweep)) * fade_global;
+                    const float a = f * f;
+                    if (a > 0.01f) {
+                        buf[row + x] = px_blend_u8(buf[row + x], r, g, b, px_alpha_u8(a));
+                    }
+                }
+            }
+            for (int x = SCREEN_W - limit; x < SCREEN_W; x++) {
+                if (x < 0) continue;
+                const float dist = static_cast<float>(SCREEN_W - 1 - x);
+                if (dist < sweep) {
+                    const float f = (1.0f - dist / fmaxf(1.0f, sweep)) * fade_global;
+                    const float a = f * f;
+                    if (a > 0.01f) {
+                        buf[row + x] = px_blend_u8(buf[row + x], r, g, b, px_alpha_u8(a));
+                    }
+                }
+            }
+        } else {
+            // Full row
+            for (int x = 0; x < SCREEN_W; x++) {
+                const int   dh = (x < SCREEN_W - 1 - x) ? x : (SCREEN_W - 1 - x);
+                const float dist = static_cast<float>((dh < dv) ? dh : dv);
+                if (dist < sweep) {
+                    const float f = (1.0f - dist / fmaxf(1.0f, sweep)) * fade_global;
+                    const float a = f * f;
+                    if (a > 0.01f) {
+                        buf[row + x] = px_blend_u8(buf[row + x], r, g, b, px_alpha_u8(a));
+                    }
+                }
+            }
+        }
+    }
+}
+
+inline void border_ref_perimeter_xy(float t, float& out_x, float& out_y)
+{
+    const float inset = BORDER_REF_FRAME_W / 2.0f;
+    const float w = SCREEN_W - 2.0f * inset;
+    const float h = SCREEN_H - 2.0f * inset;
+    const float perim = 2.0f * (w + h);
+    float       d = fmodf(t, 1.0f);
+    if (d < 0.0f) d += 1.0f;
+    d *= perim;
+    if (d < w) {
+        out_x = inset + d;
+        out_y = inset;
+        return;
+    }
+    d -= w;
+    if (d < h) {
+        out_x = inset + w;
+        out_y = inset + d;
+        return;
+    }
+    d -= h;
+    if (d < w) {
+        out_x = inset + w - d;
+        out_y = inset + h;
+        return;
+    }
+    d -= w;
+    out_x = inset;
+    out_y = inset + h - d;
+}
+
+// THINKING orbit dots at orbit_pos (0..1 around the perimeter), coverage
+// evaluated per pixel at the exact center.
+inline void border_ref_dots(pixel_t* buf, float orbit_pos)
+{
+    static constexpr float brightnesses[] = {1.0f, 0.7f, 0.4f};
+    const float            r = BORDER_REF_DOT_R;
+    const float            dot_col[3] = {120.0f, 100.0f, 255.0f}; // CONV_COLORS[THINKING]
+
+    for (int i = 0; i < 3; i++) {
+        float pos = fmodf(orbit_pos - static_cast<float>(i) * BORDER_REF_DOT_SPACING, 1.0f);
+        if (pos < 0.0f) pos += 1.0f;
+
+        float dx, dy;
+        border_ref_perimeter_xy(pos, dx, dy);
+
+        const float   bri = brightnesses[i];
+        const uint8_t cr = static_cast<uint8_t>(border_ref_clampf(dot_col[0] * bri, 0.0f, 255.0f));
+        const uint8_t cg = static_cast<uint8_t>(border_ref_clampf(dot_col[1] * bri, 0.0f, 255.0f));
+        const uint8_t cb = static_cast<uint8_t>(border_ref_clampf(dot_col[2] * bri, 0.0f, 255.0f));
+
+        const int x0 = static_cast<int>(fmaxf(0.0f, dx - r - 1.0f));
+        const int x1 = static_cast<int>(fminf(static_cast<float>(SCREEN_W), dx + r + 2.0f));
+        const int y0 = static_cast<int>(fmaxf(0.0f, dy - r - 1.0f));
+        const int y1 = static_cast<int>(fminf(static_cast<float>(SCREEN_H), dy + r + 2.0f));
+
+        for (int y = y0; y < y1; y++) {
+            const int row = y * SCREEN_W;
+            for (int x = x0; x < x1; x++) {
+                const float ddx = static_cast<float>(x) + 0.5f - dx;
+                const float ddy = static_cast<float>(y) + 0.5f - dy;
+                const float d = sqrtf(ddx * ddx + ddy * ddy);
+                if (d < r) {
+                    const float ratio = d / r;
+                    float       a = fminf(1.0f, (1.0f - ratio * ratio) * 2.5f);
+                    if (a > 0.01f) {
+                        buf[row + x] = px_blend_u8(buf[row + x], cr, cg, cb, px_alpha_u8(a));
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,135 @@
+// Dirty-rect merge policy sweep: every render scenario (sparkle off, which
+// forces full frames) is rendered under each DirtyPolicy and the pushed
+// region is costed the way panel_present.cpp sends it. Per frame:
+//   bytes — RGB565 payload on the SPI bus;
+//   rects — dirty rects pushed;
+//   calls — esp_lcd_panel_draw_bitmap() calls (one per FACE_PRESENT_STRIP_PX strip);
+//   ms    — bytes at SPI_FREQ_HZ plus --call-us per call, the modeled bus time.
+// The last table sums all scenarios per policy; FACE_DIRTY_RECT_COST_PX is
+// the cost with the lowest modeled total.
+//
+// Usage: dirty_bench [--frames N] [--call-us US]
+
+#include "config.h"
+#include "esp_timer.h"
+#include "face_present.h"
+#include "face_render.h"
+#include "render_cases.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+
+constexpr int64_t  FRAME_PERIOD_US = 1'000'000 / ANIM_FPS;
+constexpr uint8_t  MAX_RECTS[] = {4, 8, 16};
+constexpr uint16_t RECT_COSTS[] = {0, 50, 100, 200, 400, 800, 1600, 3200};
+
+pixel_t s_canvas[SCREEN_W * SCREEN_H];
+pixel_t s_afterglow[AFTERGLOW_W * AFTERGLOW_H];
+
+struct Totals {
+    uint64_t bytes = 0;
+    uint64_t rects = 0;
+    uint64_t calls = 0;
+};
+
+Totals run_case(const RenderCase& c, const DirtyPolicy& policy, int frames)
+{
+    host_timer_set_manual(true);
+    srand(1234);
+    face_render_set_dirty_policy(policy);
+    face_render_init(s_afterglow, 1);
+
+    Totals    t;
+    FaceState fs = render_case_begin(c);
+    fs.fx.sparkle = false;
+    for (int i = 0; i < frames; i++) {
+        render_case_step(c, fs, i);
+        const DirtyRegion dirty = face_render_frame(s_canvas, fs, nullptr);
+        if (i > 0) { // the first frame is always full
+            face_present_for_each_rect(dirty, [&](const RectI& r) {
+                const int w = r.x1 - r.x0 + 1;
+                const int h = r.y1 - r.y0 + 1;
+                const int rows_per_strip = FACE_PRESENT_STRIP_PX / w;
+                t.bytes += static_cast<uint64_t>(w * h) * sizeof(pixel_t);
+                t.rects++;
+                t.calls += static_cast<uint64_t>((h + rows_per_strip - 1) / rows_per_strip);
+            });
+        }
+        host_timer_advance_us(FRAME_PERIOD_US);
+    }
+    return t;
+}
+
+double modeled_ms(const Totals& t, int frames, double call_us)
+{
+    const double bytes_per_us = SPI_FREQ_HZ / 8.0 / 1e6;
+    return (static_cast<double>(t.bytes) / bytes_per_us + static_cast<double>(t.calls) * call_us) / frames / 1000.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int    frames = 240;
+    double call_us = 40.0;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--call-us") == 0 && i + 1 < argc) {
+            call_us = std::atof(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: %s [--frames N] [--call-us US]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (frames < 2) frames = 2;
+    const int pushed = frames - 1;
+
+    constexpr int N_MAX = sizeof(MAX_RECTS) / sizeof(MAX_RECTS[0]);
+    constexpr int N_COST = sizeof(RECT_COSTS) / sizeof(RECT_COSTS[0]);
+    Totals        sum[N_MAX][N_COST] = {};
+
+    std::printf("%-12s %5s %5s %8s %6s %6s %7s\n", "scenario", "max", "cost", "B/frame", "rects", "calls", "ms");
+    for (const RenderCase& c : RENDER_CASES) {
+        for (int m = 0; m < N_MAX; m++) {
+            for (int k = 0; k < N_COST; k++) {
+                DirtyPolicy policy;
+                policy.max_rects = MAX_RECTS[m];
+                policy.rect_cost_px = RECT_COSTS[k];
+                const Totals t = run_case(c, policy, frames);
+                sum[m][k].bytes += t.bytes;
+                sum[m][k].rects += t.rects;
+                sum[m][k].calls += t.calls;
+                std::printf("%-12s %5u %5u %8llu %6.2f %6.2f %7.3f\n", c.name, MAX_RECTS[m], RECT_COSTS[k],
+                            static_cast<unsigned long long>(t.bytes / pushed),
+                            static_cast<double>(t.rects) / pushed, static_cast<double>(t.calls) / pushed,
+                            modeled_ms(t, pushed, call_us));
+            }
+        }
+    }
+
+    std::printf("\nall scenarios, --call-us %.1f\n", call_us);
+    std::printf("%5s %5s %8s %6s %6s %7s\n", "max", "cost", "B/frame", "rects", "calls", "ms");
+    const int n_cases = static_cast<int>(sizeof(RENDER_CASES) / sizeof(RENDER_CASES[0]));
+    int       best_m = 0;
+    int       best_k = 0;
+    for (int m = 0; m < N_MAX; m++) {
+        for (int k = 0; k < N_COST; k++) {
+            const Totals& t = sum[m][k];
+            const int     n = pushed * n_cases;
+            std::printf("%5u %5u %8llu %6.2f %6.2f %7.3f\n", MAX_RECTS[m], RECT_COSTS[k],
+                        static_cast<unsigned long long>(t.bytes / n), static_cast<double>(t.rects) / n,
+                        static_cast<double>(t.calls) / n, modeled_ms(t, n, call_us));
+            if (modeled_ms(t, n, call_us) < modeled_ms(sum[best_m][best_k], n, call_us)) {
+                best_m = m;
+                best_k = k;
+            }
+        }
+    }
+    std::printf("lowest modeled time: max_rects %u, rect_cost_px %u\n", MAX_RECTS[best_m], RECT_COSTS[best_k]);
+    return 0;
+}
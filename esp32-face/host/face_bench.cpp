@@ -0,0 +1,442 @@
+// Host frame-time bench for the face renderer — Stage 4 scenarios on Linux.
+//
+// Drives FaceState + conv_border + face_render_frame() exactly like
+// face_ui_task does (minus LVGL, SPI and vTaskDelay) and writes a JSON
+// artifact in the docs/perf/face_stage4_*.json schema, with per-stage
+// p50/p95 added. Numbers are host CPU time: use them for relative
+// before/after comparisons, not as device frame budgets.
+//
+// Usage: face_bench [--frames N] [--scenario NAME] [--seed S] [--threads 1|2] [--afterglow] [--out PATH]
+
+#include "config.h"
+#include "conv_border.h"
+#include "esp_timer.h"
+#include "face_render.h"
+#include "face_state.h"
+#include "host_render_worker.h"
+#include "mouth_cache.h"
+#include "protocol.h"
+#include "system_face.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr int      WARMUP_FRAMES = ANIM_FPS * 2; // let border fades and springs settle
+constexpr int64_t  FRAME_PERIOD_US = 1'000'000 / ANIM_FPS;
+constexpr uint8_t  DEFAULT_FACE_FLAGS = static_cast<uint8_t>(FACE_FLAGS_ALL & ~FACE_FLAG_AFTERGLOW);
+constexpr uint32_t DEFAULT_SEED = 0x5EED;
+
+struct Scenario {
+    const char*   name;
+    Mood          mood;
+    FaceConvState conv_state;
+    bool          talking;
+    uint8_t       energy;
+    bool          rage;
+    SystemMode    system = SystemMode::NONE;
+    float         system_param = 0.0f;
+    uint32_t      face_p95_budget_us = 0; // host render p95 under SystemRenderer::FACE, 0 = none
+    uint32_t      v2_p95_budget_us = 0;   // ... and under SystemRenderer::OVERLAY_V2
+};
+
+// Mirrors supervisor/api/mcu_benchmark_face.py SCENARIOS. "listening" drives
+// FaceConvState::LISTENING directly (the device run uses listening_proxy).
+// The sys_* scenarios are host-only and hold one system mode under the
+// selected --system renderer; their render p95 budget for that renderer is
+// checked every run. Budgets are twice the worst p95 measured over 30- and
+// 600-frame runs (Release host build), so a mode that gets ~2x slower fails.
+constexpr Scenario SCENARIOS[] = {
+    {"idle", Mood::NEUTRAL, FaceConvState::IDLE, false, 0, false},
+    {"listening", Mood::NEUTRAL, FaceConvState::LISTENING, false, 0, false},
+    {"thinking_border", Mood::NEUTRAL, FaceConvState::THINKING, false, 0, false},
+    {"talking_energy", Mood::HAPPY, FaceConvState::SPEAKING, true, 180, false},
+    {"rage_effects", Mood::ANGRY, FaceConvState::IDLE, false, 0, true},
+    {"sys_booting", Mood::NEUTRAL, FaceConvState::IDLE, false, 0, false, SystemMode::BOOTING, 0.0f, 120, 950},
+    {"sys_error", Mood::NEUTRAL, FaceConvState::IDLE, false, 0, false, SystemMode::ERROR_DISPLAY, 0.0f, 100, 500},
+    {"sys_battery", Mood::NEUTRAL, FaceConvState::IDLE, false, 0, false, SystemMode::LOW_BATTERY, 0.15f, 170, 2600},
+    {"sys_updating", Mood::NEUTRAL, FaceConvState::IDLE, false, 0, false, SystemMode::UPDATING, 0.4f, 80, 650},
+    {"sys_shutdown", Mood::NEUTRAL, FaceConvState::IDLE, false, 0, false, SystemMode::SHUTTING_DOWN, 0.0f, 130, 450},
+};
+
+// Per-frame samples for one scenario.
+struct Samples {
+    std::vector<uint32_t> frame_us;
+    std::vector<uint32_t> render_us;
+    std::vector<uint32_t> clear_us;
+    std::vector<uint32_t> eyes_us;
+    std::vector<uint32_t> mouth_us;
+    std::vector<uint32_t> border_us;
+    std::vector<uint32_t> effects_us;
+    std::vector<uint32_t> overlay_us;
+    std::vector<uint32_t> dirty_px;
+    std::vector<uint32_t> clear_px;
+    std::vector<uint32_t> band_wait_us;
+    uint32_t              split_frames = 0;
+    uint32_t              skipped_frames = 0; // face_render_stats().skipped during the run
+    uint32_t              mouth_cache_hits = 0;
+    uint32_t              mouth_cache_misses = 0;
+    uint32_t              mouth_cache_bytes = 0;
+};
+
+uint8_t s_face_flags = DEFAULT_FACE_FLAGS;
+
+pixel_t s_canvas[SCREEN_W * SCREEN_H];
+pixel_t s_afterglow[AFTERGLOW_W * AFTERGLOW_H];
+
+// Nearest-rank percentile, same as supervisor/api/mcu_benchmark.py.
+uint32_t percentile(std::vector<uint32_t> values, int p)
+{
+    if (values.empty()) return 0;
+    std::sort(values.begin(), values.end());
+    const std::size_t n = values.size();
+    std::size_t       rank = static_cast<std::size_t>(std::ceil(static_cast<double>(n) * p / 100.0));
+    if (rank < 1) rank = 1;
+    if (rank > n) rank = n;
+    return values[rank - 1];
+}
+
+uint32_t mean(const std::vector<uint32_t>& values)
+{
+    if (values.empty()) return 0;
+    uint64_t sum = 0;
+    for (uint32_t v : values) sum += v;
+    return static_cast<uint32_t>((sum + values.size() / 2) / values.size());
+}
+
+uint32_t max_of(const std::vector<uint32_t>& values)
+{
+    return values.empty() ? 0 : *std::max_element(values.begin(), values.end());
+}
+
+void setup_face(FaceState& fs, const Scenario& sc)
+{
+    // Same as apply_face_flags() with the firmware default flag set
+    // (plus afterglow with --afterglow).
+    const uint8_t flags = s_face_flags;
+    fs.anim.idle = (flags & FACE_FLAG_IDLE_WANDER) != 0;
+    fs.anim.autoblink = (flags & FACE_FLAG_AUTOBLINK) != 0;
+    fs.solid_eye = (flags & FACE_FLAG_SOLID_EYE) != 0;
+    fs.show_mouth = (flags & FACE_FLAG_SHOW_MOUTH) != 0;
+    fs.fx.edge_glow = (flags & FACE_FLAG_EDGE_GLOW) != 0;
+    fs.fx.sparkle = (flags & FACE_FLAG_SPARKLE) != 0;
+    fs.fx.afterglow = (flags & FACE_FLAG_AFTERGLOW) != 0;
+
+    // Skip the boot sequence; the device scenarios start long after boot.
+    fs.fx.boot_active = false;
+    fs.eye_l.openness = 1.0f;
+    fs.eye_r.openness = 1.0f;
+
+    face_set_mood(fs, sc.mood);
+    face_set_expression_intensity(fs, 1.0f);
+    fs.talking = sc.talking;
+    fs.talking_energy = sc.talking ? static_cast<float>(sc.energy) / 255.0f : 0.0f;
+    conv_border_set_state(static_cast<uint8_t>(sc.conv_state));
+    if (sc.system != SystemMode::NONE) {
+        face_set_system_mode(fs, sc.system, sc.system_param);
+    }
+}
+
+// One face_ui_task iteration. Returns frame time (update + render) in us.
+uint32_t step_frame(FaceState& fs, const Scenario& sc, RenderPerfSnapshot& perf)
+{
+    const int64_t frame_start_us = esp_timer_get_time();
+
+    if (sc.rage && !fs.anim.rage) {
+        face_trigger_gesture(fs, GestureId::RAGE);
+    }
+    conv_border_set_energy(fs.talking_energy);
+    conv_border_update(1.0f / ANIM_FPS);
+    face_state_update(fs, 1.0f / ANIM_FPS);
+    if (fs.system.mode != SystemMode::NONE) {
+        system_face_apply(fs, static_cast<float>(esp_timer_get_time()) / 1'000'000.0f);
+    }
+
+    perf = {};
+    const int64_t     render_start_us = esp_timer_get_time();
+    const DirtyRegion dirty = face_render_frame(s_canvas, fs, &perf);
+    perf.render_us = static_cast<uint32_t>(esp_timer_get_time() - render_start_us);
+    perf.dirty_px = dirty_region_area(dirty);
+
+    const uint32_t frame_us = static_cast<uint32_t>(esp_timer_get_time() - frame_start_us);
+
+    // Emulate vTaskDelay(1000 / ANIM_FPS) so animation time advances at the
+    // device rate regardless of how fast the host renders.
+    host_timer_advance_us(FRAME_PERIOD_US);
+    return frame_us;
+}
+
+Samples run_scenario(const Scenario& sc, int frames, uint32_t seed)
+{
+    srand(seed);
+    std::memset(s_canvas, 0, sizeof(s_canvas));
+    std::memset(s_afterglow, 0, sizeof(s_afterglow));
+    face_render_init(s_afterglow);
+
+    FaceState fs;
+    setup_face(fs, sc);
+
+    RenderPerfSnapshot perf = {};
+    for (int i = 0; i < WARMUP_FRAMES; i++) {
+        step_frame(fs, sc, perf);
+    }
+
+    Samples               s;
+    const MouthCacheStats mc0 = mouth_cache_stats();
+    const FaceRenderStats rs0 = face_render_stats();
+    for (int i = 0; i < frames; i++) {
+        const uint32_t frame_us = step_frame(fs, sc, perf);
+        s.frame_us.push_back(frame_us);
+        s.render_us.push_back(perf.render_us);
+        s.clear_us.push_back(perf.clear_us);
+        s.eyes_us.push_back(perf.eyes_us);
+        s.mouth_us.push_back(perf.mouth_us);
+        s.border_us.push_back(perf.border_us);
+        s.effects_us.push_back(perf.effects_us);
+        s.overlay_us.push_back(perf.overlay_us);
+        s.dirty_px.push_back(perf.dirty_px);
+        s.clear_px.push_back(perf.clear_px);
+        s.band_wait_us.push_back(perf.band_wait_us);
+        if (perf.bands > 1) s.split_frames++;
+    }
+    s.skipped_frames = face_render_stats().skipped - rs0.skipped;
+    const MouthCacheStats mc1 = mouth_cache_stats();
+    s.mouth_cache_hits = mc1.hits - mc0.hits;
+    s.mouth_cache_misses = mc1.misses - mc0.misses;
+    s.mouth_cache_bytes = mc1.bytes_used;
+
+    conv_border_set_state(static_cast<uint8_t>(FaceConvState::IDLE));
+    return s;
+}
+
+std::string iso8601_now()
+{
+    char        buf[40];
+    std::time_t t = std::time(nullptr);
+    std::tm     tm_utc = {};
+    gmtime_r(&t, &tm_utc);
+    std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S+00:00", &tm_utc);
+    return buf;
+}
+
+uint32_t split_pct(const Samples& s)
+{
+    const uint32_t n = static_cast<uint32_t>(s.frame_us.size());
+    return n > 0 ? (s.split_frames * 100U + n / 2) / n : 0;
+}
+
+uint32_t idle_skip_pct(const Samples& s)
+{
+    const uint32_t n = static_cast<uint32_t>(s.frame_us.size());
+    return n > 0 ? (s.skipped_frames * 100U + n / 2) / n : 0;
+}
+
+uint32_t mouth_cache_hit_pct(const Samples& s)
+{
+    const uint32_t lookups = s.mouth_cache_hits + s.mouth_cache_misses;
+    return lookups > 0 ? (s.mouth_cache_hits * 100U + lookups / 2) / lookups : 0;
+}
+
+// Render p95 budget of sc under the selected system renderer, 0 = none.
+uint32_t render_budget_us(const Scenario& sc)
+{
+    return face_render_system_renderer() == SystemRenderer::OVERLAY_V2 ? sc.v2_p95_budget_us : sc.face_p95_budget_us;
+}
+
+bool over_budget(const Scenario& sc, const Samples& s)
+{
+    const uint32_t budget = render_budget_us(sc);
+    return budget > 0 && percentile(s.render_us, 95) > budget;
+}
+
+void write_scenario_json(std::FILE* f, const Scenario& sc, const Samples& s, double elapsed_s, bool last)
+{
+    const uint32_t frame_avg = mean(s.frame_us);
+    const uint32_t dirty_avg = mean(s.dirty_px);
+    const double   fps_est = frame_avg > 0 ? std::round(1'000'000.0 / frame_avg * 100.0) / 100.0 : 0.0;
+
+    std::fprintf(f, "    \"%s\": {\n", sc.name);
+    std::fprintf(f, "      \"frames\": %zu,\n", s.frame_us.size());
+    std::fprintf(f, "      \"frame_us_avg\": %u,\n", frame_avg);
+    std::fprintf(f, "      \"frame_us_max\": %u,\n", max_of(s.frame_us));
+    std::fprintf(f, "      \"fps_est\": %.2f,\n", fps_est);
+    std::fprintf(f, "      \"render_us_avg\": %u,\n", mean(s.render_us));
+    std::fprintf(f, "      \"render_us_max\": %u,\n", max_of(s.render_us));
+    std::fprintf(f, "      \"clear_us_avg\": %u,\n", mean(s.clear_us));
+    std::fprintf(f, "      \"eyes_us_avg\": %u,\n", mean(s.eyes_us));
+    std::fprintf(f, "      \"mouth_us_avg\": %u,\n", mean(s.mouth_us));
+    std::fprintf(f, "      \"border_us_avg\": %u,\n", mean(s.border_us));
+    std::fprintf(f, "      \"effects_us_avg\": %u,\n", mean(s.effects_us));
+    std::fprintf(f, "      \"overlay_us_avg\": %u,\n", mean(s.overlay_us));
+    std::fprintf(f, "      \"dirty_px_avg\": %u,\n", dirty_avg);
+    std::fprintf(f, "      \"clear_px_avg\": %u,\n", mean(s.clear_px));
+    std::fprintf(f, "      \"spi_bytes_per_s\": %u,\n", dirty_avg * 2U * static_cast<uint32_t>(ANIM_FPS));
+    std::fprintf(f, "      \"cmd_rx_to_apply_us_avg\": 0,\n");
+    std::fprintf(f, "      \"mouth_cache_hits\": %u,\n", s.mouth_cache_hits);
+    std::fprintf(f, "      \"mouth_cache_misses\": %u,\n", s.mouth_cache_misses);
+    std::fprintf(f, "      \"mouth_cache_bytes\": %u,\n", s.mouth_cache_bytes);
+    std::fprintf(f, "      \"band_split_frames\": %u,\n", s.split_frames);
+    std::fprintf(f, "      \"band_wait_us_avg\": %u,\n", mean(s.band_wait_us));
+    std::fprintf(f, "      \"idle_skip_frames\": %u,\n", s.skipped_frames);
+    std::fprintf(f, "      \"idle_skip_pct\": %u,\n", idle_skip_pct(s));
+
+    const struct {
+        const char*                  key;
+        const std::vector<uint32_t>& v;
+    } stages[] = {
+        {"frame_us", s.frame_us},     {"render_us", s.render_us},   {"clear_us", s.clear_us},
+        {"eyes_us", s.eyes_us},
+        {"mouth_us", s.mouth_us},     {"border_us", s.border_us},   {"effects_us", s.effects_us},
+        {"overlay_us", s.overlay_us},
+    };
+    for (const auto& st : stages) {
+        std::fprintf(f, "      \"%s_p50\": %u,\n", st.key, percentile(st.v, 50));
+        std::fprintf(f, "      \"%s_p95\": %u,\n", st.key, percentile(st.v, 95));
+    }
+
+    if (render_budget_us(sc) > 0) {
+        std::fprintf(f, "      \"render_us_p95_budget\": %u,\n", render_budget_us(sc));
+        std::fprintf(f, "      \"over_budget\": %s,\n", over_budget(sc, s) ? "true" : "false");
+    }
+    std::fprintf(f, "      \"elapsed_s\": %.1f\n", elapsed_s);
+    std::fprintf(f, "    }%s\n", last ? "" : ",");
+}
+
+void usage(const char* argv0)
+{
+    std::fprintf(stderr,
+                 "usage: %s [--frames N] [--scenario NAME] [--seed S] [--threads 1|2] [--afterglow]\n"
+                 "       [--system face|v2] [--out PATH]\n",
+                 argv0);
+    std::fprintf(stderr, "scenarios:");
+    for (const Scenario& sc : SCENARIOS) std::fprintf(stderr, " %s", sc.name);
+    std::fprintf(stderr, "\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int         frames = 1000;
+    uint32_t    seed = DEFAULT_SEED;
+    const char* only = nullptr;
+    const char* out_path = nullptr;
+    int         threads = 1;
+    auto        system_renderer = FACE_SYSTEM_OVERLAY_V2 ? SystemRenderer::OVERLAY_V2 : SystemRenderer::FACE;
+
+    for (int i = 1; i < argc; i++) {
+        const bool has_val = i + 1 < argc;
+        if (std::strcmp(argv[i], "--frames") == 0 && has_val) {
+            frames = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--scenario") == 0 && has_val) {
+            only = argv[++i];
+        } else if (std::strcmp(argv[i], "--seed") == 0 && has_val) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && has_val) {
+            threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--afterglow") == 0) {
+            s_face_flags |= FACE_FLAG_AFTERGLOW;
+        } else if (std::strcmp(argv[i], "--system") == 0 && has_val) {
+            const char* r = argv[++i];
+            if (std::strcmp(r, "v2") == 0) {
+                system_renderer = SystemRenderer::OVERLAY_V2;
+            } else if (std::strcmp(r, "face") != 0) {
+                usage(argv[0]);
+                return 2;
+            }
+        } else if (std::strcmp(argv[i], "--out") == 0 && has_val) {
+            out_path = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (frames <= 0 || threads < 1 || threads > 2) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // --threads 2: top band on a second thread, as face_render_worker_task.
+    std::unique_ptr<HostRenderWorker> worker;
+    if (threads == 2) {
+        worker = std::make_unique<HostRenderWorker>();
+        const FaceRenderWorker w = worker->handle();
+        face_render_set_worker(&w);
+    }
+
+    face_render_set_system_renderer(system_renderer);
+
+    std::vector<const Scenario*> selected;
+    for (const Scenario& sc : SCENARIOS) {
+        if (!only || std::strcmp(only, sc.name) == 0) selected.push_back(&sc);
+    }
+    if (selected.empty()) {
+        std::fprintf(stderr, "unknown scenario: %s\n", only);
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::FILE* f = out_path ? std::fopen(out_path, "w") : stdout;
+    if (!f) {
+        std::perror(out_path);
+        return 1;
+    }
+
+    std::fprintf(f, "{\n");
+    std::fprintf(f, "  \"version\": 1,\n");
+    std::fprintf(f, "  \"captured_at\": \"%s\",\n", iso8601_now().c_str());
+    std::fprintf(f, "  \"target_frames\": %d,\n", frames);
+    std::fprintf(f, "  \"endpoint\": \"host\",\n");
+    std::fprintf(f, "  \"render_threads\": %d,\n", threads);
+    std::fprintf(f, "  \"face_flags\": %u,\n", s_face_flags);
+    std::fprintf(f, "  \"system_renderer\": \"%s\",\n",
+                 system_renderer == SystemRenderer::OVERLAY_V2 ? "v2" : "face");
+    std::fprintf(f, "  \"notes\": [\n");
+    std::fprintf(f, "    \"host build (esp32-face/host): CPU time only, no LVGL flush, SPI or vTaskDelay; compare "
+                    "runs on the same machine.\",\n");
+    std::fprintf(f, "    \"every frame is sampled (device samples stages every FACE_PERF_SAMPLE_DIV frames); "
+                    "cmd_rx_to_apply_us_avg is not measured.\",\n");
+    std::fprintf(f, "    \"rage_effects re-triggers GestureId::RAGE so fire particles stay active.\",\n");
+    std::fprintf(f, "    \"sys_* scenarios fail the run when render_us_p95 exceeds render_us_p95_budget.\"\n");
+    std::fprintf(f, "  ],\n");
+    std::fprintf(f, "  \"scenarios\": {\n");
+
+    std::fprintf(stderr, "%-16s %8s %8s %8s %8s %8s %8s %8s %8s %9s %9s %7s %7s %7s\n", "scenario", "frame50",
+                 "frame95", "render50", "clear50", "eyes50", "mouth50", "border50", "fx50", "clear_px", "dirty_px",
+                 "mouth%", "split%", "skip%");
+    int budget_failures = 0;
+    for (std::size_t i = 0; i < selected.size(); i++) {
+        const Scenario&  sc = *selected[i];
+        const auto       t0 = std::clock();
+        const Samples    s = run_scenario(sc, frames, seed);
+        const double     elapsed_s = static_cast<double>(std::clock() - t0) / CLOCKS_PER_SEC;
+        write_scenario_json(f, sc, s, elapsed_s, i + 1 == selected.size());
+        std::fprintf(stderr, "%-16s %8u %8u %8u %8u %8u %8u %8u %8u %9u %9u %7u %7u %7u\n", sc.name,
+                     percentile(s.frame_us, 50), percentile(s.frame_us, 95), percentile(s.render_us, 50),
+                     percentile(s.clear_us, 50), percentile(s.eyes_us, 50), percentile(s.mouth_us, 50),
+                     percentile(s.border_us, 50), percentile(s.effects_us, 50), mean(s.clear_px),
+                     mean(s.dirty_px), mouth_cache_hit_pct(s), split_pct(s), idle_skip_pct(s));
+        if (over_budget(sc, s)) {
+            std::fprintf(stderr, "%s: render p95 %u us over budget %u us\n", sc.name, percentile(s.render_us, 95),
+                         render_budget_us(sc));
+            budget_failures++;
+        }
+    }
+
+    std::fprintf(f, "  },\n");
+    std::fprintf(f, "  \"completed_at\": \"%s\"\n", iso8601_now().c_str());
+    std::fprintf(f, "}\n");
+
+    if (f != stdout) std::fclose(f);
+    return budget_failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,60 @@
+#pragma once
+// Reference heart rasterizer — the per-pixel SDF draw_heart_shape() from
+// face_render.cpp before the sprite cache. Host-only: the analytic source for
+// test_heart_sprite.
+
+#include "config.h"
+#include "pixel.h"
+
+#include <cmath>
+
+inline float heart_ref_sd(float px, float py, float cx, float cy, float size)
+{
+    const float x = fabsf(px - cx) / size;
+    const float y = (cy - py) / size + 0.5f;
+
+    float d = 0.0f;
+    if (y + x > 1.0f) {
+        const float dx = x - 0.25f;
+        const float dy = y - 0.75f;
+        d = sqrtf(dx * dx + dy * dy) - 0.35355339f;
+    } else {
+        const float dy1 = y - 1.0f;
+        const float d1 = x * x + dy1 * dy1;
+        const float t = fmaxf(x + y, 0.0f) * 0.5f;
+        const float dx2 = x - t;
+        const float dy2 = y - t;
+        const float d2 = dx2 * dx2 + dy2 * dy2;
+        d = sqrtf(fminf(d1, d2));
+        if (x < y) {
+            d = -d;
+        }
+    }
+
+    return d * size;
+}
+
+inline void heart_ref_draw(pixel_t* buf, float cx, float cy, float size, uint8_t r, uint8_t g, uint8_t b)
+{
+    if (size < 1.0f) {
+        return;
+    }
+    const int x0 = static_cast<int>(fmaxf(0.0f, cx - size - 2.0f));
+    const int x1 = static_cast<int>(fminf(static_cast<float>(SCREEN_W), cx + size + 2.0f));
+    const int y0 = static_cast<int>(fmaxf(0.0f, cy - size - 2.0f));
+    const int y1 = static_cast<int>(fminf(static_cast<float>(SCREEN_H), cy + size + 2.0f));
+
+    for (int y = y0; y < y1; y++) {
+        const int row = y * SCREEN_W;
+        for (int x = x0; x < x1; x++) {
+            const float d = heart_ref_sd(static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f, cx, cy, size);
+            float       t = (d + 0.5f);
+            if (t < 0.0f) t = 0.0f;
+            if (t > 1.0f) t = 1.0f;
+            const float a = 1.0f - t * t * (3.0f - 2.0f * t);
+            if (a > 0.01f) {
+                buf[row + x] = px_blend_u8(buf[row + x], r, g, b, px_alpha_u8(a));
+            }
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+// Host stand-in for panel_present.cpp: present() copies the pushed rects into
+// a panel-sized mirror and counts rects and SPI bytes, synchronously. Host-only
+// (test_present).
+
+#include "face_present.h"
+
+#include <cstdint>
+#include <cstring>
+
+class HostPresenter
+{
+  public:
+    struct FrameStats {
+        uint32_t rects = 0;
+        uint32_t bytes = 0; // RGB565 payload, what draw_bitmap() would send
+    };
+
+    HostPresenter()
+    {
+        std::memset(panel_, 0, sizeof(panel_));
+    }
+
+    FacePresenter handle()
+    {
+        FacePresenter p;
+        p.ctx = this;
+        p.present = [](void* ctx, const pixel_t* canvas, const DirtyRegion& dirty) {
+            static_cast<HostPresenter*>(ctx)->present(canvas, dirty);
+        };
+        p.wait = [](void* ctx) { static_cast<HostPresenter*>(ctx)->waits_++; };
+        return p;
+    }
+
+    // What the panel shows after the presents so far.
+    const pixel_t* panel() const
+    {
+        return panel_;
+    }
+    const FrameStats& last() const
+    {
+        return last_;
+    }
+    uint64_t total_bytes() const
+    {
+        return total_bytes_;
+    }
+    uint32_t frames() const
+    {
+        return frames_;
+    }
+    uint32_t waits() const
+    {
+        return waits_;
+    }
+
+  private:
+    void present(const pixel_t* canvas, const DirtyRegion& dirty)
+    {
+        last_ = {};
+        face_present_for_each_rect(dirty, [&](const RectI& r) {
+            const int w = r.x1 - r.x0 + 1;
+            for (int y = r.y0; y <= r.y1; y++) {
+                std::memcpy(panel_ + y * SCREEN_W + r.x0, canvas + y * SCREEN_W + r.x0, w * sizeof(pixel_t));
+            }
+            last_.rects++;
+            last_.bytes += static_cast<uint32_t>(w * (r.y1 - r.y0 + 1)) * sizeof(pixel_t);
+        });
+        total_bytes_ += last_.bytes;
+        frames_++;
+    }
+
+    pixel_t    panel_[SCREEN_W * SCREEN_H];
+    FrameStats last_;
+    uint64_t   total_bytes_ = 0;
+    uint32_t   frames_ = 0;
+    uint32_t   waits_ = 0;
+};
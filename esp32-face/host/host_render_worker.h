@@ -0,0 +1,83 @@
+#pragma once
+// std::thread stand-in for face_render_worker_task: one persistent thread that
+// runs the top-band job face_render_frame hands it, with a mutex / condition
+// variable pair as the barrier. Host-only (face_bench, test_render_pipeline).
+
+#include "face_render.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+class HostRenderWorker
+{
+  public:
+    HostRenderWorker()
+        : thread_([this] { run(); })
+    {
+    }
+
+    ~HostRenderWorker()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            quit_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    HostRenderWorker(const HostRenderWorker&) = delete;
+    HostRenderWorker& operator=(const HostRenderWorker&) = delete;
+
+    FaceRenderWorker handle()
+    {
+        FaceRenderWorker w;
+        w.ctx = this;
+        w.start = [](void* ctx, void (*job)(void*), void* arg) {
+            static_cast<HostRenderWorker*>(ctx)->start(job, arg);
+        };
+        w.wait = [](void* ctx) { static_cast<HostRenderWorker*>(ctx)->wait(); };
+        return w;
+    }
+
+  private:
+    void start(void (*job)(void*), void* arg)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = job;
+            arg_ = arg;
+        }
+        cv_.notify_all();
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return job_ == nullptr; });
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            cv_.wait(lock, [this] { return quit_ || job_ != nullptr; });
+            if (quit_) return;
+            void (*job)(void*) = job_;
+            void* arg = arg_;
+            lock.unlock();
+            job(arg);
+            lock.lock();
+            job_ = nullptr;
+            cv_.notify_all();
+        }
+    }
+
+    std::mutex              mutex_;
+    std::condition_variable cv_;
+    void (*job_)(void*) = nullptr;
+    void*       arg_ = nullptr;
+    bool        quit_ = false;
+    std::thread thread_; // last: starts after the members above exist
+};
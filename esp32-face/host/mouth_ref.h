@@ -0,0 +1,57 @@
+#pragma once
+// Reference mouth rasterizer — the per-pixel SDF render_mouth() evaluated over
+// the whole bounding box before the column-analytic path. Host-only: the
+// golden source for test_mouth_raster.
+
+#include "config.h"
+#include "pixel.h"
+
+#include <cmath>
+
+inline float mouth_ref_smoothstep(float edge0, float edge1, float x)
+{
+    if (fabsf(edge1 - edge0) < 1e-6f) {
+        return x < edge0 ? 0.0f : 1.0f;
+    }
+    float t = (x - edge0) / (edge1 - edge0);
+    if (t < 0.0f) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+    return t * t * (3.0f - 2.0f * t);
+}
+
+// Draws a mouth whose center (ox + cx, oy + cy) is split into an integer
+// origin and a local offset, the way mouth_cache evaluates it.
+inline void mouth_ref_draw(pixel_t* buf, int ox, int oy, float cx, float cy, float w, float thick, float curve,
+                           float openness, uint8_t r, uint8_t g, uint8_t b)
+{
+    const float half_thick = thick * 0.5f;
+    const int   x0 = ox + static_cast<int>(floorf(cx - w - thick));
+    const int   x1 = ox + static_cast<int>(ceilf(cx + w + thick));
+    const int   y0 = oy + static_cast<int>(floorf(cy - fabsf(curve) - openness - thick));
+    const int   y1 = oy + static_cast<int>(ceilf(cy + fabsf(curve) + openness + thick));
+    for (int y = (y0 < 0 ? 0 : y0); y < (y1 > SCREEN_H ? SCREEN_H : y1); y++) {
+        for (int x = (x0 < 0 ? 0 : x0); x < (x1 > SCREEN_W ? SCREEN_W : x1); x++) {
+            const float px = static_cast<float>(x - ox) + 0.5f;
+            const float py = static_cast<float>(y - oy) + 0.5f;
+            const float nx = (px - cx) / w;
+            if (fabsf(nx) > 1.0f) continue;
+
+            const float shape = 1.0f - nx * nx;
+            const float curve_y = curve * shape;
+            const float upper_y = cy + curve_y - openness * shape;
+            const float lower_y = cy + curve_y + openness * shape;
+
+            float dist = 0.0f;
+            if (openness > 1.0f && upper_y < py && py < lower_y) {
+                dist = 0.0f;
+            } else {
+                dist = fminf(fabsf(py - upper_y), fabsf(py - lower_y));
+            }
+
+            const float alpha = 1.0f - mouth_ref_smoothstep(half_thick - 1.0f, half_thick + 1.0f, dist);
+            if (alpha > 0.01f) {
+                buf[y * SCREEN_W + x] = px_blend_u8(buf[y * SCREEN_W + x], r, g, b, px_alpha_u8(alpha));
+            }
+        }
+    }
+}
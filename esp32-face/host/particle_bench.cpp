@@ -0,0 +1,92 @@
+// Cost of the sparkle and fire particle pools (particles.h, particle_draw.h)
+// as they grow: the firmware caps with the firmware spawn rate, then pools
+// 4x and 16x larger spawning 4x and 16x as often. Each case runs the fixed
+// step and the draw over a full canvas every frame and reports us per frame
+// and ns per live particle, so the per-particle cost can be checked to stay
+// flat as the pools grow.
+//
+// Usage: particle_bench [--frames N]
+
+#include "config.h"
+#include "face_state.h"
+#include "particle_draw.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+
+constexpr float SPARKLE_CHANCE = 0.05f; // EffectsState::sparkle_chance default
+constexpr int   WARMUP_FRAMES = ANIM_FPS;
+
+struct Result {
+    double step_us;
+    double draw_us;
+    double live; // sparkles + embers, mean per frame
+};
+
+template <int NS, int NF> Result run(int burst, int frames)
+{
+    SparklePool<NS>      sparkles;
+    FirePool<NF>         fire;
+    std::vector<pixel_t> canvas(SCREEN_W * SCREEN_H, 0);
+    srand(1);
+
+    for (int i = 0; i < WARMUP_FRAMES; i++) {
+        sparkle_step(sparkles, SPARKLE_CHANCE, burst);
+        fire_step(fire, burst);
+    }
+
+    double   step_ns = 0.0;
+    double   draw_ns = 0.0;
+    uint64_t live = 0;
+    for (int i = 0; i < frames; i++) {
+        const auto t0 = std::chrono::steady_clock::now();
+        sparkle_step(sparkles, SPARKLE_CHANCE, burst);
+        fire_step(fire, burst);
+        const auto t1 = std::chrono::steady_clock::now();
+        sparkle_draw(canvas.data(), sparkles);
+        fire_draw(canvas.data(), fire);
+        const auto t2 = std::chrono::steady_clock::now();
+        step_ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+        draw_ns += std::chrono::duration<double, std::nano>(t2 - t1).count();
+        live += static_cast<uint64_t>(sparkles.count + fire.count);
+    }
+    return {step_ns / frames / 1000.0, draw_ns / frames / 1000.0, static_cast<double>(live) / frames};
+}
+
+void print(const char* name, int sparkle_cap, int fire_cap, const Result& r)
+{
+    const double per_ns = r.live > 0.0 ? (r.step_us + r.draw_us) * 1000.0 / r.live : 0.0;
+    std::printf("%-10s %5d %5d %8.1f %8.2f %8.2f %10.1f\n", name, sparkle_cap, fire_cap, r.live, r.step_us,
+                r.draw_us, per_ns);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int frames = 20000;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: %s [--frames N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (frames <= 0) frames = 1;
+
+    constexpr int S = MAX_SPARKLE_PIXELS;
+    constexpr int F = MAX_FIRE_PIXELS;
+    std::printf("%-10s %5s %5s %8s %8s %8s %10s\n", "case", "spark", "fire", "live", "step_us", "draw_us",
+                "ns/live");
+    print("firmware", S, F, run<S, F>(1, frames));
+    print("4x", S * 4, F * 4, run<S * 4, F * 4>(4, frames));
+    print("16x", S * 16, F * 16, run<S * 16, F * 16>(16, frames));
+    return 0;
+}
@@ -0,0 +1,125 @@
+// Per-pixel cost of the RGB565 blend paths and the span kernels
+// (pixel_span.h) on a full 320x240 canvas.
+//
+// Usage: pixel_bench [--passes N]
+
+#include "config.h"
+#include "pixel.h"
+#include "pixel_span.h"
+#include "pixel_ref.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+
+constexpr int CANVAS_PX = SCREEN_W * SCREEN_H;
+
+template <typename Fn> double ns_per_px(std::vector<pixel_t>& buf, int passes, Fn fn)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int p = 0; p < passes; p++) {
+        fn(buf.data(), p);
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    return ns / (static_cast<double>(passes) * CANVAS_PX);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int passes = 200;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--passes") == 0 && i + 1 < argc) {
+            passes = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: %s [--passes N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // Per-pixel alpha ramp, like the AA fringe of the mouth / border glow.
+    std::vector<float>   alpha_f(CANVAS_PX);
+    std::vector<uint8_t> alpha_u8(CANVAS_PX);
+    srand(1);
+    for (int i = 0; i < CANVAS_PX; i++) {
+        alpha_f[i] = static_cast<float>(rand() % 1000) / 999.0f;
+        alpha_u8[i] = px_alpha_u8(alpha_f[i]);
+    }
+
+    std::vector<pixel_t> buf(CANVAS_PX);
+    for (auto& p : buf) p = static_cast<pixel_t>(rand());
+
+    volatile pixel_t sink = 0;
+
+    const double t_float = ns_per_px(buf, passes, [&](pixel_t* b, int p) {
+        const uint8_t r = static_cast<uint8_t>(p * 7);
+        for (int i = 0; i < CANVAS_PX; i++) b[i] = px_blend_float(b[i], r, 180, 50, alpha_f[i]);
+    });
+    sink = buf[0];
+
+    const double t_u8 = ns_per_px(buf, passes, [&](pixel_t* b, int p) {
+        const uint8_t r = static_cast<uint8_t>(p * 7);
+        for (int i = 0; i < CANVAS_PX; i++) b[i] = px_blend_u8(b[i], r, 180, 50, alpha_u8[i]);
+    });
+    sink = buf[0];
+
+    const double t_u8_conv = ns_per_px(buf, passes, [&](pixel_t* b, int p) {
+        const uint8_t r = static_cast<uint8_t>(p * 7);
+        for (int i = 0; i < CANVAS_PX; i++) b[i] = px_blend_u8(b[i], r, 180, 50, px_alpha_u8(alpha_f[i]));
+    });
+    sink = buf[0];
+
+    // Full-screen passes: scalar loop vs the word kernel.
+    const double t_scale_scalar = ns_per_px(buf, passes, [&](pixel_t* b, int) {
+        for (int i = 0; i < CANVAS_PX; i++) b[i] = px_scale_q8(b[i], 205);
+    });
+    sink = buf[0];
+    const double t_scale_span = ns_per_px(buf, passes, [&](pixel_t* b, int) {
+        for (int y = 0; y < SCREEN_H; y++) px_span_scale(b + y * SCREEN_W, SCREEN_W, 205);
+    });
+    sink = buf[0];
+
+    const double t_const_scalar = ns_per_px(buf, passes, [&](pixel_t* b, int p) {
+        const uint8_t a = static_cast<uint8_t>(p | 1);
+        for (int i = 0; i < CANVAS_PX; i++) b[i] = px_blend_u8(b[i], 80, 135, 220, a);
+    });
+    sink = buf[0];
+    const double t_const_span = ns_per_px(buf, passes, [&](pixel_t* b, int p) {
+        const uint8_t a = static_cast<uint8_t>(p | 1);
+        for (int y = 0; y < SCREEN_H; y++) px_span_blend(b + y * SCREEN_W, SCREEN_W, 80, 135, 220, a);
+    });
+    sink = buf[0];
+
+    const double t_mask_span = ns_per_px(buf, passes, [&](pixel_t* b, int p) {
+        const uint8_t r = static_cast<uint8_t>(p * 7);
+        for (int y = 0; y < SCREEN_H; y++) {
+            px_span_blend_mask(b + y * SCREEN_W, alpha_u8.data() + y * SCREEN_W, SCREEN_W, r, 180, 50);
+        }
+    });
+    sink = buf[0];
+
+    const double t_fill_span = ns_per_px(buf, passes, [&](pixel_t* b, int p) {
+        px_span_fill(b, CANVAS_PX, static_cast<pixel_t>(p * 0x0841));
+    });
+    sink = buf[0];
+    (void)sink;
+
+    std::printf("%-34s %8s\n", "kernel", "ns/px");
+    std::printf("%-34s %8.3f\n", "px_blend_float (reference)", t_float);
+    std::printf("%-34s %8.3f\n", "px_blend_u8", t_u8);
+    std::printf("%-34s %8.3f\n", "px_blend_u8 + px_alpha_u8(float)", t_u8_conv);
+    std::printf("%-34s %8.3f\n", "px_blend_mask span (random alpha)", t_mask_span);
+    std::printf("%-34s %8.3f\n", "scale scalar", t_scale_scalar);
+    std::printf("%-34s %8.3f\n", "px_span_scale", t_scale_span);
+    std::printf("%-34s %8.3f\n", "const blend scalar", t_const_scalar);
+    std::printf("%-34s %8.3f\n", "px_span_blend", t_const_span);
+    std::printf("%-34s %8.3f\n", "px_span_fill", t_fill_span);
+    return 0;
+}
@@ -0,0 +1,18 @@
+#pragma once
+// Reference float blend — the px_blend() the firmware used before the
+// fixed-point path. Host-only: kept for equivalence tests and benches.
+
+#include "pixel.h"
+
+template <PxOrder O = PX_ORDER>
+inline pixel_t px_blend_float(pixel_t bg, uint8_t r, uint8_t g, uint8_t b, float alpha)
+{
+    if (alpha >= 0.999f) return px_rgb<O>(r, g, b);
+    if (alpha <= 0.001f) return bg;
+    const uint8_t bg_r = px_r<O>(bg);
+    const uint8_t bg_g = px_g<O>(bg);
+    const uint8_t bg_b = px_b<O>(bg);
+    return px_rgb<O>(static_cast<uint8_t>(bg_r + static_cast<int>((r - bg_r) * alpha)),
+                     static_cast<uint8_t>(bg_g + static_cast<int>((g - bg_g) * alpha)),
+                     static_cast<uint8_t>(bg_b + static_cast<int>((b - bg_b) * alpha)));
+}
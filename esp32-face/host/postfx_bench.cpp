@@ -0,0 +1,135 @@
+// System overlay post-FX (scanlines, vignette) in us per 320x240 frame: the
+// multiplier-map pass of system_overlay_post_fx() against the per-pixel code
+// it replaced (sqrtf + smoothstep + float channel scale per pixel, scanlines
+// scaled first). Also prints the largest per-channel difference, in 5/6-bit
+// steps, between the two on the same frame.
+//
+// Usage: postfx_bench [--passes N]
+
+#include "config.h"
+#include "pixel.h"
+#include "pixel_span.h"
+#include "system_overlay_v2.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+
+// ---- Reference: system_overlay_v2.cpp before the multiplier map ----
+
+float ref_smoothstep(float edge0, float edge1, float x)
+{
+    float t = (x - edge0) / (edge1 - edge0);
+    t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+void ref_scanlines(pixel_t* buf)
+{
+    for (int y = 0; y < SCREEN_H; y += 2) {
+        px_span_scale(buf + y * SCREEN_W, SCREEN_W, px_q8_ratio(4, 5));
+    }
+}
+
+void ref_vignette(pixel_t* buf)
+{
+    const float cx = static_cast<float>(SCREEN_W) * 0.5f;
+    const float cy = static_cast<float>(SCREEN_H) * 0.5f;
+    const float max_dist = sqrtf(cx * cx + cy * cy);
+    for (int y = 0; y < SCREEN_H; y++) {
+        for (int x = 0; x < SCREEN_W; x++) {
+            const float   dx = static_cast<float>(x) - cx;
+            const float   dy = static_cast<float>(y) - cy;
+            const float   v = 1.0f - ref_smoothstep(max_dist * 0.5f, max_dist, sqrtf(dx * dx + dy * dy));
+            const pixel_t p = buf[y * SCREEN_W + x];
+            buf[y * SCREEN_W + x] = px_rgb(static_cast<uint8_t>(px_r(p) * v), static_cast<uint8_t>(px_g(p) * v),
+                                           static_cast<uint8_t>(px_b(p) * v));
+        }
+    }
+}
+
+void ref_post_fx(pixel_t* buf, bool scanlines, bool vignette)
+{
+    if (scanlines) ref_scanlines(buf);
+    if (vignette) ref_vignette(buf);
+}
+
+// ---- Bench ----
+
+template <typename Fn> double us_per_frame(const std::vector<pixel_t>& src, int passes, Fn fn)
+{
+    std::vector<pixel_t> buf(src.size());
+    double               ns = 0.0;
+    for (int p = 0; p < passes; p++) {
+        buf = src;
+        const auto t0 = std::chrono::steady_clock::now();
+        fn(buf.data());
+        const auto t1 = std::chrono::steady_clock::now();
+        ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+    }
+    return ns / passes / 1000.0;
+}
+
+int max_channel_diff(const std::vector<pixel_t>& a, const std::vector<pixel_t>& b)
+{
+    int worst = 0;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        const pixel_t p = px_order(a[i]);
+        const pixel_t q = px_order(b[i]);
+        const int     dr = std::abs((p >> 11) - (q >> 11));
+        const int     dg = std::abs(((p >> 5) & 0x3F) - ((q >> 5) & 0x3F));
+        const int     db = std::abs((p & 0x1F) - (q & 0x1F));
+        worst = std::max(worst, std::max(dr, std::max(dg, db)));
+    }
+    return worst;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int passes = 200;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--passes") == 0 && i + 1 < argc) {
+            passes = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: %s [--passes N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<pixel_t> frame(SCREEN_W * SCREEN_H);
+    srand(1);
+    for (auto& p : frame) p = static_cast<pixel_t>(rand());
+
+    const struct {
+        const char* name;
+        bool        scanlines;
+        bool        vignette;
+    } cases[] = {
+        {"scanlines", true, false},
+        {"vignette", false, true},
+        {"both", true, true},
+    };
+
+    std::printf("%-10s %10s %10s %8s\n", "effect", "ref_us", "map_us", "max_diff");
+    for (const auto& c : cases) {
+        const double ref_us = us_per_frame(frame, passes, [&](pixel_t* b) { ref_post_fx(b, c.scanlines, c.vignette); });
+        const double map_us =
+            us_per_frame(frame, passes, [&](pixel_t* b) { system_overlay_post_fx(b, c.scanlines, c.vignette); });
+
+        std::vector<pixel_t> ref = frame;
+        std::vector<pixel_t> map = frame;
+        ref_post_fx(ref.data(), c.scanlines, c.vignette);
+        system_overlay_post_fx(map.data(), c.scanlines, c.vignette);
+        std::printf("%-10s %10.1f %10.1f %8d\n", c.name, ref_us, map_us, max_channel_diff(ref, map));
+    }
+    return 0;
+}
@@ -0,0 +1,71 @@
+#pragma once
+// Scenario table shared by the host render tests (test_render_pipeline,
+// test_present): mood, border state, talking energy, a gesture re-triggered
+// every second and the face flags, driven frame by frame like face_ui_task.
+
+#include "config.h"
+#include "conv_border.h"
+#include "face_state.h"
+#include "protocol.h"
+
+#include <cstdint>
+
+struct RenderCase {
+    const char*   name;
+    Mood          mood;
+    FaceConvState conv_state;
+    uint8_t       talking_energy; // 0 = not talking
+    int           gesture;        // GestureId re-triggered every second, -1 = none
+    uint8_t       flags;
+};
+
+constexpr uint8_t RENDER_CASE_NO_AFTERGLOW = static_cast<uint8_t>(FACE_FLAGS_ALL & ~FACE_FLAG_AFTERGLOW);
+constexpr uint8_t RENDER_CASE_PUPIL_EYES = static_cast<uint8_t>(RENDER_CASE_NO_AFTERGLOW & ~FACE_FLAG_SOLID_EYE);
+constexpr uint8_t RENDER_CASE_NO_SPARKLE = static_cast<uint8_t>(RENDER_CASE_NO_AFTERGLOW & ~FACE_FLAG_SPARKLE);
+
+constexpr RenderCase RENDER_CASES[] = {
+    {"idle", Mood::NEUTRAL, FaceConvState::IDLE, 0, -1, RENDER_CASE_NO_AFTERGLOW},
+    {"listening", Mood::CURIOUS, FaceConvState::LISTENING, 0, -1, RENDER_CASE_NO_AFTERGLOW},
+    {"talking", Mood::HAPPY, FaceConvState::SPEAKING, 200, -1, RENDER_CASE_NO_AFTERGLOW},
+    {"surprised", Mood::SURPRISED, FaceConvState::IDLE, 255, static_cast<int>(GestureId::SURPRISE),
+     RENDER_CASE_NO_AFTERGLOW},
+    {"heart", Mood::LOVE, FaceConvState::IDLE, 0, static_cast<int>(GestureId::HEART), RENDER_CASE_NO_AFTERGLOW},
+    {"heart_pupil", Mood::LOVE, FaceConvState::IDLE, 0, static_cast<int>(GestureId::HEART), RENDER_CASE_PUPIL_EYES},
+    {"thinking", Mood::NEUTRAL, FaceConvState::THINKING, 0, -1, RENDER_CASE_NO_SPARKLE},
+    {"x_eyes", Mood::SAD, FaceConvState::THINKING, 0, static_cast<int>(GestureId::X_EYES), RENDER_CASE_NO_AFTERGLOW},
+    {"afterglow", Mood::EXCITED, FaceConvState::IDLE, 120, static_cast<int>(GestureId::LAUGH), FACE_FLAGS_ALL},
+    {"rage", Mood::ANGRY, FaceConvState::IDLE, 0, static_cast<int>(GestureId::RAGE), RENDER_CASE_NO_AFTERGLOW},
+};
+
+// Fresh FaceState for c; also sets the border state.
+inline FaceState render_case_begin(const RenderCase& c)
+{
+    FaceState fs;
+    fs.anim.idle = (c.flags & FACE_FLAG_IDLE_WANDER) != 0;
+    fs.anim.autoblink = (c.flags & FACE_FLAG_AUTOBLINK) != 0;
+    fs.solid_eye = (c.flags & FACE_FLAG_SOLID_EYE) != 0;
+    fs.show_mouth = (c.flags & FACE_FLAG_SHOW_MOUTH) != 0;
+    fs.fx.edge_glow = (c.flags & FACE_FLAG_EDGE_GLOW) != 0;
+    fs.fx.sparkle = (c.flags & FACE_FLAG_SPARKLE) != 0;
+    fs.fx.afterglow = (c.flags & FACE_FLAG_AFTERGLOW) != 0;
+    fs.fx.boot_active = false;
+    fs.eye_l.openness = 1.0f;
+    fs.eye_r.openness = 1.0f;
+    face_set_mood(fs, c.mood);
+    face_set_expression_intensity(fs, 1.0f);
+    fs.talking = c.talking_energy > 0;
+    fs.talking_energy = static_cast<float>(c.talking_energy) / 255.0f;
+    conv_border_set_state(static_cast<uint8_t>(c.conv_state));
+    return fs;
+}
+
+// Advances border and face animation to frame i (call before rendering it).
+inline void render_case_step(const RenderCase& c, FaceState& fs, int i)
+{
+    if (c.gesture >= 0 && i % ANIM_FPS == 0) {
+        face_trigger_gesture(fs, static_cast<GestureId>(c.gesture));
+    }
+    conv_border_set_energy(fs.talking_energy);
+    conv_border_update(1.0f / ANIM_FPS);
+    face_state_update(fs, 1.0f / ANIM_FPS);
+}
@@ -0,0 +1,38 @@
+#include "esp_timer.h"
+
+#include <chrono>
+
+namespace
+{
+const auto s_epoch = std::chrono::steady_clock::now();
+int64_t    s_offset_us = 0;
+bool       s_manual = false;
+} // namespace
+
+int64_t esp_timer_get_time()
+{
+    if (s_manual) {
+        return s_offset_us;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - s_epoch;
+    return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() + s_offset_us;
+}
+
+void host_timer_advance_us(int64_t us)
+{
+    if (us > 0) {
+        s_offset_us += us;
+    }
+}
+
+void host_timer_set_manual(bool manual)
+{
+    if (manual == s_manual) {
+        return;
+    }
+    // Keep the clock continuous across the mode switch.
+    const int64_t now = esp_timer_get_time();
+    s_manual = manual;
+    s_offset_us = 0;
+    s_offset_us = now - esp_timer_get_time();
+}
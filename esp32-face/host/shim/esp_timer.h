@@ -0,0 +1,14 @@
+#pragma once
+// Host shim for esp_timer — just enough for the face renderer and FaceState.
+//
+// esp_timer_get_time() returns monotonic wall time plus a virtual offset.
+// host_timer_advance_us() bumps the offset so the bench can emulate the
+// vTaskDelay() between frames without actually sleeping. In manual mode the
+// clock ignores wall time entirely (deterministic tests).
+
+#include <cstdint>
+
+int64_t esp_timer_get_time();
+
+void host_timer_advance_us(int64_t us);
+void host_timer_set_manual(bool manual);
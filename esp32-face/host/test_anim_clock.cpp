@@ -0,0 +1,182 @@
+// Frame-rate independence of the face animation: one scripted scenario (gaze
+// targets, mood changes) runs through face_state_update at 10, 30 and 60 FPS
+// and at 30 FPS with jittered frame periods, each frame advanced by
+// anim_clock_tick over the host timer. Saccade jitter is random per trigger,
+// so it is held off. Every 100 ms, a time all rates share, the animated values
+// must match the 30 FPS run within tolerance. The old fixed 1/ANIM_FPS step at 10 FPS
+// must not, which shows the tolerances can see a slowed animation.
+
+#include "config.h"
+#include "esp_timer.h"
+#include "face_state.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+
+constexpr int MARKS = 30; // 100 ms marks, 3 s
+
+struct Sample {
+    float gaze;   // both eyes, x and y
+    float shape;  // openness, eye scales, lids, mouth (0..1 ranges)
+    float breath; // breath scale
+};
+
+// Tolerances per group, max abs error against the 30 FPS run.
+constexpr float GAZE_TOL = 0.05f;
+constexpr float SHAPE_TOL = 0.005f;
+constexpr float BREATH_TOL = 0.0005f;
+
+struct Values {
+    float gaze[4];
+    float shape[12];
+    float breath;
+};
+
+Values capture(const FaceState& fs)
+{
+    Values v;
+    v.gaze[0] = fs.eye_l.gaze_x;
+    v.gaze[1] = fs.eye_l.gaze_y;
+    v.gaze[2] = fs.eye_r.gaze_x;
+    v.gaze[3] = fs.eye_r.gaze_y;
+    v.shape[0] = fs.eye_l.openness;
+    v.shape[1] = fs.eye_r.openness;
+    v.shape[2] = fs.eye_l.width_scale;
+    v.shape[3] = fs.eye_l.height_scale;
+    v.shape[4] = fs.eyelids.top_l;
+    v.shape[5] = fs.eyelids.top_r;
+    v.shape[6] = fs.eyelids.bottom_l;
+    v.shape[7] = fs.eyelids.slope;
+    v.shape[8] = fs.mouth_curve;
+    v.shape[9] = fs.mouth_open;
+    v.shape[10] = fs.mouth_width;
+    v.shape[11] = fs.mouth_offset_x;
+    v.breath = face_get_breath_scale(fs);
+    return v;
+}
+
+// Script step at 100 ms mark m (before that frame's update).
+void script(FaceState& fs, int m)
+{
+    switch (m) {
+    case 0:
+        face_set_gaze(fs, 8.0f, -4.0f);
+        break;
+    case 5:
+        face_set_mood(fs, Mood::HAPPY);
+        break;
+    case 15:
+        face_set_gaze(fs, -8.0f, 4.0f);
+        face_set_mood(fs, Mood::SURPRISED);
+        break;
+    case 25:
+        face_set_mood(fs, Mood::SAD);
+        break;
+    default:
+        break;
+    }
+}
+
+// Frame periods within one 100 ms mark, repeated for every mark.
+struct Rate {
+    const char* name;
+    int         frames;     // per mark
+    int64_t     period_us[6];
+};
+
+constexpr Rate RATE_30 = {"30 fps", 3, {33333, 33333, 33334}};
+constexpr Rate RATES[] = {
+    {"10 fps", 1, {100000}},
+    {"60 fps", 6, {16667, 16667, 16666, 16667, 16667, 16666}},
+    {"30 fps jitter", 3, {28000, 38667, 33333}},
+};
+
+// Values at each mark. fixed_dt > 0 replaces the measured frame time.
+std::vector<Values> run(const Rate& rate, float fixed_dt = 0.0f)
+{
+    host_timer_set_manual(true);
+    srand(1);
+
+    FaceState fs;
+    fs.fx.boot_active = false;
+    fs.fx.sparkle = false;
+    fs.anim.idle = false;
+    fs.anim.autoblink = false;
+    fs.eye_l.openness = 1.0f;
+    fs.eye_r.openness = 1.0f;
+
+    AnimClock clock;
+    clock.last_us = esp_timer_get_time() - rate.period_us[rate.frames - 1]; // as if one frame already ran
+
+    std::vector<Values> out;
+    for (int m = 0; m < MARKS; m++) {
+        script(fs, m);
+        for (int i = 0; i < rate.frames; i++) {
+            fs.anim.next_saccade = 1e9f; // random jitter, drawn per trigger
+            const float dt = anim_clock_tick(clock, esp_timer_get_time());
+            face_state_update(fs, fixed_dt > 0.0f ? fixed_dt : dt);
+            host_timer_advance_us(rate.period_us[i]);
+        }
+        out.push_back(capture(fs));
+    }
+    return out;
+}
+
+Sample max_error(const std::vector<Values>& got, const std::vector<Values>& ref)
+{
+    Sample e = {0.0f, 0.0f, 0.0f};
+    for (std::size_t m = 0; m < ref.size(); m++) {
+        for (int k = 0; k < 4; k++) e.gaze = fmaxf(e.gaze, fabsf(got[m].gaze[k] - ref[m].gaze[k]));
+        for (int k = 0; k < 12; k++) e.shape = fmaxf(e.shape, fabsf(got[m].shape[k] - ref[m].shape[k]));
+        e.breath = fmaxf(e.breath, fabsf(got[m].breath - ref[m].breath));
+    }
+    return e;
+}
+
+bool within(const Sample& e)
+{
+    return e.gaze <= GAZE_TOL && e.shape <= SHAPE_TOL && e.breath <= BREATH_TOL;
+}
+
+void print(const char* name, const Sample& e)
+{
+    std::printf("%-16s gaze %.3f  shape %.4f  breath %.5f", name, static_cast<double>(e.gaze),
+                static_cast<double>(e.shape), static_cast<double>(e.breath));
+}
+
+} // namespace
+
+int main()
+{
+    const std::vector<Values> ref = run(RATE_30);
+    bool                      ok = true;
+
+    for (const Rate& rate : RATES) {
+        const Sample e = max_error(run(rate), ref);
+        print(rate.name, e);
+        if (within(e)) {
+            std::printf("  ok\n");
+        } else {
+            std::printf("  FAIL: over tolerance\n");
+            ok = false;
+        }
+    }
+
+    const Sample fixed = max_error(run(RATES[0], 1.0f / ANIM_FPS), ref);
+    print("10 fps fixed dt", fixed);
+    if (within(fixed)) {
+        std::printf("  FAIL: tolerances do not catch a slowed animation\n");
+        ok = false;
+    } else {
+        std::printf("  diverges, as expected\n");
+    }
+
+    std::printf("%-16s gaze %.3f  shape %.4f  breath %.5f\n", "tolerance", static_cast<double>(GAZE_TOL),
+                static_cast<double>(SHAPE_TOL), static_cast<double>(BREATH_TOL));
+    return ok ? 0 : 1;
+}
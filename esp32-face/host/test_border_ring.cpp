@@ -0,0 +1,177 @@
+// Border perimeter ring cache vs the per-pixel frame blend (border_ref.h).
+// Walks the conversation states that draw the frame, over a background canvas
+// and, every third frame, over one with content scattered under the ring; the
+// frame must match the reference exactly, as must the ATTENTION sweep at
+// several frame steps. THINKING adds the orbit dot sprites, which must stay
+// within a bound of the analytic dots. Then checks that a settled THINKING
+// border stops re-compositing and draws the ring as plain copies.
+
+#include "border_ref.h"
+#include "config.h"
+#include "conv_border.h"
+#include "protocol.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+
+constexpr float DT = 1.0f / ANIM_FPS;
+constexpr int   DOT_MAX_ERR = 32; // 8-bit channel; dot centers snap to a 1/4 px grid
+
+DirtyRegion full_region()
+{
+    DirtyRegion r;
+    r.full = true;
+    return r;
+}
+
+int max_channel_err(const std::vector<pixel_t>& a, const std::vector<pixel_t>& b)
+{
+    int worst = 0;
+    for (std::size_t k = 0; k < a.size(); k++) {
+        const int d[3] = {abs(px_r(a[k]) - px_r(b[k])), abs(px_g(a[k]) - px_g(b[k])), abs(px_b(a[k]) - px_b(b[k]))};
+        for (int c : d) {
+            if (c > worst) worst = c;
+        }
+    }
+    return worst;
+}
+
+struct Phase {
+    const char*   name;
+    FaceConvState state;
+    int           frames;
+};
+
+// THINKING is left out of the exact comparison: its orbit dots draw on top.
+constexpr Phase PHASES[] = {
+    {"listening", FaceConvState::LISTENING, 90},
+    {"ptt", FaceConvState::PTT, 60},
+    {"speaking", FaceConvState::SPEAKING, 90},
+    {"error", FaceConvState::ERROR, 45},
+    {"listening2", FaceConvState::LISTENING, 30},
+    {"done", FaceConvState::DONE, 45},
+};
+
+void fill_canvas(std::vector<pixel_t>& buf, bool scatter)
+{
+    std::fill(buf.begin(), buf.end(), px_rgb(0, 0, 0));
+    if (!scatter) return;
+    for (int i = 0; i < 400; i++) {
+        buf[static_cast<std::size_t>(rand()) % buf.size()] = static_cast<pixel_t>(rand());
+    }
+}
+
+} // namespace
+
+int main()
+{
+    srand(5);
+    const DirtyRegion    FULL = full_region();
+    std::vector<pixel_t> got(SCREEN_W * SCREEN_H);
+    std::vector<pixel_t> want(SCREEN_W * SCREEN_H);
+
+    bool ok = true;
+    int  frame = 0;
+    for (const Phase& p : PHASES) {
+        conv_border_set_state(static_cast<uint8_t>(p.state));
+        int diffs = 0;
+        for (int i = 0; i < p.frames; i++, frame++) {
+            conv_border_set_energy(0.5f + 0.5f * static_cast<float>((i * 7) % 11) / 10.0f);
+            conv_border_update(DT);
+
+            fill_canvas(got, frame % 3 == 0);
+            want = got;
+            conv_border_render(got.data(), FULL);
+            if (conv_border_active()) {
+                uint8_t r, g, b, a;
+                conv_border_get_glow(r, g, b, a);
+                border_ref_draw(want.data(), r, g, b, a);
+            }
+            for (std::size_t k = 0; k < got.size(); k++) {
+                if (got[k] != want[k]) diffs++;
+            }
+        }
+        std::printf("%-11s %3d frames  %s\n", p.name, p.frames, diffs == 0 ? "identical" : "FAIL");
+        if (diffs != 0) {
+            std::printf("  %d pixels differ\n", diffs);
+            ok = false;
+        }
+    }
+
+    // ATTENTION sweeps at a few frame steps, so the sweep depth takes many
+    // fractional values. The timer mirrors conv_border_update()'s.
+    constexpr float ATTENTION_STEPS[] = {1.0f / 30.0f, 1.0f / 60.0f, 0.007f};
+    for (const float dt : ATTENTION_STEPS) {
+        conv_border_set_state(static_cast<uint8_t>(FaceConvState::IDLE));
+        conv_border_set_state(static_cast<uint8_t>(FaceConvState::ATTENTION));
+        float timer = 0.0f;
+        int   frames = 0;
+        int   diffs = 0;
+        while (timer + dt < 0.4f) {
+            conv_border_update(dt);
+            timer += dt;
+            fill_canvas(got, frames % 2 == 0);
+            want = got;
+            conv_border_render(got.data(), FULL);
+            border_ref_attention(want.data(), timer);
+            for (std::size_t k = 0; k < got.size(); k++) {
+                if (got[k] != want[k]) diffs++;
+            }
+            frames++;
+        }
+        std::printf("attention   %3d frames at %.1f ms  %s\n", frames, dt * 1000.0f, diffs == 0 ? "identical" : "FAIL");
+        if (diffs != 0) {
+            std::printf("  %d pixels differ\n", diffs);
+            ok = false;
+        }
+    }
+
+    // THINKING fades in with the orbit dots on top; the dots are sprites, so
+    // they match within DOT_MAX_ERR. The orbit mirrors conv_border_update()'s
+    // (nothing earlier ran THINKING). Settles, then a second of steady frames
+    // over a clean canvas.
+    conv_border_set_state(static_cast<uint8_t>(FaceConvState::THINKING));
+    float orbit = 0.0f;
+    int   dot_err = 0;
+    for (int i = 0; i < ANIM_FPS * 3; i++) {
+        conv_border_update(DT);
+        orbit = fmodf(orbit + 0.5f * DT, 1.0f);
+        fill_canvas(got, i % 3 == 0);
+        want = got;
+        conv_border_render(got.data(), FULL);
+        if (conv_border_active()) {
+            uint8_t r, g, b, a;
+            conv_border_get_glow(r, g, b, a);
+            border_ref_draw(want.data(), r, g, b, a);
+            border_ref_dots(want.data(), orbit);
+        }
+        const int e = max_channel_err(got, want);
+        if (e > dot_err) dot_err = e;
+    }
+    std::printf("thinking    %3d frames  max dot err %d (<= %d)  %s\n", ANIM_FPS * 3, dot_err, DOT_MAX_ERR,
+                dot_err <= DOT_MAX_ERR ? "ok" : "FAIL");
+    ok &= dot_err <= DOT_MAX_ERR;
+
+    const ConvBorderStats before = conv_border_stats();
+    for (int i = 0; i < ANIM_FPS; i++) {
+        conv_border_update(DT);
+        fill_canvas(got, false);
+        conv_border_render(got.data(), FULL);
+    }
+    const ConvBorderStats after = conv_border_stats();
+    const uint32_t        builds = after.ring_builds - before.ring_builds;
+    const uint32_t        copied = after.ring_copy_px - before.ring_copy_px;
+    const uint32_t        blended = after.ring_blend_px - before.ring_blend_px;
+    const bool            steady_ok = builds == 0 && blended == 0 && copied > 0;
+    std::printf("thinking    steady: %u rebuilds, %u px copied, %u px blended  %s\n", builds, copied, blended,
+                steady_ok ? "ok" : "FAIL");
+    ok &= steady_ok;
+
+    std::printf("%s\n", ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
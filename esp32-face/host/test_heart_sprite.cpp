@@ -0,0 +1,126 @@
+// Heart sprite cache vs the analytic per-pixel SDF (heart_ref.h). Draws white
+// on black so the 8-bit red channel is the composited alpha, and reports the
+// largest per-pixel error for each size, at whole-pixel centers (the display
+// list rounds them):
+//   grid — size on a bucket: only float rounding between local and screen
+//          coordinates may differ;
+//   any  — arbitrary size: adds the snap to the nearest bucket.
+// For arbitrary sizes it also reports the mean error over the pixels either
+// draw, so a systematic edge offset fails even where single pixels pass. Fails
+// if any exceeds its bound, or if a repeated draw is not a cache hit that
+// reproduces the miss exactly.
+
+#include "config.h"
+#include "heart_ref.h"
+#include "heart_sprite.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+
+// 8-bit alpha. A size off its bucket by up to FACE_HEART_SPRITE_SIZE_STEP / 2
+// scales the heart about its center; the edge lies within ~0.75 * size of the
+// center, so it moves at most 0.75 * 0.25 px ~ 0.19 px, and the smoothstep
+// ramp (slope 1.5 / px) turns that into ~72 alpha; the rest is rounding and
+// the edge curvature the linear estimate leaves out.
+constexpr int    GRID_MAX_ERR = 2;
+constexpr int    ANY_MAX_ERR = 80;
+constexpr double ANY_MEAN_ERR = 28.0; // over the pixels either draw; a size-4 heart is nearly all edge
+
+struct Err {
+    int    max = 0;
+    double mean = 0.0;
+};
+
+Err diff(const std::vector<pixel_t>& a, const std::vector<pixel_t>& b)
+{
+    Err      e;
+    uint64_t sum = 0;
+    uint32_t n = 0;
+    for (std::size_t k = 0; k < a.size(); k++) {
+        const int pa = px_r(a[k]);
+        const int pb = px_r(b[k]);
+        if (pa == 0 && pb == 0) continue;
+        const int d = abs(pa - pb);
+        if (d > e.max) e.max = d;
+        sum += static_cast<uint64_t>(d);
+        n++;
+    }
+    e.mean = n > 0 ? static_cast<double>(sum) / n : 0.0;
+    return e;
+}
+
+int pick(int lo, int hi)
+{
+    return lo + rand() % (hi - lo + 1);
+}
+
+} // namespace
+
+int main()
+{
+    srand(11);
+    std::vector<pixel_t> got(SCREEN_W * SCREEN_H);
+    std::vector<pixel_t> want(SCREEN_W * SCREEN_H);
+    std::vector<pixel_t> again(SCREEN_W * SCREEN_H);
+
+    bool   ok = true;
+    int    grid_worst = 0;
+    int    any_worst = 0;
+    double any_mean_worst = 0.0;
+    for (int s = 4; s <= 60; s += 4) {
+        int    grid_err = 0;
+        int    any_err = 0;
+        double any_mean = 0.0;
+        for (int i = 0; i < 8; i++) {
+            // Grid-aligned: bucket size, whole-pixel center (including the
+            // screen edges so clipping is covered).
+            const float size = static_cast<float>(s) + FACE_HEART_SPRITE_SIZE_STEP * static_cast<float>(i % 2);
+            const int   cx = i == 0 ? 3 : pick(0, SCREEN_W);
+            const int   cy = i == 1 ? SCREEN_H - 2 : pick(0, SCREEN_H);
+            std::fill(got.begin(), got.end(), 0);
+            std::fill(want.begin(), want.end(), 0);
+            std::fill(again.begin(), again.end(), 0);
+            heart_sprite_draw(got.data(), cx, cy, size, 255, 255, 255);
+            heart_ref_draw(want.data(), static_cast<float>(cx), static_cast<float>(cy), size, 255, 255, 255);
+            const int e = diff(got, want).max;
+            if (e > grid_err) grid_err = e;
+
+            const HeartSpriteStats before = heart_sprite_stats();
+            heart_sprite_draw(again.data(), cx, cy, size, 255, 255, 255);
+            const HeartSpriteStats after = heart_sprite_stats();
+            if (after.hits != before.hits + 1 || got != again) {
+                std::printf("size %.1f at (%d, %d): repeat draw %s\n", size, cx, cy,
+                            after.hits != before.hits + 1 ? "missed the cache" : "differs from the miss");
+                ok = false;
+            }
+
+            // Off-grid: any size within a bucket step of the above.
+            const float fsize = size + static_cast<float>(rand() % 1000) / 1000.0f * FACE_HEART_SPRITE_SIZE_STEP;
+            std::fill(got.begin(), got.end(), 0);
+            std::fill(want.begin(), want.end(), 0);
+            heart_sprite_draw(got.data(), cx, cy, fsize, 255, 255, 255);
+            heart_ref_draw(want.data(), static_cast<float>(cx), static_cast<float>(cy), fsize, 255, 255, 255);
+            const Err f = diff(got, want);
+            if (f.max > any_err) any_err = f.max;
+            if (f.mean > any_mean) any_mean = f.mean;
+        }
+        std::printf("size %2d: max err grid %3d  any %3d  any mean %5.1f\n", s, grid_err, any_err, any_mean);
+        if (grid_err > grid_worst) grid_worst = grid_err;
+        if (any_err > any_worst) any_worst = any_err;
+        if (any_mean > any_mean_worst) any_mean_worst = any_mean;
+    }
+
+    const HeartSpriteStats st = heart_sprite_stats();
+    ok &= grid_worst <= GRID_MAX_ERR && any_worst <= ANY_MAX_ERR && any_mean_worst <= ANY_MEAN_ERR &&
+          st.bytes_used <= st.bytes_total;
+    std::printf("max err grid %d (<= %d), any %d (<= %d), any mean %.1f (<= %.1f); cache %u hits %u misses, "
+                "bytes %u / %u  %s\n",
+                grid_worst, GRID_MAX_ERR, any_worst, ANY_MAX_ERR, any_mean_worst, ANY_MEAN_ERR, st.hits, st.misses,
+                st.bytes_used, st.bytes_total, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,61 @@
+// Mouth coverage cache: a hit (RLE blit) must produce exactly the pixels of
+// the miss that recorded it, including shapes clipped by the screen edge.
+
+#include "config.h"
+#include "mouth_cache.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+
+std::vector<pixel_t> background(unsigned seed)
+{
+    std::vector<pixel_t> buf(SCREEN_W * SCREEN_H);
+    srand(seed);
+    for (auto& p : buf) p = static_cast<pixel_t>(rand());
+    return buf;
+}
+
+} // namespace
+
+int main()
+{
+    const MouthShape shapes[] = {
+        // cx, cy, half_w, thick, curve, open, snap
+        {160.0f, 185.0f, 60.0f, 8.0f, 12.0f, 0.0f, 0.0f},
+        {163.3f, 185.0f, 44.5f, 8.0f, -20.0f, 6.0f, 0.0f},
+        {160.0f, 185.0f, 70.0f, 8.0f, 0.0f, 40.0f, 4.0f},
+        {10.7f, 230.2f, 60.0f, 8.0f, 30.0f, 25.0f, 0.0f},  // clipped left / bottom
+        {300.1f, 4.6f, 60.0f, 8.0f, -35.0f, 12.0f, 0.0f},  // clipped right / top
+        {160.0f, 120.0f, 200.0f, 8.0f, 10.0f, 5.0f, 0.0f}, // wider than a cacheable mask
+    };
+
+    bool     ok = true;
+    unsigned seed = 1;
+    for (const MouthShape& s : shapes) {
+        std::vector<pixel_t> miss = background(seed);
+        std::vector<pixel_t> hit = background(seed);
+        seed++;
+
+        const MouthCacheStats before = mouth_cache_stats();
+        mouth_cache_draw(miss.data(), s, 250, 120, 40);
+        mouth_cache_draw(hit.data(), s, 250, 120, 40);
+        const MouthCacheStats after = mouth_cache_stats();
+
+        const bool same = std::memcmp(miss.data(), hit.data(), miss.size() * sizeof(pixel_t)) == 0;
+        const bool drew = std::memcmp(miss.data(), background(seed - 1).data(), miss.size() * sizeof(pixel_t)) != 0;
+        std::printf("cx=%6.1f cy=%6.1f w=%5.1f curve=%5.1f open=%4.1f  hits+%u misses+%u  %s\n", s.cx, s.cy,
+                    s.half_w, s.curve, s.open, after.hits - before.hits, after.misses - before.misses,
+                    same && drew ? "ok" : "FAIL");
+        ok &= same && drew;
+    }
+
+    const MouthCacheStats st = mouth_cache_stats();
+    std::printf("cache bytes %u / %u\n", st.bytes_used, st.bytes_total);
+    ok &= st.bytes_used <= st.bytes_total;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,77 @@
+// Column-analytic mouth rasterizer vs the per-pixel SDF golden (mouth_ref.h).
+// Shapes sit on the cache's quantization grid so both see identical geometry;
+// every pixel must match. Also reports the rasterize cost of each path.
+
+#include "config.h"
+#include "mouth_cache.h"
+#include "mouth_ref.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+
+constexpr int SHAPES = 400;
+
+float pick(float lo, float hi, float step)
+{
+    const int n = static_cast<int>((hi - lo) / step);
+    return lo + step * static_cast<float>(rand() % (n + 1));
+}
+
+} // namespace
+
+int main()
+{
+    srand(7);
+    std::vector<pixel_t> got(SCREEN_W * SCREEN_H);
+    std::vector<pixel_t> want(SCREEN_W * SCREEN_H);
+    const float          thicks[] = {2.0f, 3.0f, 5.5f, MOUTH_THICKNESS, 12.0f};
+
+    bool   ok = true;
+    double t_col = 0.0;
+    double t_ref = 0.0;
+    for (int i = 0; i < SHAPES && ok; i++) {
+        MouthShape s;
+        s.cx = pick(20.0f, 300.0f, 0.25f);
+        s.cy = pick(20.0f, 230.0f, 0.25f);
+        s.half_w = pick(1.0f, 90.0f, 0.5f);
+        s.thick = thicks[rand() % 5];
+        s.curve = pick(-40.0f, 40.0f, 0.5f);
+        s.open = (rand() % 3 == 0) ? pick(0.0f, 1.5f, 0.5f) : pick(0.0f, 56.0f, 0.5f);
+
+        for (auto& p : got) p = static_cast<pixel_t>(rand());
+        want = got;
+
+        const int   ox = static_cast<int>(floorf(s.cx));
+        const int   oy = static_cast<int>(floorf(s.cy));
+        const auto  t0 = std::chrono::steady_clock::now();
+        mouth_cache_draw(got.data(), s, 230, 90, 40); // fresh key: miss path rasterizes
+        const auto  t1 = std::chrono::steady_clock::now();
+        mouth_ref_draw(want.data(), ox, oy, s.cx - static_cast<float>(ox), s.cy - static_cast<float>(oy), s.half_w,
+                       s.thick, s.curve, s.open, 230, 90, 40);
+        const auto  t2 = std::chrono::steady_clock::now();
+        t_col += std::chrono::duration<double, std::micro>(t1 - t0).count();
+        t_ref += std::chrono::duration<double, std::micro>(t2 - t1).count();
+
+        for (int k = 0; k < SCREEN_W * SCREEN_H; k++) {
+            if (got[k] != want[k]) {
+                std::printf("mismatch shape %d (cx=%.2f cy=%.2f w=%.1f thick=%.1f curve=%.1f open=%.1f) at (%d,%d): "
+                            "got 0x%04x want 0x%04x\n",
+                            i, s.cx, s.cy, s.half_w, s.thick, s.curve, s.open, k % SCREEN_W, k / SCREEN_W, got[k],
+                            want[k]);
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    std::printf("%d shapes: column %.1f us/shape, per-pixel SDF %.1f us/shape  %s\n", SHAPES,
+                t_col / SHAPES, t_ref / SHAPES, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
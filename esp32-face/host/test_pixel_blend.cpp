@@ -0,0 +1,135 @@
+// Exhaustive equivalence of the fixed-point RGB565 blend against the float
+// reference: every (bg channel, fg channel, alpha_u8) triple, plus float alphas
+// on a 1/4096 grid through px_alpha_u8(). Fails above +-1 LSB per channel.
+// The byte-swapped layout must give exactly the swapped native result.
+
+#include "pixel.h"
+#include "pixel_ref.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+
+constexpr PxOrder NATIVE = PxOrder::NATIVE;
+constexpr PxOrder SWAPPED = PxOrder::SWAPPED;
+
+struct ChannelErr {
+    int r = 0;
+    int g = 0;
+    int b = 0;
+};
+
+void accumulate(ChannelErr& e, pixel_t got, pixel_t want)
+{
+    const int dr = abs(((got >> 11) & 0x1F) - ((want >> 11) & 0x1F));
+    const int dg = abs(((got >> 5) & 0x3F) - ((want >> 5) & 0x3F));
+    const int db = abs((got & 0x1F) - (want & 0x1F));
+    if (dr > e.r) e.r = dr;
+    if (dg > e.g) e.g = dg;
+    if (db > e.b) e.b = db;
+}
+
+// bg covers every 5-bit (r, b) and 6-bit (g) channel value; fg is gray so each
+// channel sees every 8-bit foreground value. Channels are independent.
+pixel_t bg_for(int c)
+{
+    return static_cast<pixel_t>(((c & 0x1F) << 11) | (c << 5) | (c & 0x1F));
+}
+
+bool report(const char* name, const ChannelErr& e)
+{
+    const bool ok = e.r <= 1 && e.g <= 1 && e.b <= 1;
+    std::printf("%-28s max |err| r=%d g=%d b=%d  %s\n", name, e.r, e.g, e.b, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+} // namespace
+
+int main()
+{
+    bool ok = true;
+
+    ChannelErr blend_u8;
+    for (int a = 0; a < 256; a++) {
+        const float alpha = static_cast<float>(a) / 255.0f;
+        for (int fg = 0; fg < 256; fg++) {
+            const uint8_t v = static_cast<uint8_t>(fg);
+            for (int c = 0; c < 64; c++) {
+                const pixel_t bg = bg_for(c);
+                accumulate(blend_u8, px_blend_u8<NATIVE>(bg, v, v, v, static_cast<uint8_t>(a)),
+                           px_blend_float<NATIVE>(bg, v, v, v, alpha));
+            }
+        }
+    }
+    ok &= report("px_blend_u8 (all alpha_u8)", blend_u8);
+
+    ChannelErr blend_f;
+    for (int i = 0; i <= 4096; i++) {
+        const float   alpha = static_cast<float>(i) / 4096.0f;
+        const uint8_t a = px_alpha_u8(alpha);
+        for (int fg = 0; fg < 256; fg++) {
+            const uint8_t v = static_cast<uint8_t>(fg);
+            for (int c = 0; c < 64; c++) {
+                const pixel_t bg = bg_for(c);
+                accumulate(blend_f, px_blend_u8<NATIVE>(bg, v, v, v, a), px_blend_float<NATIVE>(bg, v, v, v, alpha));
+            }
+        }
+    }
+    ok &= report("px_blend_u8 (float alpha)", blend_f);
+
+    ChannelErr scale;
+    for (int s = 0; s < 256; s++) {
+        for (int p = 0; p < 65536; p++) {
+            const pixel_t px = static_cast<pixel_t>(p);
+            const float   k = static_cast<float>(s) / 255.0f;
+            const pixel_t want = static_cast<pixel_t>(
+                (static_cast<int>(((px >> 11) & 0x1F) * k) << 11) | (static_cast<int>(((px >> 5) & 0x3F) * k) << 5) |
+                static_cast<int>((px & 0x1F) * k));
+            accumulate(scale, px_scale_255<NATIVE>(px, static_cast<uint8_t>(s)), want);
+        }
+    }
+    ok &= report("px_scale_255", scale);
+
+    // Endpoints must be exact.
+    for (int p = 0; p < 65536; p++) {
+        const pixel_t px = static_cast<pixel_t>(p);
+        if (px_blend_u8<NATIVE>(px, 10, 200, 30, 0) != px ||
+            px_blend_u8<NATIVE>(px, 10, 200, 30, 255) != px_rgb<NATIVE>(10, 200, 30) ||
+            px_scale_255<NATIVE>(px, 255) != px || px_scale_255<NATIVE>(px, 0) != 0) {
+            std::printf("endpoint mismatch at 0x%04x\n", p);
+            ok = false;
+            break;
+        }
+    }
+
+    // Byte-swapped layout: every helper is the native one behind px_bswap.
+    bool swapped_ok = true;
+    for (int p = 0; p < 65536 && swapped_ok; p++) {
+        const pixel_t px = static_cast<pixel_t>(p);
+        const pixel_t sw = px_bswap(px);
+        swapped_ok = px_r<SWAPPED>(sw) == px_r<NATIVE>(px) && px_g<SWAPPED>(sw) == px_g<NATIVE>(px) &&
+                     px_b<SWAPPED>(sw) == px_b<NATIVE>(px);
+        for (int s = 0; s < 256 && swapped_ok; s++) {
+            const uint8_t k = static_cast<uint8_t>(s);
+            const uint8_t r = k;
+            const uint8_t g = static_cast<uint8_t>(255 - k);
+            const uint8_t b = static_cast<uint8_t>(k / 2);
+            swapped_ok = px_scale_255<SWAPPED>(sw, k) == px_bswap(px_scale_255<NATIVE>(px, k)) &&
+                         px_blend_u8<SWAPPED>(sw, r, g, b, k) == px_bswap(px_blend_u8<NATIVE>(px, r, g, b, k)) &&
+                         px_blend_u8<SWAPPED>(sw, 10, 200, 30, k) == px_bswap(px_blend_u8<NATIVE>(px, 10, 200, 30, k));
+        }
+        if (!swapped_ok) std::printf("swapped layout mismatch at 0x%04x\n", p);
+    }
+    for (int c = 0; c < (1 << 15) && swapped_ok; c++) {
+        const uint8_t r = static_cast<uint8_t>(c << 3);
+        const uint8_t g = static_cast<uint8_t>(c >> 2);
+        const uint8_t b = static_cast<uint8_t>(c >> 7);
+        swapped_ok = px_rgb<SWAPPED>(r, g, b) == px_bswap(px_rgb<NATIVE>(r, g, b));
+    }
+    std::printf("%-28s %s\n", "byte-swapped layout", swapped_ok ? "ok" : "FAIL");
+    ok &= swapped_ok;
+
+    return ok ? 0 : 1;
+}
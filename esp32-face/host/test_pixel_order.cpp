@@ -0,0 +1,124 @@
+// Canvas byte order: the renderer built for byte-swapped pixels (face_core,
+// the firmware default) must draw the same image as the CPU-order build
+// (face_core_native) once both are normalized to 5-6-5 values. This binary
+// exists in both builds; the swapped one runs the native one with --dump and
+// compares per-frame hashes over every render_cases.h scenario.
+
+#include "config.h"
+#include "esp_timer.h"
+#include "face_render.h"
+#include "render_cases.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr int     FRAMES = 120;
+constexpr int64_t FRAME_PERIOD_US = 1'000'000 / ANIM_FPS;
+
+pixel_t s_canvas[SCREEN_W * SCREEN_H];
+pixel_t s_afterglow[AFTERGLOW_W * AFTERGLOW_H];
+
+const char* order_name()
+{
+    return PX_ORDER == PxOrder::SWAPPED ? "swapped" : "native";
+}
+
+uint64_t normalized_hash(const pixel_t* buf, std::size_t n)
+{
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (std::size_t i = 0; i < n; i++) {
+        const pixel_t v = px_order(buf[i]);
+        h = (h ^ (v & 0xFF)) * 0x100000001B3ULL;
+        h = (h ^ (v >> 8)) * 0x100000001B3ULL;
+    }
+    return h;
+}
+
+// One hash per frame, scenarios in table order. raw_differs is set if any
+// frame's stored bytes differ from its normalized form.
+std::vector<uint64_t> render_all(bool& raw_differs)
+{
+    std::vector<uint64_t> hashes;
+    raw_differs = false;
+    host_timer_set_manual(true);
+    for (const RenderCase& c : RENDER_CASES) {
+        srand(1234);
+        std::memset(s_canvas, 0, sizeof(s_canvas));
+        face_render_init(s_afterglow);
+        FaceState fs = render_case_begin(c);
+        for (int i = 0; i < FRAMES; i++) {
+            render_case_step(c, fs, i);
+            face_render_frame(s_canvas, fs, nullptr);
+            hashes.push_back(normalized_hash(s_canvas, SCREEN_W * SCREEN_H));
+            for (const pixel_t p : s_canvas) {
+                if (px_order(p) != p) {
+                    raw_differs = true;
+                    break;
+                }
+            }
+            host_timer_advance_us(FRAME_PERIOD_US);
+        }
+    }
+    return hashes;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bool                        raw_differs = false;
+    const std::vector<uint64_t> own = render_all(raw_differs);
+
+    if (argc > 1 && std::strcmp(argv[1], "--dump") == 0) {
+        std::printf("%s\n", order_name());
+        for (const uint64_t h : own) std::printf("%016" PRIx64 "\n", h);
+        return 0;
+    }
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <other-order test_pixel_order> | --dump\n", argv[0]);
+        return 2;
+    }
+
+    const std::string cmd = std::string("\"") + argv[1] + "\" --dump";
+    FILE*             f = popen(cmd.c_str(), "r");
+    if (!f) {
+        std::printf("cannot run %s\n", argv[1]);
+        return 1;
+    }
+    char other_order[16] = {};
+    bool ok = std::fscanf(f, "%15s", other_order) == 1 && std::strcmp(other_order, order_name()) != 0;
+    if (!ok) std::printf("other build is not the opposite order (%s vs %s)\n", other_order, order_name());
+
+    int first_diff = -1;
+    for (std::size_t i = 0; i < own.size() && ok; i++) {
+        uint64_t h = 0;
+        if (std::fscanf(f, "%" SCNx64, &h) != 1) {
+            std::printf("other build stopped after %zu frames\n", i);
+            ok = false;
+        } else if (h != own[i] && first_diff < 0) {
+            first_diff = static_cast<int>(i);
+        }
+    }
+    pclose(f);
+
+    if (first_diff >= 0) {
+        const RenderCase& c = RENDER_CASES[first_diff / FRAMES];
+        std::printf("%s frame %d differs between %s and %s\n", c.name, first_diff % FRAMES, order_name(), other_order);
+        ok = false;
+    }
+    if (!raw_differs) {
+        std::printf("%s canvas never differed from its normalized form\n", order_name());
+        ok = false;
+    }
+    if (ok) {
+        std::printf("%zu frames identical after normalization (%s vs %s)\n", own.size(), order_name(), other_order);
+    }
+    return ok ? 0 : 1;
+}
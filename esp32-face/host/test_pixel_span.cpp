@@ -0,0 +1,165 @@
+// Bit-exactness of the two-pixels-per-word span kernels (pixel_span.h) against
+// the scalar pixel.h helpers, at every start alignment and length parity, plus
+// the Q8 ratios the renderer substitutes for px_scale(num, den). Runs once per
+// pixel byte order.
+
+#include "pixel.h"
+#include "pixel_span.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+
+constexpr int SPAN_MAX = 67;
+
+struct Fixture {
+    std::vector<pixel_t> got;
+    std::vector<pixel_t> want;
+};
+
+// Random canvas with a couple of guard pixels around the span so writes
+// outside [off, off + n) are caught too.
+Fixture make_fixture(unsigned seed)
+{
+    Fixture f;
+    f.got.resize(SPAN_MAX + 8);
+    srand(seed);
+    for (auto& p : f.got) p = static_cast<pixel_t>(rand());
+    f.want = f.got;
+    return f;
+}
+
+bool check(const char* name, const Fixture& f, int off, int n)
+{
+    for (std::size_t i = 0; i < f.got.size(); i++) {
+        if (f.got[i] != f.want[i]) {
+            std::printf("%s mismatch off=%d n=%d at %zu: got 0x%04x want 0x%04x\n", name, off, n, i, f.got[i],
+                        f.want[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Drives kernel over every (offset, length) pair with a fresh random canvas; the
+// 4-byte-aligned vector base means offset 1 exercises the scalar head.
+template <typename Kernel, typename Scalar> bool sweep(const char* name, Kernel kernel, Scalar scalar)
+{
+    unsigned seed = 1;
+    for (int off = 0; off < 4; off++) {
+        for (int n = 0; n <= SPAN_MAX; n++) {
+            Fixture f = make_fixture(seed++);
+            kernel(f.got.data() + off, n, seed);
+            for (int i = 0; i < n; i++) {
+                pixel_t& p = f.want[off + i];
+                p = scalar(p, i, seed);
+            }
+            if (!check(name, f, off, n)) return false;
+        }
+    }
+    return true;
+}
+
+template <PxOrder O> bool run_kernels(const char* order)
+{
+    bool ok = true;
+
+    ok &= sweep(
+        "px_span_fill",
+        [](pixel_t* d, int n, unsigned s) { px_span_fill(d, n, static_cast<pixel_t>(s * 2654435761u)); },
+        [](pixel_t, int, unsigned s) { return static_cast<pixel_t>(s * 2654435761u); });
+
+    for (uint32_t s256 : {0u, 1u, 77u, 103u, 128u, 205u, 255u, 256u}) {
+        ok &= sweep(
+            "px_span_scale", [s256](pixel_t* d, int n, unsigned) { px_span_scale<O>(d, n, s256); },
+            [s256](pixel_t p, int, unsigned) { return px_scale_q8<O>(p, s256); });
+    }
+
+    for (int a = 0; a < 256; a++) {
+        const uint8_t alpha = static_cast<uint8_t>(a);
+        ok &= sweep(
+            "px_span_blend",
+            [alpha](pixel_t* d, int n, unsigned s) {
+                px_span_blend<O>(d, n, static_cast<uint8_t>(s), static_cast<uint8_t>(s * 3), 200, alpha);
+            },
+            [alpha](pixel_t p, int, unsigned s) {
+                return px_blend_u8<O>(p, static_cast<uint8_t>(s), static_cast<uint8_t>(s * 3), 200, alpha);
+            });
+        if (!ok) break;
+    }
+
+    // Masks mix runs of 0 / 255 with fringe values, equal and unequal pairs.
+    std::vector<uint8_t> mask(SPAN_MAX + 8);
+    for (int rep = 0; rep < 16 && ok; rep++) {
+        srand(100 + rep);
+        for (auto& m : mask) {
+            const int k = rand() % 4;
+            m = (k == 0) ? 0 : (k == 1) ? 255 : static_cast<uint8_t>(rand());
+        }
+        for (std::size_t i = 0; i + 1 < mask.size(); i += 2) {
+            if (rand() % 3 == 0) mask[i + 1] = mask[i];
+        }
+        ok &= sweep(
+            "px_span_blend_mask",
+            [&mask](pixel_t* d, int n, unsigned s) {
+                px_span_blend_mask<O>(d, mask.data(), n, static_cast<uint8_t>(s), 90, static_cast<uint8_t>(s * 5));
+            },
+            [&mask](pixel_t p, int i, unsigned s) {
+                return px_blend_u8<O>(p, static_cast<uint8_t>(s), 90, static_cast<uint8_t>(s * 5), mask[i]);
+            });
+    }
+
+    // Multiplier maps: smooth ramps with plateaus, read forwards and mirrored.
+    std::vector<uint8_t> scale(SPAN_MAX + 8);
+    for (int rep = 0; rep < 16 && ok; rep++) {
+        srand(200 + rep);
+        for (auto& m : scale) {
+            const int k = rand() % 4;
+            m = (k == 0) ? 255 : (k == 1) ? 0 : static_cast<uint8_t>(rand());
+        }
+        for (std::size_t i = 0; i + 1 < scale.size(); i += 2) {
+            if (rand() % 3 == 0) scale[i + 1] = scale[i];
+        }
+        ok &= sweep(
+            "px_span_scale_map",
+            [&scale](pixel_t* d, int n, unsigned) { px_span_scale_map<O>(d, scale.data(), n); },
+            [&scale](pixel_t p, int i, unsigned) { return px_scale_255<O>(p, scale[i]); });
+        const uint8_t* last = scale.data() + SPAN_MAX;
+        ok &= sweep(
+            "px_span_scale_map mirrored",
+            [last](pixel_t* d, int n, unsigned) { px_span_scale_map<O>(d, last, n, -1); },
+            [last](pixel_t p, int i, unsigned) { return px_scale_255<O>(p, *(last - i)); });
+    }
+
+    // Ratios used in place of px_scale(num, den) must agree on every pixel.
+    const struct {
+        uint8_t num;
+        uint8_t den;
+    } ratios[] = {{2, 5}, {4, 5}};
+    for (const auto& r : ratios) {
+        const uint32_t q8 = px_q8_ratio(r.num, r.den);
+        for (int p = 0; p < 65536; p++) {
+            const pixel_t px = static_cast<pixel_t>(p);
+            if (px_scale_q8<O>(px, q8) != px_scale<O>(px, r.num, r.den)) {
+                std::printf("px_q8_ratio(%d, %d) mismatch at 0x%04x\n", r.num, r.den, p);
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    std::printf("span kernels (%s): %s\n", order, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+} // namespace
+
+int main()
+{
+    const bool native = run_kernels<PxOrder::NATIVE>("native");
+    const bool swapped = run_kernels<PxOrder::SWAPPED>("byte-swapped");
+    return native && swapped ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+// Presentation path: every scenario renders into two alternating canvases
+// and presents through HostPresenter, the host stand-in for the esp_lcd DMA
+// path. After each frame the panel mirror must equal the canvas just drawn
+// (the dirty rects cover every change), the pushed bytes must match
+// dirty_region_area(), and the average SPI bytes per frame must stay within
+// the scenario's budget. Each scenario runs with and without sparkle; the
+// sparkle and fire particles add only the tiles they cover, so one budget
+// holds for both runs.
+
+#include "config.h"
+#include "esp_timer.h"
+#include "face_present.h"
+#include "face_render.h"
+#include "host_presenter.h"
+#include "render_cases.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+namespace
+{
+
+constexpr int      FRAMES = 240;
+constexpr int64_t  FRAME_PERIOD_US = 1'000'000 / ANIM_FPS;
+constexpr uint32_t FULL_FRAME_BYTES = SCREEN_W * SCREEN_H * sizeof(pixel_t);
+
+pixel_t s_canvas[2][SCREEN_W * SCREEN_H];
+pixel_t s_afterglow[AFTERGLOW_W * AFTERGLOW_H];
+
+struct Budget {
+    const char* name;
+    uint32_t    avg_bytes; // per frame, first (full) frame excluded
+};
+
+// Measured averages plus ~8% headroom; scenarios not listed push full frames.
+constexpr Budget BUDGETS[] = {
+    {"idle", 44'000},
+    {"listening", 77'000},
+    {"talking", 59'000},
+    {"surprised", 84'000},
+    {"heart", 62'000},
+    {"heart_pupil", 72'000},
+    {"thinking", 49'000},
+    {"x_eyes", 53'000},
+    {"afterglow", 74'000},
+    {"rage", 55'000},
+};
+
+uint32_t budget_for(const char* name)
+{
+    for (const Budget& b : BUDGETS) {
+        if (std::strcmp(b.name, name) == 0) return b.avg_bytes;
+    }
+    return FULL_FRAME_BYTES;
+}
+
+bool run_case(const RenderCase& c, bool sparkle)
+{
+    host_timer_set_manual(true);
+    srand(1234);
+    std::memset(s_canvas, 0, sizeof(s_canvas));
+    face_render_init(s_afterglow, 2);
+
+    auto                presenter = std::make_unique<HostPresenter>();
+    const FacePresenter p = presenter->handle();
+
+    FaceState fs = render_case_begin(c);
+    fs.fx.sparkle = fs.fx.sparkle && sparkle;
+    int       first_bad = -1;
+    uint64_t  bytes = 0;
+    uint64_t  rects = 0;
+    for (int i = 0; i < FRAMES; i++) {
+        render_case_step(c, fs, i);
+
+        pixel_t*          canvas = s_canvas[i % 2];
+        const DirtyRegion dirty = face_render_frame(canvas, fs, nullptr);
+        p.wait(p.ctx);
+        p.present(p.ctx, canvas, dirty);
+
+        const bool pixels_ok = std::memcmp(presenter->panel(), canvas, sizeof(s_canvas[0])) == 0;
+        const bool bytes_ok = presenter->last().bytes == dirty_region_area(dirty) * sizeof(pixel_t);
+        const bool first_ok = i > 0 || presenter->last().bytes == FULL_FRAME_BYTES;
+        if (first_bad < 0 && !(pixels_ok && bytes_ok && first_ok)) first_bad = i;
+        if (i > 0) {
+            bytes += presenter->last().bytes;
+            rects += presenter->last().rects;
+        }
+        host_timer_advance_us(FRAME_PERIOD_US);
+    }
+
+    const uint32_t avg = static_cast<uint32_t>(bytes / (FRAMES - 1));
+    const uint32_t budget = budget_for(c.name);
+    std::printf("%-12s %-10s %6u B/frame (budget %6u)  %.2f rects/frame", c.name, sparkle ? "sparkle" : "no sparkle",
+                avg, budget,
+                static_cast<double>(rects) / (FRAMES - 1));
+    if (first_bad >= 0) {
+        std::printf("  FAIL: frame %d panel / byte mismatch\n", first_bad);
+        return false;
+    }
+    if (avg > budget) {
+        std::printf("  FAIL: over budget\n");
+        return false;
+    }
+    std::printf("  ok\n");
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    bool ok = true;
+    for (const RenderCase& c : RENDER_CASES) {
+        ok = run_case(c, true) && ok;
+        ok = run_case(c, false) && ok;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+// Quality governor decisions on synthetic frame times: effects are shed one
+// per window in the documented order while p95 is over budget and never past
+// the last one; a single slow frame per window is below p95 and sheds
+// nothing; restores wait for FACE_QUALITY_RESTORE_WINDOWS windows of headroom,
+// hold between the restore threshold and the budget, and wait twice as long
+// after a restore that had to be shed again. Inactive effects are skipped:
+// with sparkle off the first shed is afterglow, and an effect that goes
+// inactive while shed is dropped without a restore wait. Shed effects must be
+// off in the face state and in the system overlay.
+
+#include "config.h"
+#include "protocol.h"
+#include "face_state.h"
+#include "quality_governor.h"
+#include "system_overlay_v2.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+
+constexpr uint32_t BUDGET = FACE_FRAME_BUDGET_US;
+constexpr uint32_t SLOW = BUDGET + BUDGET / 4;
+constexpr uint32_t CALM = BUDGET * FACE_QUALITY_RESTORE_PCT / 100 - 1000;
+constexpr uint32_t BUSY = BUDGET - 1000; // over the restore threshold, under budget
+constexpr uint8_t  ALL = (1U << QUALITY_LEVEL_MAX) - 1U;
+
+bool s_ok = true;
+
+void check(bool cond, const char* what)
+{
+    if (!cond) {
+        std::printf("FAIL: %s\n", what);
+        s_ok = false;
+    }
+}
+
+// Feeds one window; returns the decision made when it closed.
+int window(QualityGovernor& gov, uint32_t frame_us, int slow_frames = 0, uint8_t active = ALL)
+{
+    int change = 0;
+    for (int i = 0; i < FACE_QUALITY_WINDOW_FRAMES; i++) {
+        const uint32_t us = i < slow_frames ? SLOW : frame_us;
+        const int      c = quality_governor_add_frame(gov, us, active);
+        if (i + 1 < FACE_QUALITY_WINDOW_FRAMES) check(c == 0, "decision before the window closed");
+        change = c;
+    }
+    return change;
+}
+
+// Windows until the next restore, at most `limit`.
+int windows_to_restore(QualityGovernor& gov, int limit, uint8_t active = ALL)
+{
+    for (int n = 1; n <= limit; n++) {
+        if (window(gov, CALM, 0, active) < 0) return n;
+    }
+    return -1;
+}
+
+// QualityShed bits of the first `level` effects in shed order.
+uint8_t shed_prefix(uint8_t level)
+{
+    return static_cast<uint8_t>((1U << level) - 1U);
+}
+
+uint64_t fnv1a(const std::vector<pixel_t>& buf)
+{
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (pixel_t p : buf) h = (h ^ p) * 0x100000001B3ULL;
+    return h;
+}
+
+uint64_t overlay_hash(uint8_t shed)
+{
+    FaceState fs;
+    fs.system.mode = SystemMode::ERROR_DISPLAY;
+    fs.system.timer = 0.0f;
+    quality_apply(fs, shed);
+    std::vector<pixel_t> buf(SCREEN_W * SCREEN_H, 0);
+    render_system_overlay_v2(buf.data(), fs, 0.5f);
+    return fnv1a(buf);
+}
+
+} // namespace
+
+int main()
+{
+    QualityGovernor gov;
+
+    check(window(gov, CALM) == 0 && gov.level == 0, "shed or restore while under budget at level 0");
+    check(window(gov, CALM, 1) == 0 && gov.level == 0, "one slow frame per window shed an effect");
+    check(window(gov, CALM, 2) == 1 && gov.level == 1, "two slow frames per window (p95) shed nothing");
+
+    const uint8_t order[QUALITY_LEVEL_MAX] = {QUALITY_SHED_SPARKLE,  QUALITY_SHED_AFTERGLOW, QUALITY_SHED_EDGE_GLOW,
+                                              QUALITY_SHED_GLITCH,   QUALITY_SHED_VIGNETTE,  QUALITY_SHED_SCANLINES};
+    for (uint8_t level = 2; level <= QUALITY_LEVEL_MAX; level++) {
+        check(window(gov, SLOW) == 1 && gov.level == level, "over budget did not shed one effect per window");
+        check(gov.shed == (shed_prefix(level - 1) | order[level - 1]), "shed order");
+    }
+    check(window(gov, SLOW) == 0 && gov.level == QUALITY_LEVEL_MAX, "shed past the last effect");
+    check(gov.last_p95_us == SLOW, "p95 of a uniform window");
+
+    for (int i = 0; i < 4 * FACE_QUALITY_RESTORE_WINDOWS; i++) window(gov, BUSY);
+    check(gov.level == QUALITY_LEVEL_MAX, "restored without headroom");
+
+    check(windows_to_restore(gov, 16) == FACE_QUALITY_RESTORE_WINDOWS, "restore wait");
+    check(window(gov, SLOW) == 1 && gov.level == QUALITY_LEVEL_MAX, "restored effect did not fit, not re-shed");
+    check(windows_to_restore(gov, 16) == 2 * FACE_QUALITY_RESTORE_WINDOWS, "no backoff after a failed restore");
+    check(window(gov, CALM) == 0, "restore right after a restore");
+    check(windows_to_restore(gov, 16) == FACE_QUALITY_RESTORE_WINDOWS - 1,
+          "backoff not cleared by a restore that held");
+    while (gov.level > 0) {
+        if (windows_to_restore(gov, 16) < 0) break;
+    }
+    check(gov.level == 0, "did not restore everything");
+    check(window(gov, CALM) == 0 && gov.level == 0, "restore below level 0");
+
+    constexpr uint8_t NO_SPARKLE = QUALITY_SHED_AFTERGLOW | QUALITY_SHED_EDGE_GLOW;
+    QualityGovernor   idle;
+    check(window(idle, SLOW, 0, NO_SPARKLE) == 1 && idle.shed == QUALITY_SHED_AFTERGLOW,
+          "first shed with sparkle off was not afterglow");
+    check(window(idle, SLOW, 0, NO_SPARKLE) == 1 && idle.shed == NO_SPARKLE && idle.level == 2,
+          "second shed with sparkle off was not edge glow");
+    check(window(idle, SLOW, 0, NO_SPARKLE) == 0 && idle.level == 2, "shed an inactive effect");
+    check(windows_to_restore(idle, 16, NO_SPARKLE) == FACE_QUALITY_RESTORE_WINDOWS &&
+              idle.shed == QUALITY_SHED_AFTERGLOW,
+          "edge glow did not come back first");
+    check(window(idle, CALM, 0, QUALITY_SHED_EDGE_GLOW) == 0 && idle.shed == 0 && idle.level == 0,
+          "inactive afterglow still waiting for a restore");
+
+    FaceState face;
+    check(quality_active_mask(face, FACE_FLAGS_ALL, false) ==
+              (QUALITY_SHED_SPARKLE | QUALITY_SHED_AFTERGLOW | QUALITY_SHED_EDGE_GLOW),
+          "active face effects");
+    face.system.mode = SystemMode::ERROR_DISPLAY;
+    check(quality_active_mask(face, FACE_FLAGS_ALL, false) == quality_active_mask(FaceState{}, FACE_FLAGS_ALL, false),
+          "system FX active without the overlay renderer");
+    check(quality_active_mask(face, FACE_FLAGS_ALL, true) == (ALL & ~shed_prefix(3)), "active error overlay FX");
+    face.system.mode = SystemMode::UPDATING;
+    check(quality_active_mask(face, FACE_FLAGS_ALL, true) == (QUALITY_SHED_VIGNETTE | QUALITY_SHED_SCANLINES),
+          "glitch active outside the error screen");
+
+    FaceState fs;
+    quality_apply(fs, shed_prefix(3));
+    check(!fs.fx.sparkle && !fs.fx.afterglow && !fs.fx.edge_glow, "shed effects still on");
+    check(fs.fx.shed == shed_prefix(3), "fs.fx.shed");
+    FaceState keep;
+    quality_apply(keep, shed_prefix(1));
+    check(!keep.fx.sparkle && keep.fx.afterglow && keep.fx.edge_glow, "shed more than the level");
+
+    const uint64_t full = overlay_hash(0);
+    check(overlay_hash(shed_prefix(3)) == full, "face effects changed the system overlay");
+    uint64_t prev = full;
+    for (uint8_t level = 4; level <= QUALITY_LEVEL_MAX; level++) {
+        const uint64_t h = overlay_hash(shed_prefix(level));
+        check(h != prev, "shed system FX still drawn");
+        prev = h;
+    }
+
+    std::printf("%s\n", s_ok ? "quality governor ok" : "quality governor FAILED");
+    return s_ok ? 0 : 1;
+}
@@ -0,0 +1,237 @@
+// Render pipeline determinism: every scenario is rendered once into a single
+// canvas on one thread (the reference), then with the top band on a
+// HostRenderWorker thread, into two alternating canvases, and both. Each run
+// is a fresh child process so all start from identical renderer, cache and
+// border state. The canvas drawn and the dirty region must hash the same on
+// every frame, and the split must actually have been taken on some frames.
+// A last mode re-initializes the renderer before every frame, so each one is
+// a full redraw: its canvases must match too, which checks that the partial
+// restore and redraw of the dirty-rect path leave nothing stale.
+// Finally a held LOVE face with solid heart eyes must push nothing once
+// settled, also after a sub-pixel change to the hearts, and must push again
+// when they grow by whole pixels.
+
+#include "config.h"
+#include "conv_border.h"
+#include "esp_timer.h"
+#include "face_render.h"
+#include "host_render_worker.h"
+#include "render_cases.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+constexpr int     FRAMES = 240;
+constexpr int64_t FRAME_PERIOD_US = 1'000'000 / ANIM_FPS;
+
+struct Mode {
+    const char* name;
+    bool        split;
+    uint8_t     canvases;
+    bool        full_redraw; // re-init every frame; dirty rects are not compared
+};
+
+constexpr Mode REFERENCE = {"single", false, 1, false};
+constexpr Mode MODES[] = {
+    {"split", true, 1, false},
+    {"2canvas", false, 2, false},
+    {"split+2canvas", true, 2, false},
+    {"full-redraw", false, 1, true},
+};
+
+struct FrameRecord {
+    uint64_t canvas_hash;
+    uint64_t dirty_hash;
+    uint8_t  bands;
+};
+
+pixel_t s_canvas[2][SCREEN_W * SCREEN_H];
+pixel_t s_afterglow[AFTERGLOW_W * AFTERGLOW_H];
+
+uint64_t fnv1a(uint64_t h, const void* data, std::size_t n)
+{
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (std::size_t i = 0; i < n; i++) {
+        h = (h ^ p[i]) * 0x100000001B3ULL;
+    }
+    return h;
+}
+
+void run_case(const RenderCase& c, const Mode& m, FrameRecord* out)
+{
+    host_timer_set_manual(true);
+    srand(1234);
+
+    std::unique_ptr<HostRenderWorker> worker;
+    if (m.split) {
+        worker = std::make_unique<HostRenderWorker>();
+        const FaceRenderWorker w = worker->handle();
+        face_render_set_worker(&w);
+    }
+    face_render_init(s_afterglow, m.canvases);
+
+    FaceState fs = render_case_begin(c);
+    for (int i = 0; i < FRAMES; i++) {
+        render_case_step(c, fs, i);
+
+        if (m.full_redraw) face_render_init(s_afterglow, m.canvases);
+        pixel_t*           canvas = s_canvas[i % m.canvases];
+        RenderPerfSnapshot perf = {};
+        const DirtyRegion  dirty = face_render_frame(canvas, fs, &perf);
+        out[i].canvas_hash = fnv1a(0xCBF29CE484222325ULL, canvas, sizeof(s_canvas[0]));
+        uint64_t h = fnv1a(0xCBF29CE484222325ULL, &dirty.count, sizeof(dirty.count));
+        h = fnv1a(h, &dirty.full, sizeof(dirty.full));
+        for (uint8_t k = 0; k < dirty.count; k++) {
+            const int r[4] = {dirty.rects[k].x0, dirty.rects[k].y0, dirty.rects[k].x1, dirty.rects[k].y1};
+            h = fnv1a(h, r, sizeof(r));
+        }
+        out[i].dirty_hash = h;
+        out[i].bands = perf.bands;
+        host_timer_advance_us(FRAME_PERIOD_US);
+    }
+}
+
+// Runs one case in a child process and collects its per-frame records.
+bool run_isolated(const RenderCase& c, const Mode& m, std::vector<FrameRecord>& out)
+{
+    int fds[2];
+    if (pipe(fds) != 0) return false;
+    const pid_t pid = fork();
+    if (pid < 0) return false;
+    if (pid == 0) {
+        close(fds[0]);
+        std::vector<FrameRecord> records(FRAMES);
+        run_case(c, m, records.data());
+        const char* p = reinterpret_cast<const char*>(records.data());
+        std::size_t left = records.size() * sizeof(FrameRecord);
+        while (left > 0) {
+            const ssize_t n = write(fds[1], p, left);
+            if (n <= 0) _exit(1);
+            p += n;
+            left -= static_cast<std::size_t>(n);
+        }
+        _exit(0);
+    }
+
+    close(fds[1]);
+    out.assign(FRAMES, FrameRecord{});
+    char*       p = reinterpret_cast<char*>(out.data());
+    std::size_t left = out.size() * sizeof(FrameRecord);
+    while (left > 0) {
+        const ssize_t n = read(fds[0], p, left);
+        if (n <= 0) break;
+        p += n;
+        left -= static_cast<std::size_t>(n);
+    }
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return left == 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+bool region_empty(const DirtyRegion& r)
+{
+    return !r.full && r.count == 0;
+}
+
+bool heart_hold_ok()
+{
+    host_timer_set_manual(true);
+    face_render_init(s_afterglow, 1);
+    conv_border_set_state(static_cast<uint8_t>(FaceConvState::IDLE));
+    conv_border_set_energy(0.0f);
+
+    FaceState fs;
+    fs.anim.idle = false;
+    fs.anim.autoblink = false;
+    fs.fx.sparkle = false;
+    fs.fx.afterglow = false;
+    fs.fx.boot_active = false;
+    fs.solid_eye = true;
+    fs.eye_l.openness = 1.0f;
+    fs.eye_r.openness = 1.0f;
+    face_set_mood(fs, Mood::LOVE);
+    face_set_expression_intensity(fs, 1.0f);
+    fs.anim.heart = true;
+
+    bool ok = true;
+    auto frame = [&](const char* what, bool expect_empty) {
+        const bool empty = region_empty(face_render_frame(s_canvas[0], fs, nullptr));
+        host_timer_advance_us(FRAME_PERIOD_US);
+        if (empty != expect_empty) {
+            std::printf("heart hold: %s %s\n", what, expect_empty ? "pushed pixels" : "pushed nothing");
+            ok = false;
+        }
+    };
+    face_render_frame(s_canvas[0], fs, nullptr); // first frame: full
+    host_timer_advance_us(FRAME_PERIOD_US);
+    frame("settled hold", true);
+    fs.fx.breath_phase += 0.001f; // hearts a few thousandths of a pixel larger
+    frame("sub-pixel heart change", true);
+    for (EyeState* eye : {&fs.eye_l, &fs.eye_r}) {
+        eye->width_scale *= 1.2f;
+        eye->height_scale *= 1.2f;
+    }
+    frame("hearts grown by whole pixels", false);
+    if (ok) std::printf("heart hold     sub-pixel change  nothing pushed\n");
+    return ok;
+}
+
+} // namespace
+
+int main()
+{
+    bool ok = true;
+    int  split_total = 0;
+    for (const RenderCase& c : RENDER_CASES) {
+        std::vector<FrameRecord> ref;
+        if (!run_isolated(c, REFERENCE, ref)) {
+            std::printf("%-12s child run failed\n", c.name);
+            ok = false;
+            continue;
+        }
+
+        for (const Mode& m : MODES) {
+            std::vector<FrameRecord> run;
+            if (!run_isolated(c, m, run)) {
+                std::printf("%-12s %-14s child run failed\n", c.name, m.name);
+                ok = false;
+                continue;
+            }
+
+            int first_diff = -1;
+            int split = 0;
+            for (int i = 0; i < FRAMES; i++) {
+                if (run[i].bands > 1) split++;
+                const bool same = ref[i].canvas_hash == run[i].canvas_hash &&
+                                  (m.full_redraw || ref[i].dirty_hash == run[i].dirty_hash);
+                if (first_diff < 0 && !same) first_diff = i;
+            }
+            split_total += split;
+            if (first_diff >= 0) {
+                std::printf("%-12s %-14s split %3d/%d frames  FAIL: frame %d differs\n", c.name, m.name, split, FRAMES,
+                            first_diff);
+                ok = false;
+            } else {
+                std::printf("%-12s %-14s split %3d/%d frames  identical\n", c.name, m.name, split, FRAMES);
+            }
+        }
+    }
+
+    if (split_total == 0) {
+        std::printf("no frame took the band split\n");
+        ok = false;
+    }
+    if (!heart_hold_ok()) ok = false;
+    return ok ? 0 : 1;
+}
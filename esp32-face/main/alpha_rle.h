@@ -0,0 +1,88 @@
+#pragma once
+// Run-length alpha masks shared by the mouth and heart caches.
+//
+// A mask is a stream of rows, top to bottom:
+//     u8 n_runs, then n_runs x { u8 len, u8 alpha }
+// Trailing transparent runs are dropped, so a row is at most 255 px wide.
+// Blitting composites the runs in one color through the span kernels.
+
+#include "config.h"
+#include "pixel_span.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+constexpr int ALPHA_RLE_MAX_W = 255;
+
+// Splits a mask center v into an integer blit origin and a sub-pixel phase in
+// 1/q_phase px steps. Masks are rasterized once per phase and reused at any
+// integer origin.
+inline void alpha_rle_origin(float v, int q_phase, int& origin, uint8_t& phase)
+{
+    origin = static_cast<int>(floorf(v));
+    int p = static_cast<int>(lroundf((v - static_cast<float>(origin)) * static_cast<float>(q_phase)));
+    if (p >= q_phase) {
+        p -= q_phase;
+        origin++;
+    }
+    phase = static_cast<uint8_t>(p);
+}
+
+// Appends one row of n alphas to dst (capacity cap, fill level used). Returns
+// false and leaves used unchanged if the row does not fit.
+inline bool alpha_rle_encode_row(uint8_t* dst, std::size_t cap, uint16_t& used, const uint8_t* alpha, int n)
+{
+    while (n > 0 && alpha[n - 1] == 0) n--;
+
+    const std::size_t head = used;
+    if (head + 1 > cap) return false;
+    std::size_t pos = head + 1;
+    int         n_runs = 0;
+    for (int i = 0; i < n;) {
+        int len = 1;
+        while (i + len < n && len < 255 && alpha[i + len] == alpha[i]) len++;
+        if (pos + 2 > cap) return false;
+        dst[pos++] = static_cast<uint8_t>(len);
+        dst[pos++] = alpha[i];
+        n_runs++;
+        i += len;
+    }
+    dst[head] = static_cast<uint8_t>(n_runs);
+    used = static_cast<uint16_t>(pos);
+    return true;
+}
+
+// Composites a rows-tall mask with its top-left pixel at (x, y), clipped to
+// the SCREEN_W x SCREEN_H buffer.
+inline void alpha_rle_blit(pixel_t* buf, const uint8_t* mask, int rows, int x, int y, uint8_t r, uint8_t g, uint8_t b)
+{
+    for (int i = 0; i < rows; i++, y++) {
+        const int n_runs = *mask++;
+        if (y >= 0 && y < SCREEN_H) {
+            pixel_t* row = buf + y * SCREEN_W;
+            int      rx = x;
+            for (int k = 0; k < n_runs; k++) {
+                const int     len = mask[2 * k];
+                const uint8_t a = mask[2 * k + 1];
+                const int     x0 = rx < 0 ? 0 : rx;
+                const int     x1 = (rx + len) > SCREEN_W ? SCREEN_W : rx + len;
+                rx += len;
+                if (a == 0 || x1 <= x0) continue;
+                px_span_blend(row + x0, x1 - x0, r, g, b, a);
+            }
+        }
+        mask += 2 * n_runs;
+    }
+}
+
+// Composites one row of n alphas starting at (x, y), clipped to the screen.
+inline void alpha_row_blit(pixel_t* buf, const uint8_t* alpha, int n, int x, int y, uint8_t r, uint8_t g, uint8_t b)
+{
+    if (y < 0 || y >= SCREEN_H) return;
+    const int k0 = x < 0 ? -x : 0;
+    const int k1 = (x + n) > SCREEN_W ? SCREEN_W - x : n;
+    if (k1 > k0) {
+        px_span_blend_mask(buf + y * SCREEN_W + x + k0, alpha + k0, k1 - k0, r, g, b);
+    }
+}
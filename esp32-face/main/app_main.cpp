@@ -1,3 +1,4 @@
+#include "config.h"
 #include "display.h"
 #include "touch.h"
 #include "led.h"
@@ -5,6 +6,7 @@
 #include "usb_rx.h"
 #include "telemetry.h"
 #include "face_ui.h"
+#include "panel_present.h"
 
 #include "esp_lvgl_port.h"
 #include "esp_log.h"
@@ -18,10 +20,14 @@ static constexpr BaseType_t CORE_IO = 1;
 static constexpr UBaseType_t PRIO_FACE_UI = 5;
 static constexpr UBaseType_t PRIO_USB_RX = 7;
 static constexpr UBaseType_t PRIO_TELEM = 6;
+static constexpr UBaseType_t PRIO_RENDER_WORKER = 5;
+static constexpr UBaseType_t PRIO_PRESENT = 6;
 
 static constexpr uint32_t STACK_FACE_UI = 8192;
 static constexpr uint32_t STACK_USB_RX = 4096;
 static constexpr uint32_t STACK_TELEM = 4096;
+static constexpr uint32_t STACK_RENDER_WORKER = 6144;
+static constexpr uint32_t STACK_PRESENT = 3072;
 
 static bool start_task(TaskFunction_t fn, const char* name, uint32_t stack_bytes, UBaseType_t priority, BaseType_t core)
 {
@@ -41,6 +47,10 @@ extern "C" void app_main(void)
     // 1. Display (SPI + ILI9341 + LVGL)
     lv_display_t* disp = display_init();
 
+    // 1b. Direct canvas presentation (falls back to LVGL if this fails)
+    const bool direct_present =
+        FACE_DIRECT_PRESENT && !FACE_CALIBRATION_MODE && panel_present_init(display_panel());
+
     // 2. Touch (I2C + FT6336 + LVGL input)
     touch_init(disp);
 
@@ -58,9 +68,16 @@ extern "C" void app_main(void)
     }
 
     // 6. Start FreeRTOS tasks.
-    // Keep USB I/O isolated on core 1 and render/UI on core 0.
+    // Keep USB I/O on core 1 and render/UI on core 0. The render worker
+    // borrows core 1's idle time for the face's top band; USB I/O outranks it.
+    // The present task mostly waits on SPI DMA; it preempts the band worker
+    // only to stage the next strip.
     const bool started = start_task(usb_rx_task, "usb_rx", STACK_USB_RX, PRIO_USB_RX, CORE_IO) &&
                          start_task(telemetry_task, "telem", STACK_TELEM, PRIO_TELEM, CORE_IO) &&
+                         (!direct_present ||
+                          start_task(panel_present_task, "face_present", STACK_PRESENT, PRIO_PRESENT, CORE_IO)) &&
+                         (!FACE_RENDER_WORKER || start_task(face_render_worker_task, "face_band",
+                                                            STACK_RENDER_WORKER, PRIO_RENDER_WORKER, CORE_IO)) &&
                          start_task(face_ui_task, "face_ui", STACK_FACE_UI, PRIO_FACE_UI, CORE_UI);
 
     if (!started) {
@@ -34,6 +34,7 @@ constexpr float HEART_PUPIL_SCALE = 2.5f; // sim parity: pupil heart scale facto
 
 // ---- Timing ----
 constexpr int   ANIM_FPS = 30;          // TFT refresh, 30 FPS is sufficient
+constexpr float ANIM_DT_MAX_S = 0.1f;   // longest frame the animation clock advances by
 constexpr float BLINK_INTERVAL = 2.0f;  // base seconds between blinks
 constexpr float BLINK_VARIATION = 3.0f; // random extra seconds
 constexpr float IDLE_INTERVAL = 1.5f;
@@ -53,16 +54,43 @@ constexpr uint8_t UI_ICON_PRESSED_OPA = 217; // ~85%
 
 // ---- System overlay FX toggles ----
 // Performance fallback order (disable first -> last): GLITCH, VIGNETTE, SCANLINES.
+// The quality governor sheds them at runtime in that order, after sparkle,
+// afterglow and edge glow (quality_governor.h).
 constexpr bool SYSTEM_FX_SCANLINES = true;
 constexpr bool SYSTEM_FX_VIGNETTE = true;
 constexpr bool SYSTEM_FX_GLITCH = true;
+// System modes show the face acting them out with small icons (system_face);
+// true draws the full-screen system_overlay_v2 screens instead.
+constexpr bool FACE_SYSTEM_OVERLAY_V2 = false;
+
+// ---- Frame pacing and quality governor ----
+constexpr uint32_t FACE_FRAME_BUDGET_US = 1'000'000 / ANIM_FPS; // frame deadline period
+constexpr bool     FACE_QUALITY_GOVERNOR = true;               // shed effects while p95 frame time is over budget
+constexpr uint8_t  FACE_QUALITY_WINDOW_FRAMES = 30;            // frames per p95 decision
+constexpr uint8_t  FACE_QUALITY_RESTORE_PCT = 75;              // restore one effect when p95 <= this % of budget
+constexpr uint8_t  FACE_QUALITY_RESTORE_WINDOWS = 3;           // ... for this many windows in a row
 
 // ---- Runtime diagnostics ----
 constexpr uint32_t FRAME_TIME_LOG_INTERVAL_MS = 5000;
 constexpr bool     FACE_PERF_TELEMETRY = true;
 constexpr uint8_t  FACE_PERF_SAMPLE_DIV = 8;
 constexpr bool     FACE_DIRTY_RECT = true;
+constexpr uint8_t  FACE_DIRTY_MAX_RECTS = 16;     // DirtyRegion capacity
+constexpr uint16_t FACE_DIRTY_RECT_COST_PX = 100; // per-rect push setup in pixels (host/dirty_bench)
+constexpr uint8_t  FACE_PARTICLE_TILE_PX = 16;     // sparkle/fire dirty tile edge
+constexpr bool     FACE_RENDER_WORKER = true; // eyes band on a second core (face_render_set_worker)
 constexpr uint8_t  FACE_AFTERGLOW_DOWNSAMPLE = 2;
+constexpr uint8_t  FACE_CANVAS_BUFFERS = 2; // back canvas renders while the front is presented
+constexpr bool     FACE_DIRECT_PRESENT = true; // canvas -> esp_lcd DMA, LVGL only for calibration (panel_present.cpp)
+constexpr int      FACE_PRESENT_STRIP_PX = SCREEN_W * 16; // per DMA staging strip (two, internal RAM)
+
+// ---- Render caches ----
+constexpr std::size_t FACE_MOUTH_CACHE_SLOTS = 16;        // LRU mouth masks (mouth_cache.cpp)
+constexpr std::size_t FACE_MOUTH_CACHE_SLOT_BYTES = 2048; // RLE bytes per mask (largest talking shape ~1.6 KB)
+constexpr float       FACE_MOUTH_TALK_SNAP_PX = 4.0f;     // open / half-width grid while talking
+constexpr std::size_t FACE_HEART_SPRITE_SLOTS = 12;       // LRU heart sprites (heart_sprite.cpp)
+constexpr std::size_t FACE_HEART_SPRITE_SLOT_BYTES = 1024; // RLE bytes per sprite
+constexpr float       FACE_HEART_SPRITE_SIZE_STEP = 0.5f;  // size bucket (px)
 
 // ---- Telemetry ----
 constexpr int TELEMETRY_HZ = 20;
@@ -71,3 +99,14 @@ constexpr int TELEMETRY_HZ = 20;
 constexpr bool        FACE_CALIBRATION_MODE = false;
 constexpr uint32_t    CALIB_TOUCH_AUTOCYCLE_MS = 0;
 constexpr std::size_t CALIB_TOUCH_DEFAULT_INDEX = 3;
+
+// ---- Canvas pixel order (pixel.h) ----
+// Byte-swapped RGB565 is the panel's native order: the canvas goes out as-is
+// and LVGL's flush swap is off (display.cpp). Calibration mode draws LVGL
+// labels, which need that swap, so it keeps CPU order. Host builds compile
+// both orders via FACE_PIXEL_SWAPPED_OVERRIDE.
+#ifdef FACE_PIXEL_SWAPPED_OVERRIDE
+constexpr bool FACE_PIXEL_SWAPPED = FACE_PIXEL_SWAPPED_OVERRIDE;
+#else
+constexpr bool FACE_PIXEL_SWAPPED = !FACE_CALIBRATION_MODE;
+#endif
@@ -1,5 +1,6 @@
 #include "conv_border.h"
 #include "config.h"
+#include "pixel_span.h"
 #include "protocol.h"
 
 #include <cmath>
@@ -31,7 +32,7 @@ static constexpr float PTT_ALPHA_BASE = 0.8f;
 static constexpr float PTT_ALPHA_MOD = 0.1f;
 
 // THINKING animation
-static constexpr int   THINKING_ORBIT_DOTS = 3;
+static constexpr int   THINKING_ORBIT_DOTS = CONV_BORDER_DOTS;
 static constexpr float THINKING_ORBIT_SPACING = 0.12f;
 static constexpr float THINKING_ORBIT_SPEED = 0.5f;
 static constexpr float THINKING_ORBIT_DOT_R = 4.0f;
@@ -82,6 +83,9 @@ static constexpr Color3 CONV_COLORS[] = {
     {0, 0, 0},       // DONE
 };
 
+// Face background (face_render.cpp BG_*), which the cached ring is composited over
+static constexpr uint8_t RING_BG_R = 0, RING_BG_G = 0, RING_BG_B = 0;
+
 // SDF geometry (precomputed)
 static constexpr float INNER_HW = SCREEN_W / 2.0f - BORDER_FRAME_W;
 static constexpr float INNER_HH = SCREEN_H / 2.0f - BORDER_FRAME_W;
@@ -117,7 +121,7 @@ static ButtonZone s_btn_right = {BtnIcon::X_MARK, BtnState::IDLE, 0, 0, 0, 0.0f}
 
 // Cached render masks (built once at startup to remove per-frame SDF/trig work)
 static constexpr int         BORDER_DEPTH = BORDER_FRAME_W + BORDER_GLOW_W;
-static constexpr std::size_t MAX_FRAME_CACHE =
+static constexpr std::size_t RING_PIXELS =
     static_cast<std::size_t>(2 * BORDER_DEPTH * (SCREEN_W + SCREEN_H - 2 * BORDER_DEPTH));
 static constexpr std::size_t BTN_ZONE_PIXELS = static_cast<std::size_t>(BTN_CORNER_W * BTN_CORNER_H);
 static constexpr std::size_t MAX_MIC_BODY_PIXELS = 512;
@@ -125,11 +129,6 @@ static constexpr std::size_t MAX_MIC_BASE_PIXELS = 256;
 static constexpr std::size_t MAX_MIC_ARC_PIXELS = 512;
 static constexpr std::size_t MAX_X_ICON_PIXELS = 512;
 
-struct __attribute__((packed)) FrameMaskPixel {
-    uint32_t idx;
-    uint8_t  alpha_u8;
-};
-
 struct __attribute__((packed)) ZoneMaskPixel {
     uint8_t x;
     uint8_t y;
@@ -142,11 +141,20 @@ struct __attribute__((packed)) IconMaskPixel {
     uint8_t alpha_u8;
 };
 
-static bool  s_cache_ready = false;
-static float s_alpha_lut[256] = {};
+static bool s_cache_ready = false;
 
-static FrameMaskPixel s_frame_mask[MAX_FRAME_CACHE];
-static std::size_t    s_frame_mask_count = 0;
+// Perimeter ring: the BORDER_DEPTH-wide band the frame and its glow can touch,
+// stored densely as the top rows, the bottom rows, then a left/right pair of
+// BORDER_DEPTH-wide spans per middle row (see for_each_ring_span). s_ring_mask
+// is the frame shape; s_ring_px and s_ring_alpha are that shape composited in
+// the current glow color and alpha, rebuilt only when those change.
+static uint8_t  s_ring_mask[RING_PIXELS];
+static pixel_t  s_ring_px[RING_PIXELS];    // glow over RING_BG, i.e. premultiplied
+static uint8_t  s_ring_alpha[RING_PIXELS]; // mask scaled by the frame alpha
+static bool     s_ring_valid = false;
+static uint32_t s_ring_key = 0; // r, g, b, alpha the ring was composited with
+
+static ConvBorderStats s_stats;
 
 static ZoneMaskPixel s_zone_bg_mask[BTN_ZONE_PIXELS];
 static std::size_t   s_zone_bg_mask_count = 0;
@@ -163,6 +171,19 @@ static std::size_t   s_mic_arc_mask_count[3] = {0, 0, 0};
 static IconMaskPixel s_x_icon_mask[MAX_X_ICON_PIXELS];
 static std::size_t   s_x_icon_mask_count = 0;
 
+// Distance of each row / column to the nearest screen edge (ATTENTION sweep).
+static uint8_t s_row_dist[SCREEN_H];
+static uint8_t s_col_dist[SCREEN_W];
+
+// THINKING orbit dot coverage, baked at DOT_PHASES x DOT_PHASES sub-pixel
+// offsets of the dot center. Sprite (0, 0) is DOT_HALF px up-left of the
+// pixel holding the center.
+static constexpr int DOT_PHASES = 4;
+static constexpr int DOT_HALF = 4;
+static constexpr int DOT_SPRITE = 2 * DOT_HALF + 1;
+static_assert(DOT_HALF >= THINKING_ORBIT_DOT_R, "dot sprite must hold the whole dot");
+static uint8_t s_dot_sprite[DOT_PHASES * DOT_PHASES][DOT_SPRITE * DOT_SPRITE];
+
 // ══════════════════════════════════════════════════════════════════════
 // Helpers
 // ══════════════════════════════════════════════════════════════════════
@@ -251,12 +272,6 @@ static uint8_t scale_alpha_u8(uint8_t base, uint8_t scale)
     return static_cast<uint8_t>((static_cast<uint16_t>(base) * static_cast<uint16_t>(scale) + 127U) / 255U);
 }
 
-static void push_frame_mask(uint32_t idx, uint8_t alpha_u8)
-{
-    if (alpha_u8 == 0 || s_frame_mask_count >= MAX_FRAME_CACHE) return;
-    s_frame_mask[s_frame_mask_count++] = {idx, alpha_u8};
-}
-
 static void push_zone_mask(ZoneMaskPixel* dst, std::size_t& count, std::size_t max_count, uint8_t x, uint8_t y,
                            uint8_t alpha_u8)
 {
@@ -272,23 +287,31 @@ static void push_icon_mask(IconMaskPixel* dst, std::size_t& count, std::size_t m
     dst[count++] = {static_cast<int8_t>(dx), static_cast<int8_t>(dy), alpha_u8};
 }
 
-static void init_alpha_lut()
+// Calls fn(y, x, ring_idx, n) for each row span of the perimeter ring, in ring
+// order.
+template <typename Fn>
+static void for_each_ring_span(Fn&& fn)
 {
-    for (int i = 0; i < 256; i++) {
-        s_alpha_lut[i] = static_cast<float>(i) / 255.0f;
+    std::size_t ring = 0;
+    for (int y = 0; y < BORDER_DEPTH; y++, ring += SCREEN_W) {
+        fn(y, 0, ring, SCREEN_W);
+    }
+    for (int y = SCREEN_H - BORDER_DEPTH; y < SCREEN_H; y++, ring += SCREEN_W) {
+        fn(y, 0, ring, SCREEN_W);
+    }
+    for (int y = BORDER_DEPTH; y < SCREEN_H - BORDER_DEPTH; y++) {
+        fn(y, 0, ring, BORDER_DEPTH);
+        ring += BORDER_DEPTH;
+        fn(y, SCREEN_W - BORDER_DEPTH, ring, BORDER_DEPTH);
+        ring += BORDER_DEPTH;
     }
 }
 
-static void init_frame_mask()
+static void init_ring_mask()
 {
-    s_frame_mask_count = 0;
-    for (int y = 0; y < SCREEN_H; y++) {
-        for (int x = 0; x < SCREEN_W; x++) {
-            if (y >= BORDER_DEPTH && y < (SCREEN_H - BORDER_DEPTH) && x >= BORDER_DEPTH &&
-                x < (SCREEN_W - BORDER_DEPTH)) {
-                continue;
-            }
-            const float d = inner_sdf(static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f);
+    for_each_ring_span([](int y, int x0, std::size_t ring, int n) {
+        for (int i = 0; i < n; i++) {
+            const float d = inner_sdf(static_cast<float>(x0 + i) + 0.5f, static_cast<float>(y) + 0.5f);
             float       a = 0.0f;
             if (d > 0.0f) {
                 a = 1.0f;
@@ -296,9 +319,10 @@ static void init_frame_mask()
                 const float t = (d + BORDER_GLOW_W) / static_cast<float>(BORDER_GLOW_W);
                 a = t * t;
             }
-            push_frame_mask(static_cast<uint32_t>(y * SCREEN_W + x), alpha_to_u8(a));
+            s_ring_mask[ring + i] = alpha_to_u8(a);
         }
-    }
+    });
+    s_ring_valid = false;
 }
 
 static void init_zone_masks()
@@ -445,11 +469,48 @@ static void init_icon_masks()
     }
 }
 
+static void init_edge_dist()
+{
+    for (int y = 0; y < SCREEN_H; y++) {
+        s_row_dist[y] = static_cast<uint8_t>((y < SCREEN_H - 1 - y) ? y : (SCREEN_H - 1 - y));
+    }
+    for (int x = 0; x < SCREEN_W; x++) {
+        s_col_dist[x] = static_cast<uint8_t>((x < SCREEN_W - 1 - x) ? x : (SCREEN_W - 1 - x));
+    }
+}
+
+static void init_dot_sprites()
+{
+    const float r = THINKING_ORBIT_DOT_R;
+    for (int py = 0; py < DOT_PHASES; py++) {
+        for (int px = 0; px < DOT_PHASES; px++) {
+            const float fx = static_cast<float>(px) / DOT_PHASES;
+            const float fy = static_cast<float>(py) / DOT_PHASES;
+            uint8_t*    sprite = s_dot_sprite[py * DOT_PHASES + px];
+            for (int y = 0; y < DOT_SPRITE; y++) {
+                for (int x = 0; x < DOT_SPRITE; x++) {
+                    const float ddx = static_cast<float>(x - DOT_HALF) + 0.5f - fx;
+                    const float ddy = static_cast<float>(y - DOT_HALF) + 0.5f - fy;
+                    const float d = sqrtf(ddx * ddx + ddy * ddy);
+                    uint8_t     a = 0;
+                    if (d < r) {
+                        const float ratio = d / r;
+                        const float af = fminf(1.0f, (1.0f - ratio * ratio) * 2.5f);
+                        if (af > 0.01f) a = px_alpha_u8(af);
+                    }
+                    sprite[y * DOT_SPRITE + x] = a;
+                }
+            }
+        }
+    }
+}
+
 static void ensure_render_cache()
 {
     if (s_cache_ready) return;
-    init_alpha_lut();
-    init_frame_mask();
+    init_edge_dist();
+    init_dot_sprites();
+    init_ring_mask();
     init_zone_masks();
     init_icon_masks();
     s_cache_ready = true;
@@ -458,17 +519,114 @@ static void ensure_render_cache()
 static void blend_idx_u8(pixel_t* buf, uint32_t idx, uint8_t r, uint8_t g, uint8_t b, uint8_t alpha_u8)
 {
     if (alpha_u8 == 0) return;
-    buf[idx] = px_blend(buf[idx], r, g, b, s_alpha_lut[alpha_u8]);
+    buf[idx] = px_blend_u8(buf[idx], r, g, b, alpha_u8);
 }
 
-static void blend_frame_mask(pixel_t* buf, uint8_t r, uint8_t g, uint8_t b, uint8_t scale_u8)
+// Re-composites the ring for a new glow color / alpha. The key is the same
+// 8-bit color and alpha the blend uses, so a reused ring is exact; steady
+// states (THINKING, a settled fade) rebuild once and then only copy.
+static void update_ring(uint8_t r, uint8_t g, uint8_t b, uint8_t scale_u8)
 {
-    if (scale_u8 == 0) return;
-    for (std::size_t i = 0; i < s_frame_mask_count; i++) {
-        const auto&   p = s_frame_mask[i];
-        const uint8_t a = scale_alpha_u8(p.alpha_u8, scale_u8);
-        blend_idx_u8(buf, p.idx, r, g, b, a);
+    const uint32_t key = (static_cast<uint32_t>(r) << 24) | (static_cast<uint32_t>(g) << 16) |
+                         (static_cast<uint32_t>(b) << 8) | scale_u8;
+    if (s_ring_valid && key == s_ring_key) return;
+
+    const pixel_t bg = px_rgb(RING_BG_R, RING_BG_G, RING_BG_B);
+    for (std::size_t i = 0; i < RING_PIXELS; i++) {
+        const uint8_t a = scale_alpha_u8(s_ring_mask[i], scale_u8);
+        s_ring_alpha[i] = a;
+        s_ring_px[i] = px_blend_u8(bg, r, g, b, a);
     }
+    s_ring_key = key;
+    s_ring_valid = true;
+    s_stats.ring_builds++;
+}
+
+static bool span_is(const pixel_t* p, int n, pixel_t v)
+{
+    pixel_t diff = 0;
+    for (int i = 0; i < n; i++) {
+        diff |= static_cast<pixel_t>(p[i] ^ v);
+    }
+    return diff == 0;
+}
+
+// The parts of one canvas row inside a redraw region, for drawing the band
+// only where the renderer restored it. Rebuilt when the row changes.
+struct RowClip {
+    const DirtyRegion* redraw;
+    int                y = -1;
+    int                count = 0;
+    int                x0[DirtyRegion::MAX_RECTS] = {};
+    int                x1[DirtyRegion::MAX_RECTS] = {}; // exclusive
+};
+
+// Calls fn(a, b) for each part [a, b) of [x0, x1) on row y inside the region,
+// left to right and disjoint.
+template <typename Fn>
+static void clip_span(RowClip& clip, int y, int x0, int x1, Fn&& fn)
+{
+    if (clip.redraw->full) {
+        fn(x0, x1);
+        return;
+    }
+    if (clip.y != y) {
+        clip.y = y;
+        clip.count = 0;
+        for (uint8_t i = 0; i < clip.redraw->count; i++) {
+            const RectI& r = clip.redraw->rects[i];
+            if (!r.valid || y < r.y0 || y > r.y1) continue;
+            // Insert sorted by x0, then merge overlaps below.
+            int k = clip.count++;
+            for (; k > 0 && clip.x0[k - 1] > r.x0; k--) {
+                clip.x0[k] = clip.x0[k - 1];
+                clip.x1[k] = clip.x1[k - 1];
+            }
+            clip.x0[k] = r.x0;
+            clip.x1[k] = r.x1 + 1;
+        }
+        int merged = 0;
+        for (int k = 0; k < clip.count; k++) {
+            if (merged > 0 && clip.x0[k] <= clip.x1[merged - 1]) {
+                if (clip.x1[k] > clip.x1[merged - 1]) clip.x1[merged - 1] = clip.x1[k];
+                continue;
+            }
+            clip.x0[merged] = clip.x0[k];
+            clip.x1[merged] = clip.x1[k];
+            merged++;
+        }
+        clip.count = merged;
+    }
+    for (int k = 0; k < clip.count; k++) {
+        const int a = clip.x0[k] > x0 ? clip.x0[k] : x0;
+        const int b = clip.x1[k] < x1 ? clip.x1[k] : x1;
+        if (a < b) fn(a, b);
+    }
+}
+
+// Spans still at the background take the pre-composited ring as a plain copy;
+// anything drawn under the ring (sparkles, fire, afterglow) is blended per pixel.
+static void blend_ring(pixel_t* buf, const DirtyRegion& redraw, uint8_t r, uint8_t g, uint8_t b, uint8_t scale_u8)
+{
+    if (scale_u8 == 0) return;
+    update_ring(r, g, b, scale_u8);
+
+    const pixel_t bg = px_rgb(RING_BG_R, RING_BG_G, RING_BG_B);
+    RowClip       clip = {&redraw};
+    for_each_ring_span([&](int y, int x, std::size_t ring, int n) {
+        clip_span(clip, y, x, x + n, [&](int a, int e) {
+            pixel_t*          dst = buf + y * SCREEN_W + a;
+            const int         len = e - a;
+            const std::size_t src = ring + static_cast<std::size_t>(a - x);
+            if (span_is(dst, len, bg)) {
+                std::memcpy(dst, s_ring_px + src, static_cast<std::size_t>(len) * sizeof(pixel_t));
+                s_stats.ring_copy_px += static_cast<uint32_t>(len);
+            } else {
+                px_span_blend_mask(dst, s_ring_alpha + src, len, r, g, b);
+                s_stats.ring_blend_px += static_cast<uint32_t>(len);
+            }
+        });
+    });
 }
 
 static void blend_zone_mask(pixel_t* buf, const ZoneMaskPixel* mask, std::size_t count, bool is_left, uint8_t r,
@@ -660,66 +818,89 @@ bool conv_border_active()
     return s_border.alpha > 0.01f;
 }
 
+void conv_border_get_glow(uint8_t& r, uint8_t& g, uint8_t& b, uint8_t& alpha)
+{
+    r = static_cast<uint8_t>(s_border.color_r);
+    g = static_cast<uint8_t>(s_border.color_g);
+    b = static_cast<uint8_t>(s_border.color_b);
+    alpha = alpha_to_u8(s_border.alpha);
+}
+
+ConvBorderStats conv_border_stats()
+{
+    return s_stats;
+}
+
 // ══════════════════════════════════════════════════════════════════════
 // Border rendering
 // ══════════════════════════════════════════════════════════════════════
 
-static void render_attention(pixel_t* buf)
+// The sweep covers every pixel whose distance to the nearest screen edge,
+// min(s_col_dist[x], s_row_dist[y]), is below the sweep depth. Distances are
+// whole pixels, so the falloff is one alpha per distance, computed per frame.
+// Only the top and bottom bands and the left and right strips are visited; a
+// band row's interior is all at the row's distance and takes the span kernel.
+static void render_attention(pixel_t* buf, const DirtyRegion& redraw)
 {
     const float progress = s_border.timer / ATTENTION_DURATION;
     const float sweep = static_cast<float>(ATTENTION_DEPTH) * progress;
     const float fade_global = 1.0f - progress * 0.5f;
-    const int   limit = static_cast<int>(sweep) + 1;
     const auto& col = CONV_COLORS[static_cast<uint8_t>(FaceConvState::ATTENTION)];
 
-    for (int y = 0; y < SCREEN_H; y++) {
-        const int dv = (y < SCREEN_H - 1 - y) ? y : (SCREEN_H - 1 - y);
-        const int row = y * SCREEN_W;
-        if (dv > limit) {
-            // Only left/right edges
-            for (int x = 0; x < limit && x < SCREEN_W; x++) {
-                const float dist = static_cast<float>(x);
-                if (dist < sweep) {
-                    const float f = (1.0f - dist / fmaxf(1.0f, sweep)) * fade_global;
-                    const float a = f * f;
-                    if (a > 0.01f) {
-                        buf[row + x] = px_blend(buf[row + x], col.r, col.g, col.b, a);
-                    }
-                }
-            }
-            for (int x = SCREEN_W - limit; x < SCREEN_W; x++) {
-                if (x < 0) continue;
-                const float dist = static_cast<float>(SCREEN_W - 1 - x);
-                if (dist < sweep) {
-                    const float f = (1.0f - dist / fmaxf(1.0f, sweep)) * fade_global;
-                    const float a = f * f;
-                    if (a > 0.01f) {
-                        buf[row + x] = px_blend(buf[row + x], col.r, col.g, col.b, a);
-                    }
-                }
-            }
-        } else {
-            // Full row
-            for (int x = 0; x < SCREEN_W; x++) {
-                const int   dh = (x < SCREEN_W - 1 - x) ? x : (SCREEN_W - 1 - x);
-                const float dist = static_cast<float>((dh < dv) ? dh : dv);
-                if (dist < sweep) {
-                    const float f = (1.0f - dist / fmaxf(1.0f, sweep)) * fade_global;
-                    const float a = f * f;
-                    if (a > 0.01f) {
-                        buf[row + x] = px_blend(buf[row + x], col.r, col.g, col.b, a);
-                    }
-                }
+    uint8_t falloff[ATTENTION_DEPTH + 1];
+    int     depth = 0;
+    while (depth <= ATTENTION_DEPTH && static_cast<float>(depth) < sweep) {
+        const float f = (1.0f - static_cast<float>(depth) / fmaxf(1.0f, sweep)) * fade_global;
+        const float a = f * f;
+        falloff[depth] = (a > 0.01f) ? px_alpha_u8(a) : 0;
+        depth++;
+    }
+    if (depth == 0) return;
+
+    RowClip clip = {&redraw};
+
+    // Left and right strips of row y; band rows cap the distance at their own.
+    auto blend_edges = [&](int y, int cap) {
+        pixel_t* row = buf + y * SCREEN_W;
+        auto     blend = [&](int a, int e) {
+            for (int x = a; x < e; x++) {
+                const uint8_t alpha = falloff[s_col_dist[x] < cap ? s_col_dist[x] : cap];
+                if (alpha != 0) row[x] = px_blend_u8(row[x], col.r, col.g, col.b, alpha);
             }
-        }
+        };
+        clip_span(clip, y, 0, depth, blend);
+        clip_span(clip, y, SCREEN_W - depth, SCREEN_W, blend);
+    };
+    auto blend_band_row = [&](int y) {
+        const int dv = s_row_dist[y];
+        blend_edges(y, dv);
+        clip_span(clip, y, depth, SCREEN_W - depth, [&](int a, int e) {
+            px_span_blend(buf + y * SCREEN_W + a, e - a, col.r, col.g, col.b, falloff[dv]);
+        });
+    };
+
+    for (int y = 0; y < depth; y++) {
+        blend_band_row(y);
+    }
+    for (int y = depth; y < SCREEN_H - depth; y++) {
+        blend_edges(y, depth);
+    }
+    for (int y = SCREEN_H - depth; y < SCREEN_H; y++) {
+        blend_band_row(y);
     }
 }
 
-static void render_dots(pixel_t* buf)
+// Where each orbit dot goes this frame: sprite top-left, phase and color.
+struct DotPlace {
+    int     x, y;
+    uint8_t phase;
+    uint8_t r, g, b;
+};
+
+static void place_dots(DotPlace (&out)[THINKING_ORBIT_DOTS])
 {
     static constexpr float brightnesses[] = {1.0f, 0.7f, 0.4f};
     const auto&            dot_col = CONV_COLORS[static_cast<uint8_t>(FaceConvState::THINKING)];
-    const float            r = THINKING_ORBIT_DOT_R;
 
     for (int i = 0; i < THINKING_ORBIT_DOTS; i++) {
         float pos = fmodf(s_border.orbit_pos - static_cast<float>(i) * THINKING_ORBIT_SPACING, 1.0f);
@@ -728,58 +909,129 @@ static void render_dots(pixel_t* buf)
         float dx, dy;
         perimeter_xy(pos, dx, dy);
 
-        const float   bri = brightnesses[i];
-        const uint8_t cr = static_cast<uint8_t>(clampf(static_cast<float>(dot_col.r) * bri, 0.0f, 255.0f));
-        const uint8_t cg = static_cast<uint8_t>(clampf(static_cast<float>(dot_col.g) * bri, 0.0f, 255.0f));
-        const uint8_t cb = static_cast<uint8_t>(clampf(static_cast<float>(dot_col.b) * bri, 0.0f, 255.0f));
-
-        const int x0 = static_cast<int>(fmaxf(0.0f, dx - r - 1.0f));
-        const int x1 = static_cast<int>(fminf(static_cast<float>(SCREEN_W), dx + r + 2.0f));
-        const int y0 = static_cast<int>(fmaxf(0.0f, dy - r - 1.0f));
-        const int y1 = static_cast<int>(fminf(static_cast<float>(SCREEN_H), dy + r + 2.0f));
-
-        for (int y = y0; y < y1; y++) {
-            const int row = y * SCREEN_W;
-            for (int x = x0; x < x1; x++) {
-                const float ddx = static_cast<float>(x) + 0.5f - dx;
-                const float ddy = static_cast<float>(y) + 0.5f - dy;
-                const float d = sqrtf(ddx * ddx + ddy * ddy);
-                if (d < r) {
-                    const float ratio = d / r;
-                    float       a = fminf(1.0f, (1.0f - ratio * ratio) * 2.5f);
-                    if (a > 0.01f) {
-                        buf[row + x] = px_blend(buf[row + x], cr, cg, cb, a);
-                    }
-                }
-            }
+        // Center in 1/DOT_PHASES px: whole pixel plus sprite phase.
+        const int qx = static_cast<int>(lrintf(dx * DOT_PHASES));
+        const int qy = static_cast<int>(lrintf(dy * DOT_PHASES));
+
+        const float bri = brightnesses[i];
+        DotPlace&   d = out[i];
+        d.x = qx / DOT_PHASES - DOT_HALF;
+        d.y = qy / DOT_PHASES - DOT_HALF;
+        d.phase = static_cast<uint8_t>((qy % DOT_PHASES) * DOT_PHASES + (qx % DOT_PHASES));
+        d.r = static_cast<uint8_t>(clampf(static_cast<float>(dot_col.r) * bri, 0.0f, 255.0f));
+        d.g = static_cast<uint8_t>(clampf(static_cast<float>(dot_col.g) * bri, 0.0f, 255.0f));
+        d.b = static_cast<uint8_t>(clampf(static_cast<float>(dot_col.b) * bri, 0.0f, 255.0f));
+    }
+}
+
+static RectI dot_rect(const DotPlace& d)
+{
+    RectI r;
+    r.x0 = d.x < 0 ? 0 : d.x;
+    r.y0 = d.y < 0 ? 0 : d.y;
+    r.x1 = d.x + DOT_SPRITE - 1 < SCREEN_W ? d.x + DOT_SPRITE - 1 : SCREEN_W - 1;
+    r.y1 = d.y + DOT_SPRITE - 1 < SCREEN_H ? d.y + DOT_SPRITE - 1 : SCREEN_H - 1;
+    r.valid = r.x0 <= r.x1 && r.y0 <= r.y1;
+    return r;
+}
+
+static void render_dots(pixel_t* buf)
+{
+    DotPlace dots[THINKING_ORBIT_DOTS];
+    place_dots(dots);
+    for (const DotPlace& d : dots) {
+        const RectI r = dot_rect(d);
+        if (!r.valid) continue;
+        const uint8_t* sprite = s_dot_sprite[d.phase];
+        for (int y = r.y0; y <= r.y1; y++) {
+            const uint8_t* mask = sprite + (y - d.y) * DOT_SPRITE + (r.x0 - d.x);
+            px_span_blend_mask(buf + y * SCREEN_W + r.x0, mask, r.x1 - r.x0 + 1, d.r, d.g, d.b);
         }
     }
 }
 
-void conv_border_render(pixel_t* buf)
+// What conv_border_render() draws for the current state.
+enum class BorderDraw : uint8_t {
+    NONE,
+    SWEEP, // ATTENTION sweep
+    RING,  // frame glow, plus the orbit dots in THINKING
+};
+
+static BorderDraw border_draw()
 {
-    ensure_render_cache();
     const auto s = static_cast<FaceConvState>(s_border.state);
+    if (s == FaceConvState::ATTENTION && s_border.timer < ATTENTION_DURATION) return BorderDraw::SWEEP;
+    if (s_border.alpha < 0.01f && s != FaceConvState::ATTENTION) return BorderDraw::NONE;
+    return BorderDraw::RING;
+}
 
-    if (s_border.alpha < 0.01f && s != FaceConvState::ATTENTION) {
-        return;
+static bool dots_visible()
+{
+    return s_border.state == static_cast<uint8_t>(FaceConvState::THINKING) && s_border.alpha > 0.01f;
+}
+
+static uint64_t zone_key(const ButtonZone& btn);
+static RectI    zone_rect(bool is_left);
+
+ConvBorderFootprint conv_border_footprint()
+{
+    ConvBorderFootprint fp;
+    const ButtonZone*   zones[2] = {&s_btn_left, &s_btn_right};
+    for (int i = 0; i < 2; i++) {
+        if (zones[i]->icon == BtnIcon::NONE) continue;
+        fp.buttons[i] = zone_rect(i == 0);
+        fp.button_key[i] = zone_key(*zones[i]);
     }
 
-    // ATTENTION: special sweep effect
-    if (s == FaceConvState::ATTENTION && s_border.timer < ATTENTION_DURATION) {
-        render_attention(buf);
+    switch (border_draw()) {
+    case BorderDraw::NONE:
+        return fp;
+    case BorderDraw::SWEEP:
+        // The sweep is a function of the timer alone.
+        fp.band = ATTENTION_DEPTH;
+        std::memcpy(&fp.band_key, &s_border.timer, sizeof(fp.band_key));
+        return fp;
+    case BorderDraw::RING:
+        fp.band = BORDER_DEPTH;
+        fp.band_key = (static_cast<uint32_t>(static_cast<uint8_t>(s_border.color_r)) << 24) |
+                      (static_cast<uint32_t>(static_cast<uint8_t>(s_border.color_g)) << 16) |
+                      (static_cast<uint32_t>(static_cast<uint8_t>(s_border.color_b)) << 8) |
+                      alpha_to_u8(s_border.alpha);
+        break;
+    }
+    if (dots_visible()) {
+        DotPlace dots[THINKING_ORBIT_DOTS];
+        place_dots(dots);
+        for (int i = 0; i < THINKING_ORBIT_DOTS; i++) {
+            fp.dots[i] = dot_rect(dots[i]);
+        }
+    }
+    return fp;
+}
+
+void conv_border_render(pixel_t* buf, const DirtyRegion& redraw)
+{
+    ensure_render_cache();
+
+    switch (border_draw()) {
+    case BorderDraw::NONE:
         return;
+    case BorderDraw::SWEEP:
+        render_attention(buf, redraw);
+        return;
+    case BorderDraw::RING:
+        break;
     }
 
-    // Cached rounded-frame mask + per-frame alpha scale.
+    // Cached rounded-frame ring, re-composited when color or alpha changes.
     const uint8_t frame_alpha_u8 = alpha_to_u8(s_border.alpha);
     const uint8_t cr = static_cast<uint8_t>(s_border.color_r);
     const uint8_t cg = static_cast<uint8_t>(s_border.color_g);
     const uint8_t cb = static_cast<uint8_t>(s_border.color_b);
-    blend_frame_mask(buf, cr, cg, cb, frame_alpha_u8);
+    blend_ring(buf, redraw, cr, cg, cb, frame_alpha_u8);
 
     // THINKING: orbit dots
-    if (s == FaceConvState::THINKING && s_border.alpha > 0.01f) {
+    if (dots_visible()) {
         render_dots(buf);
     }
 }
@@ -827,86 +1079,129 @@ bool conv_border_hit_test_right(int x, int y)
     return x >= BTN_RIGHT_ZONE_X0 && x < SCREEN_W && y >= BTN_ZONE_Y_TOP && y < SCREEN_H;
 }
 
-static void render_corner_zone(pixel_t* buf, bool is_left, const ButtonZone& btn)
-{
-    ensure_render_cache();
-
-    uint8_t bg_r, bg_g, bg_b;
-    float   bg_alpha;
+// Colors and arc pulse of one corner zone this frame: everything its pixels
+// depend on besides the static masks.
+struct ZoneLook {
+    uint8_t bg_r, bg_g, bg_b, bg_alpha;
     uint8_t brd_r, brd_g, brd_b;
     uint8_t ico_r, ico_g, ico_b;
+    uint8_t arc_scale[3]; // MIC sound arcs
+};
 
+static ZoneLook zone_look(const ButtonZone& btn)
+{
+    ZoneLook l;
     if (btn.state == BtnState::PRESSED || btn.flash_timer > 0.0f) {
-        bg_r = static_cast<uint8_t>(clampf(btn.color_r * 1.3f, 0, 255));
-        bg_g = static_cast<uint8_t>(clampf(btn.color_g * 1.3f, 0, 255));
-        bg_b = static_cast<uint8_t>(clampf(btn.color_b * 1.3f, 0, 255));
-        bg_alpha = 0.75f;
-        brd_r = 255;
-        brd_g = 255;
-        brd_b = 255;
-        ico_r = 255;
-        ico_g = 255;
-        ico_b = 255;
+        l.bg_r = static_cast<uint8_t>(clampf(btn.color_r * 1.3f, 0, 255));
+        l.bg_g = static_cast<uint8_t>(clampf(btn.color_g * 1.3f, 0, 255));
+        l.bg_b = static_cast<uint8_t>(clampf(btn.color_b * 1.3f, 0, 255));
+        l.bg_alpha = alpha_to_u8(0.75f);
+        l.brd_r = 255;
+        l.brd_g = 255;
+        l.brd_b = 255;
+        l.ico_r = 255;
+        l.ico_g = 255;
+        l.ico_b = 255;
     } else if (btn.state == BtnState::ACTIVE) {
-        bg_r = btn.color_r;
-        bg_g = btn.color_g;
-        bg_b = btn.color_b;
-        bg_alpha = 0.55f;
-        brd_r = static_cast<uint8_t>(clampf(btn.color_r * 1.2f, 0, 255));
-        brd_g = static_cast<uint8_t>(clampf(btn.color_g * 1.2f, 0, 255));
-        brd_b = static_cast<uint8_t>(clampf(btn.color_b * 1.2f, 0, 255));
-        ico_r = 255;
-        ico_g = 255;
-        ico_b = 255;
+        l.bg_r = btn.color_r;
+        l.bg_g = btn.color_g;
+        l.bg_b = btn.color_b;
+        l.bg_alpha = alpha_to_u8(0.55f);
+        l.brd_r = static_cast<uint8_t>(clampf(btn.color_r * 1.2f, 0, 255));
+        l.brd_g = static_cast<uint8_t>(clampf(btn.color_g * 1.2f, 0, 255));
+        l.brd_b = static_cast<uint8_t>(clampf(btn.color_b * 1.2f, 0, 255));
+        l.ico_r = 255;
+        l.ico_g = 255;
+        l.ico_b = 255;
     } else {
-        bg_r = BTN_IDLE_BG_R;
-        bg_g = BTN_IDLE_BG_G;
-        bg_b = BTN_IDLE_BG_B;
-        bg_alpha = BTN_IDLE_ALPHA;
-        brd_r = BTN_IDLE_BORDER_R;
-        brd_g = BTN_IDLE_BORDER_G;
-        brd_b = BTN_IDLE_BORDER_B;
-        ico_r = BTN_ICON_COLOR_R;
-        ico_g = BTN_ICON_COLOR_G;
-        ico_b = BTN_ICON_COLOR_B;
+        l.bg_r = BTN_IDLE_BG_R;
+        l.bg_g = BTN_IDLE_BG_G;
+        l.bg_b = BTN_IDLE_BG_B;
+        l.bg_alpha = alpha_to_u8(BTN_IDLE_ALPHA);
+        l.brd_r = BTN_IDLE_BORDER_R;
+        l.brd_g = BTN_IDLE_BORDER_G;
+        l.brd_b = BTN_IDLE_BORDER_B;
+        l.ico_r = BTN_ICON_COLOR_R;
+        l.ico_g = BTN_ICON_COLOR_G;
+        l.ico_b = BTN_ICON_COLOR_B;
     }
 
-    blend_zone_mask(buf, s_zone_bg_mask, s_zone_bg_mask_count, is_left, bg_r, bg_g, bg_b, alpha_to_u8(bg_alpha));
-    blend_zone_mask(buf, s_zone_border_mask, s_zone_border_mask_count, is_left, brd_r, brd_g, brd_b, 255U);
+    const float sz = static_cast<float>(BTN_ICON_SIZE);
+    const float arc_radii[] = {sz * 0.44f, sz * 0.67f, sz * 0.89f};
+    for (int ai = 0; ai < 3; ai++) {
+        l.arc_scale[ai] = 255U;
+        if (btn.icon == BtnIcon::MIC && btn.state != BtnState::IDLE) {
+            const float phase = fmodf(s_border.timer * 3.0f - arc_radii[ai] / (sz * 0.78f), 1.0f);
+            const float pulse = 0.5f + 0.5f * fmaxf(0.0f, sinf(phase * PI));
+            l.arc_scale[ai] = alpha_to_u8(pulse);
+        }
+    }
+    return l;
+}
 
-    // Icon rendering
-    const int  icx = is_left ? BTN_LEFT_ICON_CX : BTN_RIGHT_ICON_CX;
-    const int  icy = is_left ? BTN_LEFT_ICON_CY : BTN_RIGHT_ICON_CY;
-    const bool active = btn.state != BtnState::IDLE;
+static uint64_t zone_key(const ButtonZone& btn)
+{
+    const ZoneLook l = zone_look(btn);
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&l);
+    uint64_t       h = (0xCBF29CE484222325ULL ^ static_cast<uint8_t>(btn.icon)) * 0x100000001B3ULL; // FNV-1a
+    for (std::size_t i = 0; i < sizeof(l); i++) {
+        h = (h ^ p[i]) * 0x100000001B3ULL;
+    }
+    return h;
+}
 
-    if (btn.icon == BtnIcon::MIC) {
-        const float sz = static_cast<float>(BTN_ICON_SIZE);
-        const float arc_radii[] = {sz * 0.44f, sz * 0.67f, sz * 0.89f};
+static RectI zone_rect(bool is_left)
+{
+    RectI r;
+    r.x0 = is_left ? 0 : BTN_RIGHT_ZONE_X0;
+    r.y0 = BTN_ZONE_Y_TOP;
+    r.x1 = r.x0 + BTN_CORNER_W - 1;
+    r.y1 = SCREEN_H - 1;
+    r.valid = true;
+    return r;
+}
+
+static void render_corner_zone(pixel_t* buf, bool is_left, const ButtonZone& btn)
+{
+    ensure_render_cache();
 
-        blend_icon_mask(buf, s_mic_body_mask, s_mic_body_mask_count, icx, icy, ico_r, ico_g, ico_b, 255U);
-        blend_icon_mask(buf, s_mic_base_mask, s_mic_base_mask_count, icx, icy, ico_r, ico_g, ico_b, 255U);
+    const ZoneLook l = zone_look(btn);
+    blend_zone_mask(buf, s_zone_bg_mask, s_zone_bg_mask_count, is_left, l.bg_r, l.bg_g, l.bg_b, l.bg_alpha);
+    blend_zone_mask(buf, s_zone_border_mask, s_zone_border_mask_count, is_left, l.brd_r, l.brd_g, l.brd_b, 255U);
 
+    // Icon rendering
+    const int icx = is_left ? BTN_LEFT_ICON_CX : BTN_RIGHT_ICON_CX;
+    const int icy = is_left ? BTN_LEFT_ICON_CY : BTN_RIGHT_ICON_CY;
+
+    if (btn.icon == BtnIcon::MIC) {
+        blend_icon_mask(buf, s_mic_body_mask, s_mic_body_mask_count, icx, icy, l.ico_r, l.ico_g, l.ico_b, 255U);
+        blend_icon_mask(buf, s_mic_base_mask, s_mic_base_mask_count, icx, icy, l.ico_r, l.ico_g, l.ico_b, 255U);
         for (int ai = 0; ai < 3; ai++) {
-            uint8_t arc_scale_u8 = 255U;
-            if (active) {
-                const float phase = fmodf(s_border.timer * 3.0f - arc_radii[ai] / (sz * 0.78f), 1.0f);
-                const float pulse = 0.5f + 0.5f * fmaxf(0.0f, sinf(phase * PI));
-                arc_scale_u8 = alpha_to_u8(pulse);
-            }
-            blend_icon_mask(buf, s_mic_arc_masks[ai], s_mic_arc_mask_count[ai], icx, icy, ico_r, ico_g, ico_b,
-                            arc_scale_u8);
+            blend_icon_mask(buf, s_mic_arc_masks[ai], s_mic_arc_mask_count[ai], icx, icy, l.ico_r, l.ico_g, l.ico_b,
+                            l.arc_scale[ai]);
         }
     } else if (btn.icon == BtnIcon::X_MARK) {
-        blend_icon_mask(buf, s_x_icon_mask, s_x_icon_mask_count, icx, icy, ico_r, ico_g, ico_b, 255U);
+        blend_icon_mask(buf, s_x_icon_mask, s_x_icon_mask_count, icx, icy, l.ico_r, l.ico_g, l.ico_b, 255U);
+    }
+}
+
+// A zone is drawn when redraw reaches it; the renderer then restored all of it.
+static bool zone_redrawn(const DirtyRegion& redraw, const RectI& zone)
+{
+    if (redraw.full) return true;
+    for (uint8_t i = 0; i < redraw.count; i++) {
+        const RectI& r = redraw.rects[i];
+        if (r.valid && r.x0 <= zone.x1 && zone.x0 <= r.x1 && r.y0 <= zone.y1 && zone.y0 <= r.y1) return true;
     }
+    return false;
 }
 
-void conv_border_render_buttons(pixel_t* buf)
+void conv_border_render_buttons(pixel_t* buf, const DirtyRegion& redraw)
 {
-    if (s_btn_left.icon != BtnIcon::NONE) {
+    if (s_btn_left.icon != BtnIcon::NONE && zone_redrawn(redraw, zone_rect(true))) {
         render_corner_zone(buf, true, s_btn_left);
     }
-    if (s_btn_right.icon != BtnIcon::NONE) {
+    if (s_btn_right.icon != BtnIcon::NONE && zone_redrawn(redraw, zone_rect(false))) {
         render_corner_zone(buf, false, s_btn_right);
     }
 }
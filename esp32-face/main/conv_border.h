@@ -2,9 +2,12 @@
 // Conversation border renderer — visual feedback of conversation phase.
 // Ported from tools/face_sim_v3/render/border.py (canonical reference).
 
+#include "face_render.h"
 #include "pixel.h"
 #include <cstdint>
 
+constexpr int CONV_BORDER_DOTS = 3; // THINKING orbit dots
+
 // ---- Border state control ----
 
 void conv_border_set_state(uint8_t state); // FaceConvState (0-7)
@@ -13,14 +16,47 @@ void conv_border_update(float dt);         // Advance animation (call every fram
 
 // ---- Border rendering ----
 
-void conv_border_render(pixel_t* buf);         // Frame + glow overlay
-void conv_border_render_buttons(pixel_t* buf); // Corner button zones
+// What conv_border_render() and conv_border_render_buttons() will draw this
+// frame, for the renderer's dirty rects. Equal band and band_key mean
+// identical band pixels, equal button rect and key an identical corner zone;
+// the dots are redrawn every frame.
+struct ConvBorderFootprint {
+    uint8_t  band = 0;     // depth of the edge band drawn (frame glow or ATTENTION sweep), 0 = none
+    uint32_t band_key = 0; // changes whenever the band pixels do
+    RectI    dots[CONV_BORDER_DOTS] = {};
+    RectI    buttons[2] = {};    // left, right corner zone; invalid when hidden
+    uint64_t button_key[2] = {}; // changes whenever the zone pixels do
+};
+
+ConvBorderFootprint conv_border_footprint();
+
+// Frame + glow overlay. The band is drawn only inside redraw (all of it when
+// redraw.full): elsewhere the canvas must still hold this band from the last
+// frame drawn into it, i.e. the same footprint. The dots are always drawn.
+void conv_border_render(pixel_t* buf, const DirtyRegion& redraw);
+// Corner button zones. A zone is drawn only when redraw reaches it, and then
+// redraw must cover all of it (blending over itself would accumulate).
+void conv_border_render_buttons(pixel_t* buf, const DirtyRegion& redraw);
 
 // ---- LED sync ----
 
 void conv_border_get_led(uint8_t& r, uint8_t& g, uint8_t& b);
 bool conv_border_active(); // True when border alpha > threshold
 
+// Frame color and alpha as conv_border_render() blends them (8-bit, alpha 0..255).
+void conv_border_get_glow(uint8_t& r, uint8_t& g, uint8_t& b, uint8_t& alpha);
+
+// ---- Perimeter ring cache ----
+
+// Cumulative counters since boot; callers diff them per window.
+struct ConvBorderStats {
+    uint32_t ring_builds = 0;   // ring re-composited for a new color / alpha
+    uint32_t ring_copy_px = 0;  // ring pixels copied over untouched background
+    uint32_t ring_blend_px = 0; // ring pixels blended over drawn content
+};
+
+ConvBorderStats conv_border_stats();
+
 // ---- Corner button control ----
 
 enum class BtnIcon : uint8_t {
@@ -10,7 +10,8 @@
 #include "driver/spi_master.h"
 #include "esp_log.h"
 
-static const char* TAG = "display";
+static const char*            TAG = "display";
+static esp_lcd_panel_handle_t s_panel = nullptr;
 
 // Backlight via LEDC
 static void backlight_init(void)
@@ -36,6 +37,11 @@ static void backlight_init(void)
     ESP_ERROR_CHECK(ledc_channel_config(&ch_cfg));
 }
 
+esp_lcd_panel_handle_t display_panel(void)
+{
+    return s_panel;
+}
+
 void display_set_backlight(uint8_t brightness)
 {
     ledc_set_duty(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0, brightness);
@@ -83,6 +89,7 @@ lv_display_t* display_init(void)
     ESP_ERROR_CHECK(esp_lcd_panel_init(panel_handle));
     ESP_ERROR_CHECK(esp_lcd_panel_invert_color(panel_handle, true));
     ESP_ERROR_CHECK(esp_lcd_panel_disp_on_off(panel_handle, true));
+    s_panel = panel_handle;
 
     // 5. LVGL port
     lvgl_port_cfg_t lvgl_cfg = ESP_LVGL_PORT_INIT_CONFIG();
@@ -113,7 +120,7 @@ lv_display_t* display_init(void)
                 .buff_dma = true,
                 .buff_spiram = false,
                 .sw_rotate = false,
-                .swap_bytes = true,
+                .swap_bytes = !FACE_PIXEL_SWAPPED, // canvas may already be panel order
                 .full_refresh = false,
                 .direct_mode = false,
             },
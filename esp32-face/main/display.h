@@ -1,11 +1,15 @@
 #pragma once
 // ILI9341 TFT display + LVGL integration.
 
+#include "esp_lcd_types.h"
 #include "lvgl.h"
 
 // Initialize SPI bus, ILI9341 panel, LVGL port, backlight PWM.
 // Returns the LVGL display handle.
 lv_display_t* display_init(void);
 
+// Panel handle created by display_init(), for direct presentation.
+esp_lcd_panel_handle_t display_panel(void);
+
 // Set backlight brightness 0-255.
 void display_set_backlight(uint8_t brightness);
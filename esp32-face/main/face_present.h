@@ -0,0 +1,45 @@
+#pragma once
+// Presentation of finished face frames to the panel, behind a small interface
+// so the firmware (panel_present.cpp, esp_lcd DMA) and the host tests
+// (host_presenter.h, records what was pushed) share the face_ui call pattern.
+
+#include "config.h"
+#include "face_render.h"
+#include "pixel.h"
+
+#include <cstdint>
+
+// present() starts pushing the dirty region of canvas (SCREEN_W x SCREEN_H,
+// row-major) to the panel and may return before the transfer is done; the
+// canvas must not be written until wait() returns. wait() returns at once if
+// nothing is in flight. Both are called only from the face UI task.
+struct FacePresenter {
+    void* ctx = nullptr;
+    void (*present)(void* ctx, const pixel_t* canvas, const DirtyRegion& dirty) = nullptr;
+    void (*wait)(void* ctx) = nullptr;
+};
+
+// Calls fn(rect) for every rect a presenter pushes for dirty: the whole screen
+// when dirty.full, else each valid rect (inclusive corners, clipped to screen).
+template <typename Fn>
+inline void face_present_for_each_rect(const DirtyRegion& dirty, Fn&& fn)
+{
+    if (dirty.full) {
+        RectI r;
+        r.x1 = SCREEN_W - 1;
+        r.y1 = SCREEN_H - 1;
+        r.valid = true;
+        fn(r);
+        return;
+    }
+    for (uint8_t i = 0; i < dirty.count; i++) {
+        RectI r = dirty.rects[i];
+        if (!r.valid) continue;
+        if (r.x0 < 0) r.x0 = 0;
+        if (r.y0 < 0) r.y0 = 0;
+        if (r.x1 > SCREEN_W - 1) r.x1 = SCREEN_W - 1;
+        if (r.y1 > SCREEN_H - 1) r.y1 = SCREEN_H - 1;
+        if (r.x1 < r.x0 || r.y1 < r.y0) continue;
+        fn(r);
+    }
+}
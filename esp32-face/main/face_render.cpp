@@ -0,0 +1,1617 @@
+#include "face_render.h"
+#include "config.h"
+#include "conv_border.h"
+#include "heart_sprite.h"
+#include "mouth_cache.h"
+#include "particle_draw.h"
+#include "pixel_span.h"
+#include "system_face.h"
+#include "system_overlay_v2.h"
+
+#include "esp_timer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+static constexpr uint8_t BG_R = 0;
+static constexpr uint8_t BG_G = 0;
+static constexpr uint8_t BG_B = 0;
+
+static pixel_t*         afterglow_buf = nullptr;
+static FaceRenderWorker s_worker = {};
+static bool             s_worker_attached = false;
+
+// Afterglow is tracked per face shape: eye_l, eye_r, mouth, fire.
+static constexpr int AFTERGLOW_SHAPES = 4;
+
+// Sparkle and fire particles, as the FACE_PARTICLE_TILE_PX tiles they cover:
+// one bit per tile column in each tile row.
+static constexpr int PARTICLE_TILE_COLS = (SCREEN_W + FACE_PARTICLE_TILE_PX - 1) / FACE_PARTICLE_TILE_PX;
+static constexpr int PARTICLE_TILE_ROWS = (SCREEN_H + FACE_PARTICLE_TILE_PX - 1) / FACE_PARTICLE_TILE_PX;
+static_assert(PARTICLE_TILE_COLS <= 32, "tile row mask is 32 bits");
+
+struct ParticleTiles {
+    uint32_t rows[PARTICLE_TILE_ROWS] = {};
+};
+
+// ---- Display list ----
+// The eyes and the mouth are described each frame as short lists of
+// primitives with integer (quantized) parameters, in draw order, and drawn
+// from them. An element whose list equals the one last drawn into the canvas
+// is neither restored nor redrawn, so a frame where nothing visibly changed
+// draws and pushes nothing.
+enum class PrimKind : uint8_t {
+    RECT,    // rounded rect: x, y, w, h, r (r = 0 for a plain rect)
+    CIRCLE,  // x, y = center, r
+    LID_TOP, // columns [x, x + w), rows y..h, per-column rows in s_lid_rows; aux[0] = their hash
+    HEART,   // x, y = center, r = FACE_HEART_SPRITE_SIZE_STEP size bucket
+    X_MARK,  // x, y = center, w = size, h = stroke
+    MOUTH,   // mouth
+};
+
+struct DisplayPrim {
+    PrimKind kind = PrimKind::RECT;
+    pixel_t  color = 0;
+    int16_t  x = 0;
+    int16_t  y = 0;
+    int16_t  w = 0;
+    int16_t  h = 0;
+    int16_t  r = 0;
+    uint32_t aux[2] = {}; // per kind; aux[1] = RGB888 of blended (heart, mouth) prims
+    MouthKey mouth = {};
+
+    bool operator==(const DisplayPrim& o) const
+    {
+        return kind == o.kind && color == o.color && x == o.x && y == o.y && w == o.w && h == o.h && r == o.r &&
+               aux[0] == o.aux[0] && aux[1] == o.aux[1] && mouth == o.mouth;
+    }
+};
+
+enum DisplayElement : uint8_t { DL_EYE_L, DL_EYE_R, DL_MOUTH, DL_ELEMENTS };
+static constexpr int DL_MAX_PRIMS = 5; // glow, body, pupil, two lids
+
+struct DisplayList {
+    DisplayPrim prims[DL_ELEMENTS][DL_MAX_PRIMS] = {};
+    uint8_t     count[DL_ELEMENTS] = {};
+};
+
+static int16_t s_lid_rows[2][SCREEN_W]; // this frame's top lid rows, per eye
+
+struct PrevBoundsState {
+    RectI eye_l = {};
+    RectI eye_r = {};
+    RectI mouth = {};
+    RectI fire = {};                   // all fire particles, for the afterglow
+    RectI glow[AFTERGLOW_SHAPES] = {}; // afterglow history cells in use
+    bool  full = false;
+    bool  valid = false;
+
+    ParticleTiles       particles = {};
+    ConvBorderFootprint border = {};
+    DisplayList         list = {};
+};
+
+// One plan per frame, computed before drawing. dirty is what changed since the
+// previous frame (the panel push); restore is what changed since the frame
+// last drawn into this canvas (the background restore). With one canvas they
+// are the same rects. Either is full when pixels may have been written
+// outside the tracked bounds (system modes). glow is where the
+// afterglow history may be lit this frame (empty when afterglow is off).
+// draw holds the display list elements to redraw: those that changed since
+// the canvas last held them or that the restore reaches.
+struct FramePlan {
+    DirtyRegion dirty = {};
+    DirtyRegion restore = {};
+    RectI       glow[AFTERGLOW_SHAPES] = {};
+    bool        draw[DL_ELEMENTS] = {};
+};
+
+// Eye geometry after breath, openness and gaze, shared by render_eye and
+// compute_eye_bounds.
+struct EyeGeom {
+    bool  is_left = false;
+    bool  visible = false; // false when the eye is too thin to draw
+    float center_x = 0.0f;
+    float center_y = 0.0f;
+    float ew = 0.0f; // body size and top-left
+    float eh = 0.0f;
+    float ex = 0.0f;
+    float ey = 0.0f;
+    int   corner = 0;
+    float pupil_x = 0.0f;
+    float pupil_y = 0.0f;
+    int   pupil_r = 0;
+    float lid_top = 0.0f;
+    float lid_bot = 0.0f;
+};
+
+// What the renderers and the planner derive from FaceState, built once per
+// frame so the eyes, the mouth and their dirty bounds use the same values.
+struct RenderContext {
+    uint8_t    r = 0; // emotion color
+    uint8_t    g = 0;
+    uint8_t    b = 0;
+    pixel_t    color = 0;
+    pixel_t    glow = 0; // edge glow, 2/5 of color
+    pixel_t    pupil = 0;
+    float      breath = 1.0f;
+    EyeGeom    eye_l = {};
+    EyeGeom    eye_r = {};
+    bool       mouth_visible = false;
+    MouthShape mouth = {};
+};
+
+// What the previous frame drew into each canvas of the rotation
+// (face_render_init), indexed by s_canvas_slot.
+struct CanvasHistory {
+    PrevBoundsState bounds = {};
+};
+
+static constexpr uint8_t MAX_CANVASES = 2;
+
+static PrevBoundsState s_prev_bounds = {}; // last frame, whichever canvas it went to
+static CanvasHistory   s_canvas_hist[MAX_CANVASES] = {};
+static uint8_t         s_canvas_count = 1;
+static uint8_t         s_canvas_slot = 0;
+static DirtyPolicy     s_dirty_policy = {};
+static FaceRenderStats s_stats = {};
+static SystemRenderer  s_system_renderer = FACE_SYSTEM_OVERLAY_V2 ? SystemRenderer::OVERLAY_V2 : SystemRenderer::FACE;
+
+static FramePlan plan_frame(const FaceState& fs, const RenderContext& ctx, const DisplayList& list);
+
+static float clampf(float v, float lo, float hi)
+{
+    if (v < lo) return lo;
+    if (v > hi) return hi;
+    return v;
+}
+
+// ---- Drawing helpers (RGB565 pixel_t) ----
+
+static pixel_t rgb_to_color(uint8_t r, uint8_t g, uint8_t b)
+{
+    return px_rgb(r, g, b);
+}
+
+static pixel_t scale_color(pixel_t c, uint8_t num, uint8_t den)
+{
+    return px_scale(c, num, den);
+}
+
+// Fill [x0, x1) of one row.
+static void fill_span(pixel_t* row, int x0, int x1, pixel_t color)
+{
+    if (x1 <= x0) return;
+    px_span_fill(row + x0, x1 - x0, color);
+}
+
+static void draw_filled_rect(pixel_t* buf, int x, int y, int w, int h, pixel_t color)
+{
+    const int x0 = (x < 0) ? 0 : x;
+    const int x1 = (x + w > SCREEN_W) ? SCREEN_W : x + w;
+    const int y0 = (y < 0) ? 0 : y;
+    const int y1 = (y + h > SCREEN_H) ? SCREEN_H : y + h;
+    for (int py = y0; py < y1; py++) {
+        fill_span(buf + py * SCREEN_W, x0, x1, color);
+    }
+}
+
+static void draw_hline(pixel_t* buf, int x0, int x1, int y, pixel_t color)
+{
+    const int x_lo = (x0 < x1) ? x0 : x1;
+    const int x_hi = (x0 < x1) ? x1 : x0;
+    draw_filled_rect(buf, x_lo, y, x_hi - x_lo + 1, 1, color);
+}
+
+static void draw_vline(pixel_t* buf, int x, int y0, int y1, pixel_t color)
+{
+    const int y_lo = (y0 < y1) ? y0 : y1;
+    const int y_hi = (y0 < y1) ? y1 : y0;
+    draw_filled_rect(buf, x, y_lo, 1, y_hi - y_lo + 1, color);
+}
+
+static bool point_in_rect(int x, int y, int rx, int ry, int rw, int rh)
+{
+    return (x >= rx && x < (rx + rw) && y >= ry && y < (ry + rh));
+}
+
+// ---- Span rasterizer ----
+// Each shape yields at most one [x0, x1) span per row. A row is composited
+// from a small stack of shapes (later = on top), so every covered pixel is
+// written exactly once and clipping happens once per row.
+
+static int isqrt(int v)
+{
+    if (v < 0) return -1;
+    int r = static_cast<int>(sqrtf(static_cast<float>(v)));
+    while (r * r > v) r--;
+    while ((r + 1) * (r + 1) <= v) r++;
+    return r;
+}
+
+enum class SpanKind : uint8_t {
+    ROUNDED_RECT, // x, y, w, h, r (r = 0 for a plain rect)
+    CIRCLE,       // x, y = center, r
+    LID_TOP,      // columns [x, x + w) covered from y down to lid_rows[col]
+};
+
+struct SpanShape {
+    SpanKind       kind = SpanKind::ROUNDED_RECT;
+    pixel_t        color = 0;
+    int            x = 0;
+    int            y = 0;
+    int            w = 0;
+    int            h = 0;
+    int            r = 0;
+    int            y_min = 0; // inclusive rows touched (unclipped)
+    int            y_max = -1;
+    const int16_t* lid_rows = nullptr;
+};
+
+static SpanShape span_rounded_rect(int x, int y, int w, int h, int radius, pixel_t color)
+{
+    SpanShape s;
+    s.kind = SpanKind::ROUNDED_RECT;
+    s.color = color;
+    s.x = x;
+    s.y = y;
+    s.w = w;
+    s.h = h;
+    s.r = radius;
+    s.y_min = y;
+    s.y_max = (w > 0 && h > 0) ? y + h - 1 : y - 1;
+    return s;
+}
+
+static SpanShape span_circle(int cx, int cy, int radius, pixel_t color)
+{
+    SpanShape s;
+    s.kind = SpanKind::CIRCLE;
+    s.color = color;
+    s.x = cx;
+    s.y = cy;
+    s.r = radius;
+    s.y_min = cy - radius;
+    s.y_max = cy + radius;
+    return s;
+}
+
+// Row span of a shape, unclipped in x. Matches the per-pixel inside tests the
+// renderer used before (corner circles centred on the inner radius box).
+static bool shape_row_span(const SpanShape& s, int py, int& x0, int& x1)
+{
+    if (py < s.y_min || py > s.y_max) return false;
+
+    switch (s.kind) {
+    case SpanKind::ROUNDED_RECT: {
+        const int dy = py - s.y;
+        const int r = s.r;
+        int       ddy = -1;
+        if (dy < r) {
+            ddy = r - dy;
+        } else if (dy >= s.h - r) {
+            ddy = dy - (s.h - r - 1);
+        }
+        if (ddy < 0) {
+            x0 = s.x;
+            x1 = s.x + s.w;
+            return true;
+        }
+        // Left corner owns dx < r, the right corner the rest of dx >= w - r,
+        // and the straight middle is [r, w - r). The pieces are contiguous.
+        const int reach = isqrt(r * r - ddy * ddy);
+        int       lo = s.w;
+        int       hi = 0;
+        auto      add = [&](int a, int b) {
+            if (b <= a) return;
+            if (a < lo) lo = a;
+            if (b > hi) hi = b;
+        };
+        if (reach >= 0) {
+            add((r - reach > 0) ? r - reach : 0, (r < s.w) ? r : s.w);
+        }
+        add(r, s.w - r);
+        if (reach >= 0) {
+            add((s.w - r > r) ? s.w - r : r, (s.w - r + reach < s.w) ? s.w - r + reach : s.w);
+        }
+        if (hi <= lo) return false;
+        x0 = s.x + lo;
+        x1 = s.x + hi;
+        return true;
+    }
+    case SpanKind::CIRCLE: {
+        const int dy = py - s.y;
+        const int reach = isqrt(s.r * s.r - dy * dy);
+        if (reach < 0) return false;
+        x0 = s.x - reach;
+        x1 = s.x + reach + 1;
+        return true;
+    }
+    case SpanKind::LID_TOP: {
+        // Lid depth is monotonic across the eye (linear slope), so the covered
+        // columns form one run anchored at the left or the right edge.
+        int n_left = 0;
+        while (n_left < s.w && s.lid_rows[n_left] >= py) n_left++;
+        if (n_left > 0) {
+            x0 = s.x;
+            x1 = s.x + n_left;
+            return true;
+        }
+        int n_right = 0;
+        while (n_right < s.w && s.lid_rows[s.w - 1 - n_right] >= py) n_right++;
+        if (n_right == 0) return false;
+        x0 = s.x + s.w - n_right;
+        x1 = s.x + s.w;
+        return true;
+    }
+    }
+    return false;
+}
+
+static constexpr int MAX_SPAN_LAYERS = 6;
+
+// Composite a stack of shapes row by row; layers[n - 1] is topmost.
+static void composite_spans(pixel_t* buf, const SpanShape* layers, int n)
+{
+    int y_lo = SCREEN_H;
+    int y_hi = -1;
+    for (int i = 0; i < n; i++) {
+        if (layers[i].y_min < y_lo) y_lo = layers[i].y_min;
+        if (layers[i].y_max > y_hi) y_hi = layers[i].y_max;
+    }
+    if (y_lo < 0) y_lo = 0;
+    if (y_hi >= SCREEN_H) y_hi = SCREEN_H - 1;
+
+    for (int py = y_lo; py <= y_hi; py++) {
+        int sx0[MAX_SPAN_LAYERS];
+        int sx1[MAX_SPAN_LAYERS];
+        int edges[2 * MAX_SPAN_LAYERS];
+        int n_edges = 0;
+        for (int i = 0; i < n; i++) {
+            int a = 0;
+            int b = 0;
+            if (!shape_row_span(layers[i], py, a, b)) {
+                sx0[i] = sx1[i] = 0;
+                continue;
+            }
+            if (a < 0) a = 0;
+            if (b > SCREEN_W) b = SCREEN_W;
+            if (b <= a) {
+                sx0[i] = sx1[i] = 0;
+                continue;
+            }
+            sx0[i] = a;
+            sx1[i] = b;
+            edges[n_edges++] = a;
+            edges[n_edges++] = b;
+        }
+        if (n_edges == 0) continue;
+
+        // Insertion sort: at most 2 * MAX_SPAN_LAYERS edges.
+        for (int i = 1; i < n_edges; i++) {
+            const int v = edges[i];
+            int       j = i - 1;
+            while (j >= 0 && edges[j] > v) {
+                edges[j + 1] = edges[j];
+                j--;
+            }
+            edges[j + 1] = v;
+        }
+
+        pixel_t* row = buf + py * SCREEN_W;
+        for (int e = 0; e + 1 < n_edges; e++) {
+            const int a = edges[e];
+            const int b = edges[e + 1];
+            if (b <= a) continue;
+            for (int i = n - 1; i >= 0; i--) {
+                if (sx0[i] <= a && b <= sx1[i]) {
+                    fill_span(row, a, b, layers[i].color);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+static void draw_filled_circle(pixel_t* buf, int cx, int cy, int radius, pixel_t color)
+{
+    const SpanShape s = span_circle(cx, cy, radius, color);
+    composite_spans(buf, &s, 1);
+}
+
+// ---- Face rendering ----
+
+static void draw_x_shape(pixel_t* buf, int cx, int cy, int size, int thick, pixel_t color)
+{
+    for (int y = cy - size; y <= cy + size; y++) {
+        if (y < 0 || y >= SCREEN_H) continue;
+        for (int x = cx - size; x <= cx + size; x++) {
+            if (x < 0 || x >= SCREEN_W) continue;
+            const int dx = x - cx;
+            const int dy = y - cy;
+            if (abs(dx + dy) <= thick || abs(dx - dy) <= thick) {
+                buf[y * SCREEN_W + x] = color;
+            }
+        }
+    }
+}
+
+static EyeGeom build_eye_geom(const FaceState& fs, bool is_left, float breath)
+{
+    const EyeState& eye = is_left ? fs.eye_l : fs.eye_r;
+    EyeGeom         eg;
+    eg.is_left = is_left;
+    eg.center_x = is_left ? LEFT_EYE_CX : RIGHT_EYE_CX;
+    eg.center_y = is_left ? LEFT_EYE_CY : RIGHT_EYE_CY;
+    eg.ew = EYE_WIDTH * eye.width_scale * breath;
+    eg.eh = EYE_HEIGHT * eye.height_scale * fmaxf(0.25f, eye.openness) * breath;
+    eg.visible = eg.eh >= 2.0f;
+    eg.ex = eg.center_x + eye.gaze_x * GAZE_EYE_SHIFT - eg.ew / 2.0f;
+    eg.ey = eg.center_y + eye.gaze_y * GAZE_EYE_SHIFT - eg.eh / 2.0f;
+    eg.corner = static_cast<int>(EYE_CORNER_R * fminf(eye.width_scale, eye.height_scale));
+
+    const float max_offset_x = fmaxf(0.0f, eg.ew * 0.5f - PUPIL_R - 5.0f);
+    const float max_offset_y = fmaxf(0.0f, eg.eh * 0.5f - PUPIL_R - 5.0f);
+    eg.pupil_x = eg.center_x + clampf(eye.gaze_x * GAZE_PUPIL_SHIFT, -max_offset_x, max_offset_x);
+    eg.pupil_y = eg.center_y + clampf(eye.gaze_y * GAZE_PUPIL_SHIFT, -max_offset_y, max_offset_y);
+    eg.pupil_r = static_cast<int>(PUPIL_R * fmaxf(0.4f, eye.openness));
+
+    eg.lid_top = is_left ? fs.eyelids.top_l : fs.eyelids.top_r;
+    eg.lid_bot = is_left ? fs.eyelids.bottom_l : fs.eyelids.bottom_r;
+    return eg;
+}
+
+static RenderContext build_render_context(const FaceState& fs)
+{
+    RenderContext ctx;
+    face_get_emotion_color(fs, ctx.r, ctx.g, ctx.b);
+    ctx.color = rgb_to_color(ctx.r, ctx.g, ctx.b);
+    ctx.glow = scale_color(ctx.color, 2, 5);
+    ctx.pupil = rgb_to_color(10, 15, 30);
+    ctx.breath = face_get_breath_scale(fs);
+    ctx.eye_l = build_eye_geom(fs, true, ctx.breath);
+    ctx.eye_r = build_eye_geom(fs, false, ctx.breath);
+
+    MouthShape& m = ctx.mouth;
+    m.cx = MOUTH_CX + fs.mouth_offset_x * 10.0f;
+    m.cy = MOUTH_CY;
+    m.half_w = MOUTH_HALF_W * fs.mouth_width;
+    m.thick = MOUTH_THICKNESS;
+    m.curve = fs.mouth_curve * 40.0f;
+    m.open = fs.mouth_open * 40.0f;
+    // Talking flaps open/width every frame; snapping them to a coarse grid
+    // keeps the shapes inside the cache.
+    m.snap = fs.talking ? FACE_MOUTH_TALK_SNAP_PX : 0.0f;
+    ctx.mouth_visible = fs.show_mouth && m.half_w >= 1.0f;
+    return ctx;
+}
+
+static void push_span_prim(DisplayPrim*& p, PrimKind kind, pixel_t color, int x, int y, int w, int h, int r)
+{
+    DisplayPrim& d = *p++;
+    d.kind = kind;
+    d.color = color;
+    d.x = static_cast<int16_t>(x);
+    d.y = static_cast<int16_t>(y);
+    d.w = static_cast<int16_t>(w);
+    d.h = static_cast<int16_t>(h);
+    d.r = static_cast<int16_t>(r);
+}
+
+// Hearts are drawn at the rounded center and the sprite's size bucket, so
+// sub-pixel drift (gaze springs, breathing) leaves the primitive unchanged.
+static void push_heart_prim(DisplayPrim*& p, float cx, float cy, float size, uint8_t r, uint8_t g, uint8_t b)
+{
+    DisplayPrim& d = *p++;
+    d.kind = PrimKind::HEART;
+    d.x = static_cast<int16_t>(lroundf(cx));
+    d.y = static_cast<int16_t>(lroundf(cy));
+    d.r = static_cast<int16_t>(lroundf(size / FACE_HEART_SPRITE_SIZE_STEP));
+    d.aux[1] = (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) | b;
+}
+
+static uint32_t lid_rows_hash(const int16_t* rows, int n)
+{
+    uint32_t h = 2166136261U;
+    for (int i = 0; i < n; i++) {
+        h = (h ^ static_cast<uint16_t>(rows[i])) * 16777619U;
+    }
+    return h;
+}
+
+// One eye's primitives, bottom to top: glow, body, pupil, eyelids. Heart and X
+// shapes are per-pixel and sit between the body and the lids. The top lid's
+// rows go to s_lid_rows[e].
+static void build_eye_prims(DisplayList& dl, int e, const RenderContext& ctx, const EyeGeom& eg, const FaceState& fs)
+{
+    DisplayPrim* p = dl.prims[e];
+    dl.count[e] = 0;
+    if (!eg.visible) {
+        return;
+    }
+    const pixel_t black = rgb_to_color(0, 0, 0);
+    const float   ew = eg.ew;
+    const float   eh = eg.eh;
+    const float   ex = eg.ex;
+    const float   ey = eg.ey;
+
+    if (!(fs.solid_eye && (fs.anim.heart || fs.anim.x_eyes))) {
+        if (fs.fx.edge_glow) {
+            push_span_prim(p, PrimKind::RECT, ctx.glow, static_cast<int>(ex) - 2, static_cast<int>(ey) - 2,
+                           static_cast<int>(ew) + 4, static_cast<int>(eh) + 4, eg.corner + 2);
+        }
+        push_span_prim(p, PrimKind::RECT, ctx.color, static_cast<int>(ex), static_cast<int>(ey), static_cast<int>(ew),
+                       static_cast<int>(eh), eg.corner);
+    }
+
+    const int px = static_cast<int>(eg.pupil_x);
+    const int py = static_cast<int>(eg.pupil_y);
+    if (fs.solid_eye && fs.anim.heart) {
+        push_heart_prim(p, eg.center_x, eg.center_y, fminf(ew, eh) * 0.5f * HEART_SOLID_SCALE, ctx.r, ctx.g, ctx.b);
+    } else if (fs.solid_eye && fs.anim.x_eyes) {
+        push_span_prim(p, PrimKind::X_MARK, ctx.color, static_cast<int>(eg.center_x), static_cast<int>(eg.center_y),
+                       static_cast<int>(fminf(ew, eh) * 0.33f), 3, 0);
+    } else if (!fs.solid_eye && fs.anim.heart) {
+        push_heart_prim(p, eg.pupil_x, eg.pupil_y, PUPIL_R * HEART_PUPIL_SCALE, 10, 15, 30);
+    } else if (!fs.solid_eye && fs.anim.x_eyes) {
+        push_span_prim(p, PrimKind::X_MARK, ctx.pupil, px, py, eg.pupil_r, 2, 0);
+    } else if (!fs.solid_eye && eg.pupil_r > 1) {
+        push_span_prim(p, PrimKind::CIRCLE, ctx.pupil, px, py, 0, 0, eg.pupil_r);
+    }
+
+    // V2 eyelid model: top/bottom coverage + diagonal slope. Top lid rows are
+    // tabulated per column; the bottom lid is flat.
+    const float slope = fs.eyelids.slope;
+    const int   x0 = static_cast<int>(ex);
+    const int   x1 = static_cast<int>(ex + ew);
+    const int   y0 = static_cast<int>(ey);
+    const int   y1 = static_cast<int>(ey + eh);
+    const int   cx0 = (x0 < 0) ? 0 : x0;
+    const int   cx1 = (x1 > SCREEN_W) ? SCREEN_W : x1;
+
+    int16_t* lid_rows = s_lid_rows[e];
+    int      lid_max = y0 - 1;
+    for (int x = cx0; x < cx1; x++) {
+        float nx = (static_cast<float>(x) - (ex + ew * 0.5f)) / fmaxf(1.0f, ew * 0.5f);
+        if (!eg.is_left) {
+            nx = -nx;
+        }
+        const float slope_off = slope * 20.0f * nx;
+        int         top_limit = static_cast<int>((ey - 0.5f) + eh * 2.0f * eg.lid_top + slope_off);
+        if (top_limit <= y0) {
+            top_limit = y0 - 1; // lid not drawn in this column
+        }
+        if (top_limit >= SCREEN_H) {
+            top_limit = SCREEN_H - 1;
+        }
+        lid_rows[x - cx0] = static_cast<int16_t>(top_limit);
+        if (top_limit > lid_max) lid_max = top_limit;
+    }
+    if (cx1 > cx0 && lid_max >= y0) {
+        // y..h is the row range; the rows themselves are keyed by their hash.
+        push_span_prim(p, PrimKind::LID_TOP, black, cx0, y0, cx1 - cx0, lid_max, 0);
+        p[-1].aux[0] = lid_rows_hash(lid_rows, cx1 - cx0);
+    }
+
+    const int bot_limit = static_cast<int>((ey + eh) - eh * 2.0f * eg.lid_bot);
+    if (cx1 > cx0 && bot_limit < y1) {
+        push_span_prim(p, PrimKind::RECT, black, cx0, bot_limit, cx1 - cx0, y1 - bot_limit + 1, 0);
+    }
+    dl.count[e] = static_cast<uint8_t>(p - dl.prims[e]);
+}
+
+static void build_display_list(DisplayList& dl, const RenderContext& ctx, const FaceState& fs)
+{
+    build_eye_prims(dl, DL_EYE_L, ctx, ctx.eye_l, fs);
+    build_eye_prims(dl, DL_EYE_R, ctx, ctx.eye_r, fs);
+
+    dl.count[DL_MOUTH] = 0;
+    if (ctx.mouth_visible) {
+        DisplayPrim& d = dl.prims[DL_MOUTH][0];
+        d = {};
+        d.kind = PrimKind::MOUTH;
+        d.mouth = mouth_cache_key(ctx.mouth);
+        d.aux[1] = (static_cast<uint32_t>(ctx.r) << 16) | (static_cast<uint32_t>(ctx.g) << 8) | ctx.b;
+        if (d.mouth.half_w > 0) dl.count[DL_MOUTH] = 1;
+    }
+}
+
+static bool display_element_equal(const DisplayList& a, const DisplayList& b, int e)
+{
+    if (a.count[e] != b.count[e]) return false;
+    for (int i = 0; i < a.count[e]; i++) {
+        if (!(a.prims[e][i] == b.prims[e][i])) return false;
+    }
+    return true;
+}
+
+// Draw one element of this frame's list. Span primitives are composited
+// together; a per-pixel one (heart, X, mouth) first flushes those below it.
+static void draw_element(pixel_t* buf, const DisplayList& dl, int e)
+{
+    SpanShape layers[MAX_SPAN_LAYERS];
+    int       n = 0;
+    for (int i = 0; i < dl.count[e]; i++) {
+        const DisplayPrim& d = dl.prims[e][i];
+        switch (d.kind) {
+        case PrimKind::RECT:
+            layers[n++] = span_rounded_rect(d.x, d.y, d.w, d.h, d.r, d.color);
+            break;
+        case PrimKind::CIRCLE:
+            layers[n++] = span_circle(d.x, d.y, d.r, d.color);
+            break;
+        case PrimKind::LID_TOP: {
+            SpanShape lid;
+            lid.kind = SpanKind::LID_TOP;
+            lid.color = d.color;
+            lid.x = d.x;
+            lid.w = d.w;
+            lid.y_min = d.y;
+            lid.y_max = d.h;
+            lid.lid_rows = s_lid_rows[e];
+            layers[n++] = lid;
+            break;
+        }
+        case PrimKind::HEART: {
+            composite_spans(buf, layers, n);
+            n = 0;
+            heart_sprite_draw(buf, d.x, d.y, static_cast<float>(d.r) * FACE_HEART_SPRITE_SIZE_STEP,
+                              static_cast<uint8_t>(d.aux[1] >> 16), static_cast<uint8_t>(d.aux[1] >> 8),
+                              static_cast<uint8_t>(d.aux[1]));
+            break;
+        }
+        case PrimKind::X_MARK:
+            composite_spans(buf, layers, n);
+            n = 0;
+            draw_x_shape(buf, d.x, d.y, d.w, d.h, d.color);
+            break;
+        case PrimKind::MOUTH:
+            composite_spans(buf, layers, n);
+            n = 0;
+            mouth_cache_draw(buf, d.mouth, static_cast<uint8_t>(d.aux[1] >> 16), static_cast<uint8_t>(d.aux[1] >> 8),
+                             static_cast<uint8_t>(d.aux[1]));
+            break;
+        }
+    }
+    composite_spans(buf, layers, n);
+}
+
+// Dim the history onto background pixels inside the glow rects, then resample
+// the history there. The rects are aligned to history cells and may overlap,
+// so every composite is done before any cell is resampled.
+static void apply_afterglow(pixel_t* buf, const FramePlan& plan)
+{
+    if (!afterglow_buf) {
+        return;
+    }
+    // Each history row is dimmed once with the span kernel, then reused for the
+    // FACE_AFTERGLOW_DOWNSAMPLE canvas rows it covers.
+    constexpr int             D = FACE_AFTERGLOW_DOWNSAMPLE;
+    constexpr uint32_t        AFTERGLOW_Q8 = px_q8_ratio(2, 5);
+    alignas(4) static pixel_t glow_row[AFTERGLOW_W];
+    const pixel_t             bg = rgb_to_color(BG_R, BG_G, BG_B);
+    for (const RectI& r : plan.glow) {
+        if (!r.valid) continue;
+        const int ax0 = r.x0 / D;
+        const int an = (r.x1 + 1) / D - ax0;
+        int       glow_ay = -1;
+        for (int y = r.y0; y <= r.y1; y++) {
+            const int      ay = y / D;
+            const pixel_t* prev = afterglow_buf + ay * AFTERGLOW_W;
+            if (ay != glow_ay) {
+                memcpy(glow_row + ax0, prev + ax0, static_cast<size_t>(an) * sizeof(pixel_t));
+                px_span_scale(glow_row + ax0, an, AFTERGLOW_Q8);
+                glow_ay = ay;
+            }
+            pixel_t* row = buf + y * SCREEN_W;
+            for (int x = r.x0; x <= r.x1; x++) {
+                const int aidx = x / D;
+                if (row[x] == bg && prev[aidx] != bg) {
+                    row[x] = glow_row[aidx];
+                }
+            }
+        }
+    }
+    for (const RectI& r : plan.glow) {
+        if (!r.valid) continue;
+        for (int ay = r.y0 / D; ay <= r.y1 / D; ay++) {
+            const pixel_t* src = buf + ay * D * SCREEN_W;
+            pixel_t*       dst = afterglow_buf + ay * AFTERGLOW_W;
+            for (int ax = r.x0 / D; ax <= r.x1 / D; ax++) {
+                dst[ax] = src[ax * D];
+            }
+        }
+    }
+}
+
+void face_render_calibration(pixel_t* buf, int touch_x, int touch_y, bool touch_active)
+{
+    const pixel_t bg = rgb_to_color(8, 8, 10);
+    const pixel_t grid = rgb_to_color(34, 34, 38);
+    const pixel_t axis = rgb_to_color(74, 74, 84);
+    const pixel_t ptt_outline = rgb_to_color(34, 180, 102);
+    const pixel_t action_outline = rgb_to_color(190, 98, 54);
+    const pixel_t ptt_fill = rgb_to_color(20, 96, 64);
+    const pixel_t action_fill = rgb_to_color(148, 78, 42);
+    const pixel_t touch = rgb_to_color(255, 228, 128);
+    const pixel_t cross = rgb_to_color(240, 250, 255);
+
+    draw_filled_rect(buf, 0, 0, SCREEN_W, SCREEN_H, bg);
+
+    for (int x = 0; x < SCREEN_W; x += 20) {
+        draw_vline(buf, x, 0, SCREEN_H - 1, (x % 40 == 0) ? axis : grid);
+    }
+    for (int y = 0; y < SCREEN_H; y += 20) {
+        draw_hline(buf, 0, SCREEN_W - 1, y, (y % 40 == 0) ? axis : grid);
+    }
+    draw_vline(buf, SCREEN_W / 2, 0, SCREEN_H - 1, rgb_to_color(120, 120, 130));
+    draw_hline(buf, 0, SCREEN_W - 1, SCREEN_H / 2, rgb_to_color(120, 120, 130));
+
+    const int hit = UI_ICON_HITBOX;
+    const int vis = UI_ICON_DIAMETER;
+    const int vis_r = vis / 2;
+    const int ptt_x = UI_ICON_MARGIN;
+    const int ptt_y = SCREEN_H - UI_ICON_MARGIN - hit;
+    const int action_x = SCREEN_W - UI_ICON_MARGIN - hit;
+    const int action_y = SCREEN_H - UI_ICON_MARGIN - hit;
+    const int ptt_cx = ptt_x + hit / 2;
+    const int ptt_cy = ptt_y + hit / 2;
+    const int action_cx = action_x + hit / 2;
+    const int action_cy = action_y + hit / 2;
+
+    draw_hline(buf, ptt_x, ptt_x + hit - 1, ptt_y, ptt_outline);
+    draw_hline(buf, ptt_x, ptt_x + hit - 1, ptt_y + hit - 1, ptt_outline);
+    draw_vline(buf, ptt_x, ptt_y, ptt_y + hit - 1, ptt_outline);
+    draw_vline(buf, ptt_x + hit - 1, ptt_y, ptt_y + hit - 1, ptt_outline);
+    draw_hline(buf, action_x, action_x + hit - 1, action_y, action_outline);
+    draw_hline(buf, action_x, action_x + hit - 1, action_y + hit - 1, action_outline);
+    draw_vline(buf, action_x, action_y, action_y + hit - 1, action_outline);
+    draw_vline(buf, action_x + hit - 1, action_y, action_y + hit - 1, action_outline);
+
+    draw_filled_circle(buf, ptt_cx, ptt_cy, vis_r, ptt_fill);
+    draw_filled_circle(buf, action_cx, action_cy, vis_r, action_fill);
+
+    if (touch_active && point_in_rect(touch_x, touch_y, ptt_x, ptt_y, hit, hit)) {
+        draw_filled_circle(buf, ptt_cx, ptt_cy, vis_r - 4, rgb_to_color(58, 214, 145));
+    }
+    if (touch_active && point_in_rect(touch_x, touch_y, action_x, action_y, hit, hit)) {
+        draw_filled_circle(buf, action_cx, action_cy, vis_r - 4, rgb_to_color(255, 140, 84));
+    }
+
+    const int tx = (touch_x < 0) ? 0 : ((touch_x >= SCREEN_W) ? (SCREEN_W - 1) : touch_x);
+    const int ty = (touch_y < 0) ? 0 : ((touch_y >= SCREEN_H) ? (SCREEN_H - 1) : touch_y);
+    draw_hline(buf, tx - 10, tx + 10, ty, cross);
+    draw_vline(buf, tx, ty - 10, ty + 10, cross);
+    draw_filled_circle(buf, tx, ty, 4, touch);
+}
+
+static RectI make_rect_xyxy(int x0, int y0, int x1, int y1)
+{
+    RectI out = {};
+    if (x1 < x0 || y1 < y0) {
+        return out;
+    }
+    if (x1 < 0 || y1 < 0 || x0 >= SCREEN_W || y0 >= SCREEN_H) {
+        return out;
+    }
+    out.x0 = (x0 < 0) ? 0 : x0;
+    out.y0 = (y0 < 0) ? 0 : y0;
+    out.x1 = (x1 >= SCREEN_W) ? (SCREEN_W - 1) : x1;
+    out.y1 = (y1 >= SCREEN_H) ? (SCREEN_H - 1) : y1;
+    out.valid = (out.x1 >= out.x0) && (out.y1 >= out.y0);
+    return out;
+}
+
+static RectI make_rect_xywh(int x, int y, int w, int h)
+{
+    if (w <= 0 || h <= 0) return {};
+    return make_rect_xyxy(x, y, x + w - 1, y + h - 1);
+}
+
+static bool rects_equal(const RectI& a, const RectI& b)
+{
+    if (!a.valid || !b.valid) return a.valid == b.valid;
+    return a.x0 == b.x0 && a.y0 == b.y0 && a.x1 == b.x1 && a.y1 == b.y1;
+}
+
+static void rect_union_inplace(RectI& a, const RectI& b)
+{
+    if (!b.valid) return;
+    if (!a.valid) {
+        a = b;
+        return;
+    }
+    if (b.x0 < a.x0) a.x0 = b.x0;
+    if (b.y0 < a.y0) a.y0 = b.y0;
+    if (b.x1 > a.x1) a.x1 = b.x1;
+    if (b.y1 > a.y1) a.y1 = b.y1;
+    a.valid = true;
+}
+
+static uint32_t rect_area(const RectI& r)
+{
+    if (!r.valid) return 0;
+    return static_cast<uint32_t>((r.x1 - r.x0 + 1) * (r.y1 - r.y0 + 1));
+}
+
+static RectI rect_intersection(const RectI& a, const RectI& b)
+{
+    if (!a.valid || !b.valid) return {};
+    RectI r;
+    r.x0 = a.x0 > b.x0 ? a.x0 : b.x0;
+    r.y0 = a.y0 > b.y0 ? a.y0 : b.y0;
+    r.x1 = a.x1 < b.x1 ? a.x1 : b.x1;
+    r.y1 = a.y1 < b.y1 ? a.y1 : b.y1;
+    r.valid = r.x0 <= r.x1 && r.y0 <= r.y1;
+    return r;
+}
+
+// Inserts rect, disjoint from every listed rect. It merges with a listed rect
+// when their bounding box pushes no more than the rects it replaces
+// (rect_cost_px each) and cuts no other rect; rects inside the box go with it.
+static void dirty_region_insert(DirtyRegion& region, RectI rect)
+{
+    for (bool merged = true; merged;) {
+        merged = false;
+        for (int i = 0; i < region.count && !merged; i++) {
+            RectI u = rect;
+            rect_union_inplace(u, region.rects[i]);
+            uint32_t separate = rect_area(rect) + rect_area(region.rects[i]) + s_dirty_policy.rect_cost_px;
+            bool     cuts = false;
+            for (int j = 0; j < region.count && !cuts; j++) {
+                if (j == i) continue;
+                const RectI inter = rect_intersection(u, region.rects[j]);
+                if (!inter.valid) continue;
+                cuts = !rects_equal(inter, region.rects[j]);
+                separate += rect_area(region.rects[j]) + s_dirty_policy.rect_cost_px;
+            }
+            if (cuts || rect_area(u) > separate) continue;
+            for (int j = region.count - 1; j >= 0; j--) {
+                if (!rect_intersection(u, region.rects[j]).valid) continue;
+                region.rects[j] = region.rects[region.count - 1];
+                region.count--;
+            }
+            rect = u;
+            merged = true;
+        }
+    }
+
+    if (region.count < s_dirty_policy.max_rects) {
+        region.rects[region.count++] = rect;
+        return;
+    }
+
+    // List full: join the rect whose box grows least; the box swallows
+    // whatever it overlaps, so the list shrinks before the re-insert.
+    int      best = 0;
+    uint32_t best_growth = UINT32_MAX;
+    for (int i = 0; i < region.count; i++) {
+        RectI u = region.rects[i];
+        rect_union_inplace(u, rect);
+        const uint32_t growth = rect_area(u) - rect_area(region.rects[i]);
+        if (growth < best_growth) {
+            best = i;
+            best_growth = growth;
+        }
+    }
+    rect_union_inplace(rect, region.rects[best]);
+    region.rects[best] = region.rects[region.count - 1];
+    region.count--;
+    for (bool grew = true; grew;) {
+        grew = false;
+        for (int j = region.count - 1; j >= 0; j--) {
+            if (!rect_intersection(rect, region.rects[j]).valid) continue;
+            rect_union_inplace(rect, region.rects[j]);
+            region.rects[j] = region.rects[region.count - 1];
+            region.count--;
+            grew = true;
+        }
+    }
+    dirty_region_insert(region, rect);
+}
+
+// Adds rect keeping the list disjoint: the part of rect under a listed rect is
+// cut away, leaving up to four bands around it that are added the same way.
+static void dirty_region_add_rect(DirtyRegion& region, RectI rect)
+{
+    if (!rect.valid || region.full) return;
+
+    for (int i = 0; i < region.count; i++) {
+        const RectI r = region.rects[i];
+        const RectI overlap = rect_intersection(r, rect);
+        if (!overlap.valid) continue;
+        const RectI pieces[4] = {
+            make_rect_xyxy(rect.x0, rect.y0, rect.x1, r.y0 - 1),       // above
+            make_rect_xyxy(rect.x0, r.y1 + 1, rect.x1, rect.y1),       // below
+            make_rect_xyxy(rect.x0, overlap.y0, r.x0 - 1, overlap.y1), // left
+            make_rect_xyxy(r.x1 + 1, overlap.y0, rect.x1, overlap.y1), // right
+        };
+        for (const RectI& piece : pieces) {
+            dirty_region_add_rect(region, piece);
+        }
+        return;
+    }
+    dirty_region_insert(region, rect);
+}
+
+// Whether region reaches any pixel of r.
+static bool dirty_region_intersects(const DirtyRegion& region, const RectI& r)
+{
+    if (!r.valid) return false;
+    if (region.full) return true;
+    for (uint8_t i = 0; i < region.count; i++) {
+        if (rect_intersection(region.rects[i], r).valid) return true;
+    }
+    return false;
+}
+
+// Whether every pixel of r is in region (listed rects never overlap).
+static bool dirty_region_covers(const DirtyRegion& region, const RectI& r)
+{
+    if (!r.valid || region.full) return true;
+    uint32_t covered = 0;
+    for (uint8_t i = 0; i < region.count; i++) {
+        covered += rect_area(rect_intersection(region.rects[i], r));
+    }
+    return covered == rect_area(r);
+}
+
+static void dirty_region_add_xywh(DirtyRegion& region, int x, int y, int w, int h)
+{
+    dirty_region_add_rect(region, make_rect_xywh(x, y, w, h));
+}
+
+static void dirty_region_add_prev_curr(DirtyRegion& region, const RectI& prev, const RectI& curr)
+{
+    if (prev.valid) dirty_region_add_rect(region, prev);
+    if (curr.valid) dirty_region_add_rect(region, curr);
+}
+
+static RectI compute_eye_bounds(const FaceState& fs, const EyeGeom& eg)
+{
+    if (!eg.visible) {
+        return {};
+    }
+
+    const float center_x = eg.center_x;
+    const float center_y = eg.center_y;
+    const float ew = eg.ew;
+    const float eh = eg.eh;
+    const float ex = eg.ex;
+    const float ey = eg.ey;
+    const float edge_pad = fs.fx.edge_glow ? 4.0f : 2.0f;
+
+    float x_min = ex - edge_pad;
+    float x_max = ex + ew + edge_pad;
+    float y_min = ey - edge_pad;
+    float y_max = ey + eh + edge_pad;
+
+    const float pupil_x = eg.pupil_x;
+    const float pupil_y = eg.pupil_y;
+    const float pupil_r = static_cast<float>(eg.pupil_r);
+
+    if (fs.solid_eye && fs.anim.heart) {
+        const float heart_r = fminf(ew, eh) * 0.5f * HEART_SOLID_SCALE;
+        x_min = fminf(x_min, center_x - heart_r - 3.0f);
+        x_max = fmaxf(x_max, center_x + heart_r + 3.0f);
+        y_min = fminf(y_min, center_y - heart_r - 3.0f);
+        y_max = fmaxf(y_max, center_y + heart_r + 3.0f);
+    } else if (fs.solid_eye && fs.anim.x_eyes) {
+        const float x_r = fminf(ew, eh) * 0.33f + 4.0f;
+        x_min = fminf(x_min, center_x - x_r);
+        x_max = fmaxf(x_max, center_x + x_r);
+        y_min = fminf(y_min, center_y - x_r);
+        y_max = fmaxf(y_max, center_y + x_r);
+    } else if (!fs.solid_eye) {
+        if (fs.anim.heart) {
+            const float heart_r = PUPIL_R * HEART_PUPIL_SCALE + 3.0f;
+            x_min = fminf(x_min, pupil_x - heart_r);
+            x_max = fmaxf(x_max, pupil_x + heart_r);
+            y_min = fminf(y_min, pupil_y - heart_r);
+            y_max = fmaxf(y_max, pupil_y + heart_r);
+        } else if (fs.anim.x_eyes) {
+            const float x_r = pupil_r + 4.0f;
+            x_min = fminf(x_min, pupil_x - x_r);
+            x_max = fmaxf(x_max, pupil_x + x_r);
+            y_min = fminf(y_min, pupil_y - x_r);
+            y_max = fmaxf(y_max, pupil_y + x_r);
+        } else {
+            const float p_r = pupil_r + 2.0f;
+            x_min = fminf(x_min, pupil_x - p_r);
+            x_max = fmaxf(x_max, pupil_x + p_r);
+            y_min = fminf(y_min, pupil_y - p_r);
+            y_max = fmaxf(y_max, pupil_y + p_r);
+        }
+    }
+
+    // Eyelid vertical strokes can extend beyond eye box.
+    const float lid_top = eg.lid_top;
+    const float lid_bot = eg.lid_bot;
+    const float slope_mag = fabsf(fs.eyelids.slope) * 20.0f;
+    const float top_limit_max = (ey - 0.5f) + eh * 2.0f * lid_top + slope_mag;
+    const float bot_limit = (ey + eh) - eh * 2.0f * lid_bot;
+    y_min = fminf(y_min, bot_limit - 1.0f);
+    y_max = fmaxf(y_max, top_limit_max + 1.0f);
+
+    return make_rect_xyxy(static_cast<int>(floorf(x_min)), static_cast<int>(floorf(y_min)),
+                          static_cast<int>(ceilf(x_max)), static_cast<int>(ceilf(y_max)));
+}
+
+static RectI compute_mouth_bounds(const RenderContext& ctx)
+{
+    if (!ctx.mouth_visible) return {};
+
+    const float cx = ctx.mouth.cx;
+    const float cy = ctx.mouth.cy;
+    const float w = ctx.mouth.half_w;
+    const float thick = ctx.mouth.thick;
+    const float curve = ctx.mouth.curve;
+    const float openness = ctx.mouth.open;
+
+    // Lip centerlines run from cy to cy + (curve -/+ openness) across the
+    // width; the pad covers the stroke plus the talking snap in mouth_cache.
+    const int x0 = static_cast<int>(floorf(cx - w - thick - 2.0f));
+    const int x1 = static_cast<int>(ceilf(cx + w + thick + 2.0f));
+    const int y0 = static_cast<int>(floorf(cy + fminf(0.0f, curve - openness) - thick - 2.0f));
+    const int y1 = static_cast<int>(ceilf(cy + fmaxf(0.0f, curve + openness) + thick + 2.0f));
+    return make_rect_xyxy(x0, y0, x1, y1);
+}
+
+static void particle_tiles_add(ParticleTiles& tiles, const RectI& r)
+{
+    if (!r.valid) return;
+    constexpr int  T = FACE_PARTICLE_TILE_PX;
+    const uint32_t cols = (2U << (r.x1 / T)) - (1U << (r.x0 / T));
+    for (int ty = r.y0 / T; ty <= r.y1 / T; ty++) tiles.rows[ty] |= cols;
+}
+
+// Sparkle and fire footprints, as particle_draw.h draws them: a pixel per
+// sparkle, a 3x3 block per fire particle.
+static void compute_particles(const FaceState& fs, PrevBoundsState& curr)
+{
+    const auto& sp = fs.fx.sparkles;
+    for (int i = 0; i < sp.count; i++) {
+        particle_tiles_add(curr.particles, make_rect_xywh(sp.x[i], sp.y[i], 1, 1));
+    }
+    const auto& fire = fs.fx.fire;
+    for (int i = 0; i < fire.count; i++) {
+        const int x = static_cast<int>(fire.x[i]);
+        const int y = static_cast<int>(fire.y[i]);
+        if (x < 0 || x >= SCREEN_W || y < 0 || y >= SCREEN_H) continue;
+        const RectI r = make_rect_xywh(x - 1, y - 1, 3, 3);
+        particle_tiles_add(curr.particles, r);
+        rect_union_inplace(curr.fire, r);
+    }
+}
+
+// Runs of set tiles become rects; a run repeated on the next tile row extends
+// the rect above it instead of starting a new one.
+static void dirty_region_add_tiles(DirtyRegion& region, const ParticleTiles& tiles)
+{
+    constexpr int MAX_RUNS = (PARTICLE_TILE_COLS + 1) / 2;
+    constexpr int T = FACE_PARTICLE_TILE_PX;
+    RectI         open[MAX_RUNS] = {};
+    int           open_count = 0;
+    for (int ty = 0; ty <= PARTICLE_TILE_ROWS; ty++) {
+        const uint32_t bits = ty < PARTICLE_TILE_ROWS ? tiles.rows[ty] : 0U;
+        RectI          next[MAX_RUNS] = {};
+        int            next_count = 0;
+        for (int tx = 0; tx < PARTICLE_TILE_COLS; tx++) {
+            if (!((bits >> tx) & 1U)) continue;
+            const int tx0 = tx;
+            while (tx + 1 < PARTICLE_TILE_COLS && ((bits >> (tx + 1)) & 1U)) tx++;
+            RectI run = make_rect_xyxy(tx0 * T, ty * T, (tx + 1) * T - 1, (ty + 1) * T - 1);
+            for (int i = 0; i < open_count; i++) {
+                if (open[i].valid && open[i].x0 == run.x0 && open[i].x1 == run.x1) {
+                    run.y0 = open[i].y0;
+                    open[i].valid = false;
+                    break;
+                }
+            }
+            next[next_count++] = run;
+        }
+        for (int i = 0; i < open_count; i++) dirty_region_add_rect(region, open[i]);
+        for (int i = 0; i < next_count; i++) open[i] = next[i];
+        open_count = next_count;
+    }
+}
+
+// Everything that may differ between a canvas holding frame `before` and the
+// frame `after` about to be drawn.
+// draw, when given, receives the display list elements to redraw: an element
+// the region reaches is added whole, because the eyes and mouth are drawn
+// whole and the mouth is blended.
+static void frame_region(DirtyRegion& region, const PrevBoundsState& before, const PrevBoundsState& after,
+                         bool* draw = nullptr)
+{
+    if (draw) {
+        for (int e = 0; e < DL_ELEMENTS; e++) draw[e] = true;
+    }
+    if (after.full || !before.valid || before.full) {
+        region.full = true;
+        return;
+    }
+
+    const RectI* element_before[DL_ELEMENTS] = {&before.eye_l, &before.eye_r, &before.mouth};
+    const RectI* element_after[DL_ELEMENTS] = {&after.eye_l, &after.eye_r, &after.mouth};
+    bool         changed[DL_ELEMENTS];
+    for (int e = 0; e < DL_ELEMENTS; e++) {
+        changed[e] = !display_element_equal(before.list, after.list, e);
+        if (changed[e]) dirty_region_add_prev_curr(region, *element_before[e], *element_after[e]);
+    }
+    for (int k = 0; k < AFTERGLOW_SHAPES; k++) {
+        dirty_region_add_prev_curr(region, before.glow[k], after.glow[k]);
+    }
+
+    ParticleTiles particles = after.particles;
+    for (int ty = 0; ty < PARTICLE_TILE_ROWS; ty++) particles.rows[ty] |= before.particles.rows[ty];
+    dirty_region_add_tiles(region, particles);
+
+    // The border band changes only with its key; inside restored rects (such
+    // as particle tiles) it is redrawn anyway. Each orbit dot adds the span it
+    // moved across.
+    const ConvBorderFootprint& b0 = before.border;
+    const ConvBorderFootprint& b1 = after.border;
+    if (b0.band != b1.band || b0.band_key != b1.band_key) {
+        const int edge = b0.band > b1.band ? b0.band : b1.band;
+        dirty_region_add_xywh(region, 0, 0, SCREEN_W, edge);
+        dirty_region_add_xywh(region, 0, SCREEN_H - edge, SCREEN_W, edge);
+        dirty_region_add_xywh(region, 0, edge, edge, SCREEN_H - 2 * edge);
+        dirty_region_add_xywh(region, SCREEN_W - edge, edge, edge, SCREEN_H - 2 * edge);
+    }
+    for (int i = 0; i < CONV_BORDER_DOTS; i++) {
+        RectI dot = b1.dots[i];
+        if (b0.dots[i].valid) {
+            if (dot.valid) {
+                rect_union_inplace(dot, b0.dots[i]);
+            } else {
+                dot = b0.dots[i];
+            }
+        }
+        dirty_region_add_rect(region, dot);
+    }
+
+    // A corner zone changes only with its key, but it is blended over what
+    // lies beneath, so once the region reaches any part of it the whole zone
+    // is restored and redrawn. On the restore side the same holds for an
+    // unchanged display list element. Each addition can reach another zone or
+    // element, so repeat until nothing grows.
+    for (int i = 0; i < 2; i++) {
+        const bool same = b0.button_key[i] == b1.button_key[i] && rects_equal(b0.buttons[i], b1.buttons[i]);
+        if (same) continue;
+        dirty_region_add_rect(region, b0.buttons[i]);
+        dirty_region_add_rect(region, b1.buttons[i]);
+    }
+    for (bool grew = true; grew;) {
+        grew = false;
+        for (int i = 0; i < 2; i++) {
+            const RectI& zone = b1.buttons[i];
+            if (!dirty_region_covers(region, zone) && dirty_region_intersects(region, zone)) {
+                dirty_region_add_rect(region, zone);
+                grew = true;
+            }
+        }
+        if (!draw) continue;
+        for (int e = 0; e < DL_ELEMENTS; e++) {
+            if (changed[e]) continue;
+            if (dirty_region_intersects(region, *element_before[e]) ||
+                dirty_region_intersects(region, *element_after[e])) {
+                dirty_region_add_prev_curr(region, *element_before[e], *element_after[e]);
+                changed[e] = true;
+                grew = true;
+            }
+        }
+    }
+    if (draw) {
+        for (int e = 0; e < DL_ELEMENTS; e++) draw[e] = changed[e];
+    }
+
+    // Rects never overlap, so past full-screen area one full pass is cheaper.
+    // An empty region is a frame with no change.
+    if (dirty_region_area(region) >= static_cast<uint32_t>(SCREEN_W * SCREEN_H)) {
+        region.full = true;
+        region.count = 0;
+    }
+}
+
+// ---- Afterglow tracking ----
+// A history cell is lit only by face pixels sampled into it, and each frame
+// scales it by 2/5, which takes any RGB565 channel to zero in
+// AFTERGLOW_FRAMES steps. So the cells that can be lit are those under the
+// bounds of the last AFTERGLOW_FRAMES frames of each shape; the rest of the
+// history is kept at background and never composited or resampled. A frame
+// that may draw outside the shape bounds (system modes) lights the
+// whole history until it has faded.
+static constexpr int AFTERGLOW_FRAMES = 5;
+
+struct AfterglowTrack {
+    RectI   shapes[AFTERGLOW_FRAMES][AFTERGLOW_SHAPES] = {};
+    bool    full[AFTERGLOW_FRAMES] = {};
+    uint8_t head = 0;
+    RectI   lit[AFTERGLOW_SHAPES] = {}; // cells possibly not background
+};
+
+static AfterglowTrack s_afterglow = {};
+
+// History state unknown: treat it as lit everywhere until it has faded.
+static void afterglow_track_reset()
+{
+    s_afterglow = {};
+    for (bool& f : s_afterglow.full) f = true;
+    s_afterglow.lit[0] = make_rect_xyxy(0, 0, SCREEN_W - 1, SCREEN_H - 1);
+}
+
+// r grown to whole history cells.
+static RectI afterglow_cells(const RectI& r)
+{
+    if (!r.valid) return r;
+    constexpr int D = FACE_AFTERGLOW_DOWNSAMPLE;
+    return make_rect_xyxy(r.x0 / D * D, r.y0 / D * D, (r.x1 / D + 1) * D - 1, (r.y1 / D + 1) * D - 1);
+}
+
+// Reset the history cells of r that lie outside every rect of keep.
+static void afterglow_clear_cells(const RectI& r, const RectI keep[AFTERGLOW_SHAPES])
+{
+    if (!r.valid) return;
+    constexpr int D = FACE_AFTERGLOW_DOWNSAMPLE;
+    const pixel_t bg = rgb_to_color(BG_R, BG_G, BG_B);
+    for (int ay = r.y0 / D; ay <= r.y1 / D; ay++) {
+        pixel_t* row = afterglow_buf + ay * AFTERGLOW_W;
+        for (int ax = r.x0 / D; ax <= r.x1 / D; ax++) {
+            // Skip over a kept span in one step; kept rects are cell-aligned.
+            int skip_to = -1;
+            for (const RectI* q = keep; q < keep + AFTERGLOW_SHAPES; q++) {
+                if (q->valid && ax * D >= q->x0 && ax * D <= q->x1 && ay * D >= q->y0 && ay * D <= q->y1) {
+                    skip_to = q->x1 / D;
+                    break;
+                }
+            }
+            if (skip_to >= 0) {
+                ax = skip_to;
+            } else {
+                row[ax] = bg;
+            }
+        }
+    }
+}
+
+// Record this frame's shape bounds and set glow to the history cells to
+// composite and resample. Cells dropping out of the tracked set have faded;
+// they are reset so the invariant holds exactly.
+static void afterglow_track(const FaceState& fs, const PrevBoundsState& curr, RectI glow[AFTERGLOW_SHAPES])
+{
+    AfterglowTrack& t = s_afterglow;
+    for (int k = 0; k < AFTERGLOW_SHAPES; k++) glow[k] = {};
+    if (!afterglow_buf) return;
+
+    if (fs.fx.afterglow) {
+        t.head = static_cast<uint8_t>((t.head + 1) % AFTERGLOW_FRAMES);
+        t.full[t.head] = curr.full;
+        t.shapes[t.head][0] = curr.eye_l;
+        t.shapes[t.head][1] = curr.eye_r;
+        t.shapes[t.head][2] = curr.mouth;
+        t.shapes[t.head][3] = curr.fire;
+
+        bool full = false;
+        for (bool f : t.full) full = full || f;
+        if (full) {
+            glow[0] = make_rect_xyxy(0, 0, SCREEN_W - 1, SCREEN_H - 1);
+        } else {
+            for (int k = 0; k < AFTERGLOW_SHAPES; k++) {
+                for (int i = 0; i < AFTERGLOW_FRAMES; i++) rect_union_inplace(glow[k], t.shapes[i][k]);
+                glow[k] = afterglow_cells(glow[k]);
+            }
+        }
+    } else {
+        // Off: drop the history, so turning it back on starts dark.
+        for (bool& f : t.full) f = false;
+        for (auto& frame : t.shapes) {
+            for (RectI& r : frame) r = {};
+        }
+    }
+
+    for (const RectI& r : t.lit) afterglow_clear_cells(r, glow);
+    for (int k = 0; k < AFTERGLOW_SHAPES; k++) t.lit[k] = glow[k];
+}
+
+static FramePlan plan_frame(const FaceState& fs, const RenderContext& ctx, const DisplayList& list)
+{
+    FramePlan      plan = {};
+    CanvasHistory& hist = s_canvas_hist[s_canvas_slot];
+
+    if (!FACE_DIRTY_RECT || FACE_CALIBRATION_MODE) {
+        plan.dirty.full = true;
+        plan.restore.full = true;
+        for (int e = 0; e < DL_ELEMENTS; e++) plan.draw[e] = true;
+        s_prev_bounds = {};
+        s_prev_bounds.valid = true;
+        s_prev_bounds.full = true;
+        afterglow_track(fs, s_prev_bounds, plan.glow);
+        hist.bounds = s_prev_bounds;
+        return plan;
+    }
+
+    PrevBoundsState curr = {};
+    curr.full = fs.system.mode != SystemMode::NONE;
+    curr.valid = true;
+    if (!curr.full) {
+        curr.eye_l = compute_eye_bounds(fs, ctx.eye_l);
+        curr.eye_r = compute_eye_bounds(fs, ctx.eye_r);
+        curr.mouth = compute_mouth_bounds(ctx);
+        curr.border = conv_border_footprint();
+        compute_particles(fs, curr);
+        curr.list = list;
+    }
+    afterglow_track(fs, curr, curr.glow);
+    for (int k = 0; k < AFTERGLOW_SHAPES; k++) plan.glow[k] = curr.glow[k];
+
+    frame_region(plan.dirty, s_prev_bounds, curr);
+    frame_region(plan.restore, hist.bounds, curr, plan.draw);
+
+    s_prev_bounds = curr;
+    hist.bounds = curr;
+    return plan;
+}
+
+static void fill_rect_clipped(pixel_t* buf, const RectI& r, pixel_t color)
+{
+    for (int y = r.y0; y <= r.y1; y++) {
+        fill_span(buf + y * SCREEN_W, r.x0, r.x1 + 1, color);
+    }
+}
+
+// Restore background under last frame's content within rows [y0, y1).
+// Returns pixels written.
+static uint32_t restore_background(pixel_t* buf, const FramePlan& plan, int y0, int y1)
+{
+    const pixel_t bg = rgb_to_color(BG_R, BG_G, BG_B);
+
+    if (plan.restore.full) {
+        const RectI band = make_rect_xyxy(0, y0, SCREEN_W - 1, y1 - 1);
+        if (band.valid) fill_rect_clipped(buf, band, bg);
+        return band.valid ? static_cast<uint32_t>(SCREEN_W * (band.y1 - band.y0 + 1)) : 0U;
+    }
+
+    uint32_t px = 0;
+    for (uint8_t i = 0; i < plan.restore.count; i++) {
+        RectI r = plan.restore.rects[i];
+        if (!r.valid) continue;
+        if (r.y0 < y0) r.y0 = y0;
+        if (r.y1 > y1 - 1) r.y1 = y1 - 1;
+        if (r.y1 < r.y0) continue;
+        fill_rect_clipped(buf, r, bg);
+        px += static_cast<uint32_t>((r.x1 - r.x0 + 1) * (r.y1 - r.y0 + 1));
+    }
+    return px;
+}
+
+uint32_t dirty_region_area(const DirtyRegion& region)
+{
+    if (region.full) {
+        return static_cast<uint32_t>(SCREEN_W * SCREEN_H);
+    }
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < region.count; i++) {
+        const RectI& r = region.rects[i];
+        if (!r.valid) continue;
+        const uint32_t w = static_cast<uint32_t>(r.x1 - r.x0 + 1);
+        const uint32_t h = static_cast<uint32_t>(r.y1 - r.y0 + 1);
+        sum += w * h;
+    }
+    return sum;
+}
+
+// ---- Band split ----
+// The eyes and the mouth only ever touch their own bounds, so when the eye
+// rects end above the mouth rect the frame splits at a row between them. Each
+// band restores its rows and draws its elements; no pixel is written by both,
+// so the result does not depend on which core finishes first. The eyes only
+// use heart_sprite and the mouth only mouth_cache, so the bands share no
+// mutable state. Everything after the barrier composites over the whole frame
+// and stays on the render core.
+
+// First row of the bottom band, or 0 when the frame cannot be split.
+static int band_split_row(const FaceState& fs, const RenderContext& ctx)
+{
+    if (!s_worker_attached) return 0;
+
+    const RectI eye_l = compute_eye_bounds(fs, ctx.eye_l);
+    const RectI eye_r = compute_eye_bounds(fs, ctx.eye_r);
+    const RectI mouth = compute_mouth_bounds(ctx);
+    int         eyes_y1 = -1;
+    if (eye_l.valid && eye_l.y1 > eyes_y1) eyes_y1 = eye_l.y1;
+    if (eye_r.valid && eye_r.y1 > eyes_y1) eyes_y1 = eye_r.y1;
+    const int mouth_y0 = mouth.valid ? mouth.y0 : SCREEN_H;
+    if (eyes_y1 + 1 > mouth_y0) return 0;
+
+    // Any row in (eyes_y1, mouth_y0] works; stay near the middle so the
+    // full-screen restore is shared evenly.
+    int split = SCREEN_H / 2;
+    if (split < eyes_y1 + 1) split = eyes_y1 + 1;
+    if (split > mouth_y0) split = mouth_y0;
+    return (split > 0 && split < SCREEN_H) ? split : 0;
+}
+
+struct TopBandJob {
+    pixel_t*           buf;
+    const DisplayList* list;
+    const FramePlan*   plan;
+    int                split_y;
+    bool               timed;
+    uint32_t           clear_px;
+    uint32_t           clear_us;
+    uint32_t           eyes_us;
+};
+
+static void draw_eyes(pixel_t* buf, const DisplayList& list, const FramePlan& plan)
+{
+    if (plan.draw[DL_EYE_L]) draw_element(buf, list, DL_EYE_L);
+    if (plan.draw[DL_EYE_R]) draw_element(buf, list, DL_EYE_R);
+}
+
+static void render_top_band(void* arg)
+{
+    TopBandJob&    job = *static_cast<TopBandJob*>(arg);
+    const uint64_t t0 = job.timed ? static_cast<uint64_t>(esp_timer_get_time()) : 0ULL;
+    job.clear_px = restore_background(job.buf, *job.plan, 0, job.split_y);
+    const uint64_t t1 = job.timed ? static_cast<uint64_t>(esp_timer_get_time()) : 0ULL;
+    draw_eyes(job.buf, *job.list, *job.plan);
+    const uint64_t t2 = job.timed ? static_cast<uint64_t>(esp_timer_get_time()) : 0ULL;
+    job.clear_us = static_cast<uint32_t>(t1 - t0);
+    job.eyes_us = static_cast<uint32_t>(t2 - t1);
+}
+
+// ---- Public API ----
+
+void face_render_init(pixel_t* afterglow, uint8_t canvases)
+{
+    afterglow_buf = afterglow;
+    afterglow_track_reset();
+    s_prev_bounds = {};
+    for (auto& h : s_canvas_hist) h = {};
+    s_canvas_count = (canvases >= 1 && canvases <= MAX_CANVASES) ? canvases : 1;
+    s_canvas_slot = 0;
+    s_stats = {};
+}
+
+void face_render_set_worker(const FaceRenderWorker* worker)
+{
+    s_worker_attached = worker && worker->start && worker->wait;
+    s_worker = s_worker_attached ? *worker : FaceRenderWorker{};
+}
+
+void face_render_set_dirty_policy(const DirtyPolicy& policy)
+{
+    s_dirty_policy = policy;
+    if (s_dirty_policy.max_rects < 1) s_dirty_policy.max_rects = 1;
+    if (s_dirty_policy.max_rects > DirtyRegion::MAX_RECTS) s_dirty_policy.max_rects = DirtyRegion::MAX_RECTS;
+}
+
+void face_render_set_system_renderer(SystemRenderer renderer)
+{
+    s_system_renderer = renderer;
+}
+
+SystemRenderer face_render_system_renderer()
+{
+    return s_system_renderer;
+}
+
+FaceRenderStats face_render_stats()
+{
+    return s_stats;
+}
+
+DirtyRegion face_render_frame(pixel_t* buf, const FaceState& fs, RenderPerfSnapshot* perf)
+{
+    uint64_t stage_start_us = perf ? static_cast<uint64_t>(esp_timer_get_time()) : 0ULL;
+    auto     sample_stage = [&](uint32_t& out_us) {
+        if (!perf) {
+            return;
+        }
+        const uint64_t now = static_cast<uint64_t>(esp_timer_get_time());
+        out_us = static_cast<uint32_t>(now - stage_start_us);
+        stage_start_us = now;
+    };
+
+    RenderPerfSnapshot scratch = {};
+    RenderPerfSnapshot& out = perf ? *perf : scratch;
+
+    // Plan first: the restore below and the caller's invalidation use the same rects.
+    const RenderContext ctx = build_render_context(fs);
+    DisplayList         list;
+    build_display_list(list, ctx, fs);
+    const FramePlan plan = plan_frame(fs, ctx, list);
+    s_stats.frames++;
+
+    // Nothing to restore means nothing changed in this canvas: its pixels are
+    // already this frame's.
+    if (!plan.restore.full && plan.restore.count == 0) {
+        s_stats.skipped++;
+        out.dirty_px = dirty_region_area(plan.dirty);
+        s_canvas_slot = static_cast<uint8_t>((s_canvas_slot + 1) % s_canvas_count);
+        return plan.dirty;
+    }
+
+    // A full-screen system screen replaces the face, its effects and the
+    // border; system modes always plan a full frame. It still feeds the
+    // afterglow, so the face fades in from it like from the system face.
+    if (fs.system.mode != SystemMode::NONE && s_system_renderer == SystemRenderer::OVERLAY_V2) {
+        render_system_overlay_v2(buf, fs, static_cast<float>(esp_timer_get_time()) / 1'000'000.0f);
+        apply_afterglow(buf, plan);
+        sample_stage(out.overlay_us);
+        out.dirty_px = dirty_region_area(plan.dirty);
+        s_canvas_slot = static_cast<uint8_t>((s_canvas_slot + 1) % s_canvas_count);
+        return plan.dirty;
+    }
+
+    const int split_y = band_split_row(fs, ctx);
+
+    // Always render face (system modes drive face state via system_face_apply)
+    if (split_y > 0) {
+        TopBandJob job = {buf, &list, &plan, split_y, perf != nullptr, 0, 0, 0};
+        s_worker.start(s_worker.ctx, render_top_band, &job);
+        const uint32_t bottom_px = restore_background(buf, plan, split_y, SCREEN_H);
+        if (plan.draw[DL_MOUTH]) draw_element(buf, list, DL_MOUTH);
+        const uint64_t wait_start_us = perf ? static_cast<uint64_t>(esp_timer_get_time()) : 0ULL;
+        s_worker.wait(s_worker.ctx);
+        if (perf) {
+            out.band_wait_us = static_cast<uint32_t>(static_cast<uint64_t>(esp_timer_get_time()) - wait_start_us);
+        }
+        sample_stage(out.mouth_us);
+        out.clear_px = job.clear_px + bottom_px;
+        out.clear_us = job.clear_us;
+        out.eyes_us = job.eyes_us;
+        out.bands = 2;
+    } else {
+        out.clear_px = restore_background(buf, plan, 0, SCREEN_H);
+        sample_stage(out.clear_us);
+
+        draw_eyes(buf, list, plan);
+        sample_stage(out.eyes_us);
+
+        if (plan.draw[DL_MOUTH]) draw_element(buf, list, DL_MOUTH);
+        sample_stage(out.mouth_us);
+    }
+
+    fire_draw(buf, fs.fx.fire);
+    // Sparkles go over the glow and stay out of the history: they land anywhere
+    // on screen, outside the tracked cells.
+    apply_afterglow(buf, plan);
+    sparkle_draw(buf, fs.fx.sparkles);
+    sample_stage(out.effects_us);
+
+    // System mode icon overlays (drawn on top of face)
+    if (fs.system.mode == SystemMode::ERROR_DISPLAY) {
+        system_face_render_error_icon(buf);
+    } else if (fs.system.mode == SystemMode::LOW_BATTERY) {
+        system_face_render_battery_icon(buf, fs.system.param);
+    } else if (fs.system.mode == SystemMode::UPDATING) {
+        system_face_render_updating_bar(buf, fs.system.param);
+    }
+    sample_stage(out.overlay_us);
+
+    // Conversation border overlay + corner buttons — suppress during system overlays (spec §4.4)
+    if (fs.system.mode == SystemMode::NONE) {
+        if (perf) {
+            const uint64_t border_start_us = static_cast<uint64_t>(esp_timer_get_time());
+            conv_border_render(buf, plan.restore);
+            const uint64_t border_frame_done_us = static_cast<uint64_t>(esp_timer_get_time());
+            conv_border_render_buttons(buf, plan.restore);
+            const uint64_t border_done_us = static_cast<uint64_t>(esp_timer_get_time());
+            out.border_frame_us = static_cast<uint32_t>(border_frame_done_us - border_start_us);
+            out.border_buttons_us = static_cast<uint32_t>(border_done_us - border_frame_done_us);
+        } else {
+            conv_border_render(buf, plan.restore);
+            conv_border_render_buttons(buf, plan.restore);
+        }
+    }
+    sample_stage(out.border_us);
+
+    out.dirty_px = dirty_region_area(plan.dirty);
+    s_canvas_slot = static_cast<uint8_t>((s_canvas_slot + 1) % s_canvas_count);
+    return plan.dirty;
+}
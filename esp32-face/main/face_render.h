@@ -0,0 +1,127 @@
+#pragma once
+// Face canvas renderer — draws eyes, mouth, effects, icons and the conversation
+// border into a SCREEN_W x SCREEN_H RGB565 buffer. No LVGL/FreeRTOS dependency so
+// the same code runs in face_ui_task and in the host benchmark (esp32-face/host).
+
+#include "config.h"
+#include "face_state.h"
+#include "pixel.h"
+
+#include <cstddef>
+#include <cstdint>
+
+constexpr int         AFTERGLOW_W = SCREEN_W / FACE_AFTERGLOW_DOWNSAMPLE;
+constexpr int         AFTERGLOW_H = SCREEN_H / FACE_AFTERGLOW_DOWNSAMPLE;
+constexpr std::size_t AFTERGLOW_BYTES = AFTERGLOW_W * AFTERGLOW_H * sizeof(pixel_t);
+
+// Inclusive pixel rectangle, clipped to the screen.
+struct RectI {
+    int  x0 = 0;
+    int  y0 = 0;
+    int  x1 = 0;
+    int  y1 = 0;
+    bool valid = false;
+};
+
+struct DirtyRegion {
+    static constexpr uint8_t MAX_RECTS = FACE_DIRTY_MAX_RECTS;
+    RectI                    rects[MAX_RECTS] = {};
+    uint8_t                  count = 0;
+    bool                     full = false;
+};
+
+// How face_render_frame merges its dirty rects. Every rect pushed to the panel
+// costs its pixels plus a fixed setup (window commands, one draw call per DMA
+// strip), rect_cost_px in pixel equivalents: two rects become their bounding
+// box when that pushes no more than both separately. Rects that touch always
+// merge, so the list never overlaps. Past max_rects (at most MAX_RECTS) a new
+// rect joins the one whose box grows least.
+struct DirtyPolicy {
+    uint8_t  max_rects = FACE_DIRTY_MAX_RECTS;
+    uint16_t rect_cost_px = FACE_DIRTY_RECT_COST_PX;
+};
+
+// What face_render_frame draws while a system mode is active.
+enum class SystemRenderer : uint8_t {
+    FACE,       // the face acts out the mode, plus a corner icon (system_face.h)
+    OVERLAY_V2, // full-screen per-mode screen (system_overlay_v2.h)
+};
+
+struct RenderPerfSnapshot {
+    uint32_t render_us = 0;
+    uint32_t clear_us = 0;
+    uint32_t eyes_us = 0;
+    uint32_t mouth_us = 0;
+    uint32_t border_us = 0;
+    uint32_t border_frame_us = 0;
+    uint32_t border_buttons_us = 0;
+    uint32_t effects_us = 0;
+    uint32_t overlay_us = 0;
+    uint32_t dirty_px = 0;
+    uint32_t clear_px = 0; // pixels restored to background this frame
+    // Band split (face_render_set_worker): the worker's top band reports
+    // clear_us and eyes_us, the render core's bottom band restore + mouth land
+    // in mouth_us, and band_wait_us is the render core's wait at the barrier.
+    uint32_t band_wait_us = 0;
+    uint8_t  bands = 1; // 2 when the frame was split across cores
+};
+
+// Cumulative counters since face_render_init; callers diff them per window.
+struct FaceRenderStats {
+    uint32_t frames = 0;
+    uint32_t skipped = 0; // frames with no display list, particle, border or glow change: nothing drawn
+};
+
+// Second render core. start() hands job(arg) to the worker and returns at
+// once; wait() blocks until that job has finished. Both are called only from
+// the thread running face_render_frame.
+struct FaceRenderWorker {
+    void* ctx = nullptr;
+    void (*start)(void* ctx, void (*job)(void* arg), void* arg) = nullptr;
+    void (*wait)(void* ctx) = nullptr;
+};
+
+// Attach the downsampled afterglow history (AFTERGLOW_W x AFTERGLOW_H, may be
+// nullptr) and reset dirty-rect tracking. Call once before the first frame.
+// canvases is how many buffers face_render_frame is called on in strict
+// rotation (1, or 2 for a double-buffered canvas); each buffer is restored
+// from what it held, while the returned region stays the change since the
+// previous frame.
+void face_render_init(pixel_t* afterglow_buf, uint8_t canvases = 1);
+
+// Attach a worker (nullptr detaches). While attached, frames whose eye and
+// mouth bounds are vertically disjoint are split at a row between them: the
+// worker restores and draws the top band (eyes) while the caller restores and
+// draws the bottom band (mouth); effects, overlays and the border follow on
+// the caller after the barrier. Output is bit-identical to the single-core
+// path. Call between frames only.
+void face_render_set_worker(const FaceRenderWorker* worker);
+
+// Replace the dirty-rect merge policy (host benchmarks; the firmware keeps the
+// config defaults). Call between frames only.
+void face_render_set_dirty_policy(const DirtyPolicy& policy);
+
+// Select the system mode renderer; the default follows FACE_SYSTEM_OVERLAY_V2.
+// Call between frames only.
+void face_render_set_system_renderer(SystemRenderer renderer);
+SystemRenderer face_render_system_renderer();
+
+// Draw one face frame into buf. The eyes and mouth are built as a display list
+// of quantized primitives and diffed against the list last drawn into buf; the
+// dirty plan is computed up front from the bounds of what changed, and only
+// those rects are restored to background and redrawn, so buf must hold the
+// pixels of the frame last drawn into it (the previous frame with a single
+// canvas). A frame with nothing to restore returns at once.
+// When perf is non-null, per-stage timings are sampled into it (render_us is
+// left to the caller). Returns the region that must be pushed to the panel:
+// empty (count 0, not full) when no pixel changed.
+DirtyRegion face_render_frame(pixel_t* buf, const FaceState& fs, RenderPerfSnapshot* perf);
+
+// Touch calibration screen (FACE_CALIBRATION_MODE only).
+void face_render_calibration(pixel_t* buf, int touch_x, int touch_y, bool touch_active);
+
+// Total pixel count covered by a dirty region (full screen when region.full,
+// 0 when empty).
+uint32_t dirty_region_area(const DirtyRegion& region);
+
+FaceRenderStats face_render_stats();
@@ -28,11 +28,21 @@ static float clampf(float v, float lo, float hi)
     return v;
 }
 
+static constexpr float ANIM_STEP_S = 1.0f / static_cast<float>(ANIM_FPS);
+
 static float tween(float current, float target, float speed)
 {
     return current + (target - current) * speed;
 }
 
+// Tween speeds are per-frame factors tuned at ANIM_FPS. Over `frames` nominal
+// frames (fractional) the same exponential approach is 1 - (1 - speed)^frames.
+static float tween_rate(float speed, float frames)
+{
+    if (frames == 1.0f) return speed;
+    return 1.0f - powf(1.0f - speed, frames);
+}
+
 static float spring_step(float current, float target, float& vel, float k = 0.25f, float d = 0.65f)
 {
     const float force = (target - current) * k;
@@ -40,20 +50,9 @@ static float spring_step(float current, float target, float& vel, float k = 0.25
     return current + vel;
 }
 
-static void clear_sparkles(FaceState& fs)
-{
-    for (auto& px : fs.fx.sparkle_pixels) {
-        px.active = false;
-        px.life = 0;
-    }
-}
-
 static void clear_fire(FaceState& fs)
 {
-    for (auto& px : fs.fx.fire_pixels) {
-        px.active = false;
-        px.life = 0.0f;
-    }
+    fs.fx.fire.count = 0;
 }
 
 static void set_active_gesture(FaceState& fs, GestureId gesture, float duration_s, float now)
@@ -127,12 +126,12 @@ static void update_boot(FaceState& fs)
     }
 }
 
-static void update_breathing(FaceState& fs)
+static void update_breathing(FaceState& fs, float dt)
 {
     if (!fs.fx.breathing) {
         return;
     }
-    fs.fx.breath_phase += fs.fx.breath_speed / static_cast<float>(ANIM_FPS);
+    fs.fx.breath_phase += fs.fx.breath_speed * dt;
     const float two_pi = 2.0f * static_cast<float>(M_PI);
     if (fs.fx.breath_phase > two_pi) {
         fs.fx.breath_phase -= two_pi;
@@ -142,36 +141,10 @@ static void update_breathing(FaceState& fs)
 static void update_sparkle(FaceState& fs)
 {
     if (!fs.fx.sparkle) {
-        clear_sparkles(fs);
+        fs.fx.sparkles.count = 0;
         return;
     }
-
-    for (auto& px : fs.fx.sparkle_pixels) {
-        if (!px.active) {
-            continue;
-        }
-        if (px.life > 0) {
-            px.life--;
-        }
-        if (px.life == 0) {
-            px.active = false;
-        }
-    }
-
-    if (randf() >= fs.fx.sparkle_chance) {
-        return;
-    }
-
-    for (auto& px : fs.fx.sparkle_pixels) {
-        if (px.active) {
-            continue;
-        }
-        px.active = true;
-        px.x = static_cast<int16_t>(rand() % SCREEN_W);
-        px.y = static_cast<int16_t>(rand() % SCREEN_H);
-        px.life = static_cast<uint8_t>(5 + (rand() % 11));
-        break;
-    }
+    sparkle_step(fs.fx.sparkles, fs.fx.sparkle_chance);
 }
 
 static void update_fire(FaceState& fs)
@@ -180,53 +153,52 @@ static void update_fire(FaceState& fs)
         clear_fire(fs);
         return;
     }
+    fire_step(fs.fx.fire);
+}
 
-    for (auto& px : fs.fx.fire_pixels) {
-        if (!px.active) {
-            continue;
-        }
-        px.x += randf_range(-1.5f, 1.5f);
-        px.y -= 3.0f;
-        px.life -= 1.0f;
-        px.heat *= 0.9f;
-        if (px.life <= 1.0f || px.y < 0.0f) {
-            px.active = false;
-        }
-    }
+static bool update_system(FaceState& fs)
+{
+    return fs.system.mode != SystemMode::NONE;
+}
 
-    if (randf() >= 0.3f) {
-        return;
-    }
+// Whole fixed steps due after dt more seconds. Rounded to nearest, so frame
+// jitter around the nominal period still gives one step per frame; the
+// remainder carries to the next update.
+static int take_fixed_steps(FaceState& fs, float dt)
+{
+    fs.anim.step_accum += dt;
+    const long steps = lroundf(fs.anim.step_accum * static_cast<float>(ANIM_FPS));
+    if (steps <= 0) return 0;
+    fs.anim.step_accum -= static_cast<float>(steps) * ANIM_STEP_S;
+    return static_cast<int>(steps);
+}
 
-    for (float cx : {LEFT_EYE_CX, RIGHT_EYE_CX}) {
-        for (auto& px : fs.fx.fire_pixels) {
-            if (px.active) {
-                continue;
-            }
-            px.active = true;
-            px.x = cx + randf_range(-20.0f, 20.0f);
-            px.y = LEFT_EYE_CY - 30.0f;
-            px.life = static_cast<float>(5 + (rand() % 11));
-            px.heat = 1.0f;
-            break;
-        }
+static void update_effects(FaceState& fs, int steps)
+{
+    for (int i = 0; i < steps; i++) {
+        update_sparkle(fs);
+        update_fire(fs);
     }
 }
 
-static bool update_system(FaceState& fs)
+float anim_clock_tick(AnimClock& clock, int64_t now_us)
 {
-    return fs.system.mode != SystemMode::NONE;
+    const int64_t last_us = clock.last_us;
+    clock.last_us = now_us;
+    if (last_us < 0) return ANIM_STEP_S;
+    const float dt = static_cast<float>(now_us - last_us) / 1'000'000.0f;
+    return clampf(dt, 0.0f, ANIM_DT_MAX_S);
 }
 
-void face_state_update(FaceState& fs)
+void face_state_update(FaceState& fs, float dt)
 {
     const float now = now_s();
-    const float dt = 1.0f / static_cast<float>(ANIM_FPS);
+    const float frames = dt * static_cast<float>(ANIM_FPS);
+    const int   steps = take_fixed_steps(fs, dt);
 
     if (update_system(fs)) {
-        update_breathing(fs);
-        update_sparkle(fs);
-        update_fire(fs);
+        update_breathing(fs, dt);
+        update_effects(fs, steps);
         if (fs.active_gesture != 0xFF && now > fs.active_gesture_until) {
             fs.active_gesture = 0xFF;
         }
@@ -238,9 +210,8 @@ void face_state_update(FaceState& fs)
             fs.fx.boot_timer = now;
         }
         update_boot(fs);
-        update_breathing(fs);
-        update_sparkle(fs);
-        update_fire(fs);
+        update_breathing(fs, dt);
+        update_effects(fs, steps);
         if (fs.active_gesture != 0xFF && now > fs.active_gesture_until) {
             fs.active_gesture = 0xFF;
         }
@@ -586,11 +557,11 @@ void face_state_update(FaceState& fs)
     const float speed_l = (final_top_l > fs.eyelids.top_l) ? 0.6f : 0.4f;
     const float speed_r = (final_top_r > fs.eyelids.top_r) ? 0.6f : 0.4f;
 
-    fs.eyelids.top_l = tween(fs.eyelids.top_l, final_top_l, speed_l);
-    fs.eyelids.top_r = tween(fs.eyelids.top_r, final_top_r, speed_r);
-    fs.eyelids.bottom_l = tween(fs.eyelids.bottom_l, t_lid_bot, 0.3f);
-    fs.eyelids.bottom_r = tween(fs.eyelids.bottom_r, t_lid_bot, 0.3f);
-    fs.eyelids.slope = tween(fs.eyelids.slope, fs.eyelids.slope_target, 0.3f);
+    fs.eyelids.top_l = tween(fs.eyelids.top_l, final_top_l, tween_rate(speed_l, frames));
+    fs.eyelids.top_r = tween(fs.eyelids.top_r, final_top_r, tween_rate(speed_r, frames));
+    fs.eyelids.bottom_l = tween(fs.eyelids.bottom_l, t_lid_bot, tween_rate(0.3f, frames));
+    fs.eyelids.bottom_r = tween(fs.eyelids.bottom_r, t_lid_bot, tween_rate(0.3f, frames));
+    fs.eyelids.slope = tween(fs.eyelids.slope, fs.eyelids.slope_target, tween_rate(0.3f, frames));
 
     if (fs.anim.idle && now >= fs.anim.next_idle) {
         const float target_x = randf_range(-MAX_GAZE, MAX_GAZE);
@@ -654,25 +625,28 @@ void face_state_update(FaceState& fs)
         fs.eye_r.height_scale_target += bounce;
     }
 
-    fs.eye_l.gaze_x = spring_step(fs.eye_l.gaze_x, fs.eye_l.gaze_x_target, fs.eye_l.vx);
-    fs.eye_l.gaze_y = spring_step(fs.eye_l.gaze_y, fs.eye_l.gaze_y_target, fs.eye_l.vy);
-    fs.eye_r.gaze_x = spring_step(fs.eye_r.gaze_x, fs.eye_r.gaze_x_target, fs.eye_r.vx);
-    fs.eye_r.gaze_y = spring_step(fs.eye_r.gaze_y, fs.eye_r.gaze_y_target, fs.eye_r.vy);
+    // The spring constants are per-step, so the springs advance in fixed steps.
+    for (int i = 0; i < steps; i++) {
+        fs.eye_l.gaze_x = spring_step(fs.eye_l.gaze_x, fs.eye_l.gaze_x_target, fs.eye_l.vx);
+        fs.eye_l.gaze_y = spring_step(fs.eye_l.gaze_y, fs.eye_l.gaze_y_target, fs.eye_l.vy);
+        fs.eye_r.gaze_x = spring_step(fs.eye_r.gaze_x, fs.eye_r.gaze_x_target, fs.eye_r.vx);
+        fs.eye_r.gaze_y = spring_step(fs.eye_r.gaze_y, fs.eye_r.gaze_y_target, fs.eye_r.vy);
+    }
 
     for (EyeState* eye : {&fs.eye_l, &fs.eye_r}) {
-        eye->width_scale = tween(eye->width_scale, eye->width_scale_target, 0.2f);
-        eye->height_scale = tween(eye->height_scale, eye->height_scale_target, 0.2f);
+        eye->width_scale = tween(eye->width_scale, eye->width_scale_target, tween_rate(0.2f, frames));
+        eye->height_scale = tween(eye->height_scale, eye->height_scale_target, tween_rate(0.2f, frames));
         eye->openness_target = eye->is_open ? 1.0f : 0.0f;
-        eye->openness = tween(eye->openness, eye->openness_target, 0.4f);
+        eye->openness = tween(eye->openness, eye->openness_target, tween_rate(0.4f, frames));
         eye->width_scale_target = 1.0f;
         eye->height_scale_target = 1.0f;
     }
 
-    fs.mouth_curve = tween(fs.mouth_curve, fs.mouth_curve_target, 0.2f);
-    fs.mouth_open = tween(fs.mouth_open, fs.mouth_open_target, 0.4f);
-    fs.mouth_width = tween(fs.mouth_width, fs.mouth_width_target, 0.2f);
-    fs.mouth_offset_x = tween(fs.mouth_offset_x, fs.mouth_offset_x_target, 0.2f);
-    fs.mouth_wave = tween(fs.mouth_wave, fs.mouth_wave_target, 0.1f);
+    fs.mouth_curve = tween(fs.mouth_curve, fs.mouth_curve_target, tween_rate(0.2f, frames));
+    fs.mouth_open = tween(fs.mouth_open, fs.mouth_open_target, tween_rate(0.4f, frames));
+    fs.mouth_width = tween(fs.mouth_width, fs.mouth_width_target, tween_rate(0.2f, frames));
+    fs.mouth_offset_x = tween(fs.mouth_offset_x, fs.mouth_offset_x_target, tween_rate(0.2f, frames));
+    fs.mouth_wave = tween(fs.mouth_wave, fs.mouth_wave_target, tween_rate(0.1f, frames));
 
     if (fs.anim.h_flicker) {
         const float dx = fs.anim.h_flicker_alt ? fs.anim.h_flicker_amp : -fs.anim.h_flicker_amp;
@@ -702,9 +676,8 @@ void face_state_update(FaceState& fs)
         fs.eye_r.gaze_x = gx;
     }
 
-    update_breathing(fs);
-    update_sparkle(fs);
-    update_fire(fs);
+    update_breathing(fs, dt);
+    update_effects(fs, steps);
 
     if (fs.active_gesture != 0xFF && now > fs.active_gesture_until) {
         fs.active_gesture = 0xFF;
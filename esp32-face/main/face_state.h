@@ -3,6 +3,7 @@
 // Behavior is aligned with tools/face_state_v2.py.
 
 #include "config.h"
+#include "particles.h"
 #include <cstdint>
 
 // ---- Enums ----
@@ -137,6 +138,9 @@ struct AnimTimers {
     bool  v_flicker = false;
     bool  v_flicker_alt = false;
     float v_flicker_amp = 1.5f;
+
+    // Update time not yet run as fixed 1/ANIM_FPS steps (springs, particles)
+    float step_accum = 0.0f;
 };
 
 // ---- Effects state (display-agnostic) ----
@@ -144,21 +148,6 @@ struct AnimTimers {
 constexpr int MAX_SPARKLE_PIXELS = 48;
 constexpr int MAX_FIRE_PIXELS = 64;
 
-struct SparklePixel {
-    int16_t x = 0;
-    int16_t y = 0;
-    uint8_t life = 0;
-    bool    active = false;
-};
-
-struct FirePixel {
-    float x = 0.0f;
-    float y = 0.0f;
-    float life = 0.0f;
-    float heat = 0.0f;
-    bool  active = false;
-};
-
 struct EffectsState {
     // Breathing
     bool  breathing = true;
@@ -171,15 +160,17 @@ struct EffectsState {
     float boot_timer = 0.0f;
     int   boot_phase = 0;
 
-    bool         sparkle = true;
-    float        sparkle_chance = 0.05f;
-    SparklePixel sparkle_pixels[MAX_SPARKLE_PIXELS]{};
+    bool                            sparkle = true;
+    float                           sparkle_chance = 0.05f;
+    SparklePool<MAX_SPARKLE_PIXELS> sparkles{};
 
     bool  afterglow = true;
     bool  edge_glow = true;
     float edge_glow_falloff = 0.4f;
 
-    FirePixel fire_pixels[MAX_FIRE_PIXELS]{};
+    uint8_t shed = 0; // QualityShed bits turned off by the quality governor
+
+    FirePool<MAX_FIRE_PIXELS> fire{};
 };
 
 // ---- System display state ----
@@ -234,9 +225,24 @@ struct FaceState {
     uint8_t color_override_b = 0;
 };
 
+// ---- Animation clock ----
+
+// Frame time for face_state_update / conv_border_update, measured instead of
+// assumed. The first tick returns one nominal frame (1 / ANIM_FPS); later
+// ticks the time since the previous one, clamped to ANIM_DT_MAX_S so a long
+// stall resumes the animation instead of jumping it ahead.
+struct AnimClock {
+    int64_t last_us = -1;
+};
+
+float anim_clock_tick(AnimClock& clock, int64_t now_us);
+
 // ---- API ----
 
-void  face_state_update(FaceState& fs);
+// Advance the face by dt seconds. Tweens and the breath scale with dt; the
+// gaze springs, sparkles and fire run in fixed 1/ANIM_FPS steps, as many as
+// dt covers, so every frame rate follows the same trajectory.
+void  face_state_update(FaceState& fs, float dt);
 float face_get_breath_scale(const FaceState& fs);
 void  face_get_emotion_color(const FaceState& fs, uint8_t& r, uint8_t& g, uint8_t& b);
 
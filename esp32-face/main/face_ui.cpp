@@ -3,8 +3,12 @@
 #include "shared_state.h"
 #include "conv_border.h"
 #include "display.h"
+#include "face_render.h"
 #include "led.h"
+#include "mouth_cache.h"
+#include "panel_present.h"
 #include "protocol.h"
+#include "quality_governor.h"
 #include "touch.h"
 #include "system_face.h"
 #include "system_overlay_v2.h"
@@ -15,8 +19,10 @@
 #include "esp_timer.h"
 
 #include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "freertos/task.h"
 
+#include <atomic>
 #include <cmath>
 #include <cstddef>
 #include <cstdio>
@@ -25,23 +31,19 @@
 
 static const char*        TAG = "face_ui";
 static constexpr uint32_t TALKING_CMD_TIMEOUT_MS = 450;
-static constexpr uint8_t  BG_R = 0;
-static constexpr uint8_t  BG_G = 0;
-static constexpr uint8_t  BG_B = 0;
+// Frame deadlines are kept in esp_timer microseconds and slept on with a
+// one-shot esp_timer, so the FACE_FRAME_BUDGET_US period does not depend on
+// the FreeRTOS tick (100 Hz would round 33 ms to 30 ms).
+static constexpr int64_t PACE_OVERRUN_YIELD_US = 1000; // after an overrun, before the next frame
 // Canvas uses RGB565 to match the ILI9341 display format (no conversion needed).
 static constexpr lv_color_format_t CANVAS_COLOR_FORMAT = LV_COLOR_FORMAT_RGB565;
 static constexpr std::size_t       CANVAS_BYTES = SCREEN_W * SCREEN_H * sizeof(pixel_t);
-static constexpr int               AFTERGLOW_W = SCREEN_W / FACE_AFTERGLOW_DOWNSAMPLE;
-static constexpr int               AFTERGLOW_H = SCREEN_H / FACE_AFTERGLOW_DOWNSAMPLE;
-static constexpr std::size_t       AFTERGLOW_BYTES = AFTERGLOW_W * AFTERGLOW_H * sizeof(pixel_t);
 
 static float now_s();
-static float clampf(float v, float lo, float hi);
-static float smoothstepf(float edge0, float edge1, float x);
 
 // ---- LVGL objects ----
-static lv_obj_t* canvas_obj = nullptr;
-static pixel_t*  canvas_buf = nullptr;
+static lv_obj_t* canvas_obj = nullptr; // lv_canvas, or a bare touch layer with direct present
+static pixel_t*  canvas_bufs[FACE_CANVAS_BUFFERS] = {};
 static pixel_t*  afterglow_buf = nullptr;
 static lv_obj_t* calib_header_bg = nullptr;
 static lv_obj_t* calib_label_touch = nullptr;
@@ -53,482 +55,89 @@ static int     s_last_touch_y = SCREEN_H / 2;
 static uint8_t s_last_touch_evt = 0xFF;
 static bool    s_last_touch_active = false;
 
-struct RectI {
-    int  x0 = 0;
-    int  y0 = 0;
-    int  x1 = 0;
-    int  y1 = 0;
-    bool valid = false;
-};
-
-struct DirtyRegion {
-    static constexpr uint8_t MAX_RECTS = 8;
-    RectI                    rects[MAX_RECTS] = {};
-    uint8_t                  count = 0;
-    bool                     full = false;
-};
-
-struct PrevBoundsState {
-    RectI eye_l = {};
-    RectI eye_r = {};
-    RectI mouth = {};
-    RectI border = {};
-    RectI btn_left = {};
-    RectI btn_right = {};
-    bool  full = false;
-    bool  valid = false;
-};
-
-struct RenderPerfSnapshot {
-    uint32_t render_us = 0;
-    uint32_t eyes_us = 0;
-    uint32_t mouth_us = 0;
-    uint32_t border_us = 0;
-    uint32_t border_frame_us = 0;
-    uint32_t border_buttons_us = 0;
-    uint32_t effects_us = 0;
-    uint32_t overlay_us = 0;
-    uint32_t dirty_px = 0;
-};
+static esp_timer_handle_t s_pace_timer = nullptr;
+static SemaphoreHandle_t  s_pace_sem = nullptr;
 
 static RenderPerfSnapshot s_last_render_perf = {};
+static uint32_t           s_last_overlap_us = 0;
 static bool               s_collect_render_perf = false;
-static PrevBoundsState    s_prev_bounds = {};
-
-static void        publish_touch_sample(uint8_t event_type, int x, int y);
-static void        publish_button_event(FaceButtonId button_id, FaceButtonEventType event_type, uint8_t state);
-static void        root_touch_event_cb(lv_event_t* e);
-static void        render_calibration(pixel_t* buf);
-static void        update_calibration_labels(uint32_t now_ms, uint32_t next_switch_ms);
-static void        afterglow_copy_from_canvas(const pixel_t* canvas);
-static DirtyRegion compute_dirty_region(const FaceState& fs);
-static uint32_t    dirty_region_area(const DirtyRegion& region);
-
-static float clampf(float v, float lo, float hi)
-{
-    if (v < lo) return lo;
-    if (v > hi) return hi;
-    return v;
-}
-
-static float smoothstepf(float edge0, float edge1, float x)
-{
-    if (fabsf(edge1 - edge0) < 1e-6f) {
-        return x < edge0 ? 0.0f : 1.0f;
-    }
-    const float t = clampf((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
-    return t * t * (3.0f - 2.0f * t);
-}
 
-// ---- Drawing helpers (RGB565 pixel_t) ----
-
-static pixel_t rgb_to_color(uint8_t r, uint8_t g, uint8_t b)
-{
-    return px_rgb(r, g, b);
-}
-
-static pixel_t scale_color(pixel_t c, uint8_t num, uint8_t den)
-{
-    return px_scale(c, num, den);
-}
-
-static void draw_filled_rect(pixel_t* buf, int x, int y, int w, int h, pixel_t color)
-{
-    for (int dy = 0; dy < h; dy++) {
-        int py = y + dy;
-        if (py < 0 || py >= SCREEN_H) continue;
-        for (int dx = 0; dx < w; dx++) {
-            int px = x + dx;
-            if (px < 0 || px >= SCREEN_W) continue;
-            buf[py * SCREEN_W + px] = color;
-        }
-    }
-}
-
-static void draw_hline(pixel_t* buf, int x0, int x1, int y, pixel_t color)
-{
-    const int x_lo = (x0 < x1) ? x0 : x1;
-    const int x_hi = (x0 < x1) ? x1 : x0;
-    draw_filled_rect(buf, x_lo, y, x_hi - x_lo + 1, 1, color);
-}
-
-static void draw_vline(pixel_t* buf, int x, int y0, int y1, pixel_t color)
-{
-    const int y_lo = (y0 < y1) ? y0 : y1;
-    const int y_hi = (y0 < y1) ? y1 : y0;
-    draw_filled_rect(buf, x, y_lo, 1, y_hi - y_lo + 1, color);
-}
-
-static bool point_in_rect(int x, int y, int rx, int ry, int rw, int rh)
-{
-    return (x >= rx && x < (rx + rw) && y >= ry && y < (ry + rh));
-}
-
-static void draw_filled_rounded_rect(pixel_t* buf, int x, int y, int w, int h, int radius, pixel_t color)
-{
-    const int r2 = radius * radius;
-    for (int dy = 0; dy < h; dy++) {
-        int py = y + dy;
-        if (py < 0 || py >= SCREEN_H) continue;
-        for (int dx = 0; dx < w; dx++) {
-            int px = x + dx;
-            if (px < 0 || px >= SCREEN_W) continue;
-
-            bool inside = true;
-            if (dx < radius && dy < radius) {
-                int ddx = radius - dx, ddy = radius - dy;
-                if (ddx * ddx + ddy * ddy > r2) inside = false;
-            } else if (dx >= w - radius && dy < radius) {
-                int ddx = dx - (w - radius - 1), ddy = radius - dy;
-                if (ddx * ddx + ddy * ddy > r2) inside = false;
-            } else if (dx < radius && dy >= h - radius) {
-                int ddx = radius - dx, ddy = dy - (h - radius - 1);
-                if (ddx * ddx + ddy * ddy > r2) inside = false;
-            } else if (dx >= w - radius && dy >= h - radius) {
-                int ddx = dx - (w - radius - 1), ddy = dy - (h - radius - 1);
-                if (ddx * ddx + ddy * ddy > r2) inside = false;
-            }
+// ---- Canvas pipeline ----
+// With two canvases face_ui_render draws the back buffer while the front one
+// is being presented. Direct present (panel_present.cpp) pushes the dirty
+// rects straight to the panel from the present task and needs no LVGL lock;
+// LVGL then only owns the touch layer. Otherwise LVGL refreshes from the
+// front canvas and face_ui_present swaps under the lock, and with one canvas
+// both steps run under the lock on the same buffer.
+static uint8_t       s_canvas_count = 0;
+static uint8_t       s_canvas_back = 0; // index face_ui_render draws into
+static DirtyRegion   s_pending_dirty = {};
+static bool          s_pending = false;
+static FacePresenter s_presenter = {};
+static bool          s_direct = false;
 
-            if (inside) {
-                buf[py * SCREEN_W + px] = color;
-            }
-        }
-    }
-}
-
-static void draw_filled_circle(pixel_t* buf, int cx, int cy, int radius, pixel_t color)
-{
-    int r2 = radius * radius;
-    for (int dy = -radius; dy <= radius; dy++) {
-        int py = cy + dy;
-        if (py < 0 || py >= SCREEN_H) continue;
-        for (int dx = -radius; dx <= radius; dx++) {
-            int px = cx + dx;
-            if (px < 0 || px >= SCREEN_W) continue;
-            if (dx * dx + dy * dy <= r2) {
-                buf[py * SCREEN_W + px] = color;
-            }
-        }
-    }
-}
-
-// ---- Face rendering ----
-
-static float sd_heart(float px, float py, float cx, float cy, float size)
-{
-    const float x = fabsf(px - cx) / size;
-    const float y = (cy - py) / size + 0.5f;
-
-    float d = 0.0f;
-    if (y + x > 1.0f) {
-        const float dx = x - 0.25f;
-        const float dy = y - 0.75f;
-        d = sqrtf(dx * dx + dy * dy) - 0.35355339f;
-    } else {
-        const float dy1 = y - 1.0f;
-        const float d1 = x * x + dy1 * dy1;
-        const float t = fmaxf(x + y, 0.0f) * 0.5f;
-        const float dx2 = x - t;
-        const float dy2 = y - t;
-        const float d2 = dx2 * dx2 + dy2 * dy2;
-        d = sqrtf(fminf(d1, d2));
-        if (x < y) {
-            d = -d;
-        }
-    }
-
-    return d * size;
-}
-
-static void draw_heart_shape(pixel_t* buf, float cx, float cy, float size, uint8_t r, uint8_t g, uint8_t b)
-{
-    if (size < 1.0f) {
-        return;
-    }
-    const int x0 = static_cast<int>(fmaxf(0.0f, cx - size - 2.0f));
-    const int x1 = static_cast<int>(fminf(static_cast<float>(SCREEN_W), cx + size + 2.0f));
-    const int y0 = static_cast<int>(fmaxf(0.0f, cy - size - 2.0f));
-    const int y1 = static_cast<int>(fminf(static_cast<float>(SCREEN_H), cy + size + 2.0f));
-
-    for (int y = y0; y < y1; y++) {
-        const int row = y * SCREEN_W;
-        for (int x = x0; x < x1; x++) {
-            const float d = sd_heart(static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f, cx, cy, size);
-            const float a = 1.0f - smoothstepf(-0.5f, 0.5f, d);
-            if (a > 0.01f) {
-                buf[row + x] = px_blend(buf[row + x], r, g, b, a);
-            }
-        }
-    }
-}
-
-static void draw_x_shape(pixel_t* buf, int cx, int cy, int size, int thick, pixel_t color)
-{
-    for (int y = cy - size; y <= cy + size; y++) {
-        if (y < 0 || y >= SCREEN_H) continue;
-        for (int x = cx - size; x <= cx + size; x++) {
-            if (x < 0 || x >= SCREEN_W) continue;
-            const int dx = x - cx;
-            const int dy = y - cy;
-            if (abs(dx + dy) <= thick || abs(dx - dy) <= thick) {
-                buf[y * SCREEN_W + x] = color;
-            }
-        }
-    }
-}
+// Display refresh windows (LV_EVENT_REFR_START .. READY), written by the LVGL
+// task. busy_us accumulates closed windows; an open one counts from start_us.
+static std::atomic<bool>     s_refr_active{false};
+static std::atomic<uint32_t> s_refr_start_us{0};
+static std::atomic<uint32_t> s_refr_busy_us{0};
 
-static void render_eye(pixel_t* buf, const EyeState& eye, const FaceState& fs, bool is_left, float center_x,
-                       float center_y)
+static uint32_t refresh_busy_at(uint32_t now_us)
 {
-    uint8_t r, g, b;
-    face_get_emotion_color(fs, r, g, b);
-    pixel_t eye_color = rgb_to_color(r, g, b);
-    pixel_t black = rgb_to_color(0, 0, 0);
-
-    const float breath = face_get_breath_scale(fs);
-    const float ew = EYE_WIDTH * eye.width_scale * breath;
-    const float eh = EYE_HEIGHT * eye.height_scale * fmaxf(0.25f, eye.openness) * breath;
-    if (eh < 2.0f) {
-        return;
-    }
-
-    const float ex = center_x + eye.gaze_x * GAZE_EYE_SHIFT - ew / 2.0f;
-    const float ey = center_y + eye.gaze_y * GAZE_EYE_SHIFT - eh / 2.0f;
-    const int   corner = static_cast<int>(EYE_CORNER_R * fminf(eye.width_scale, eye.height_scale));
-
-    if (fs.solid_eye && fs.anim.heart) {
-        draw_heart_shape(buf, center_x, center_y, fminf(ew, eh) * 0.5f * HEART_SOLID_SCALE, r, g, b);
-    } else if (fs.solid_eye && fs.anim.x_eyes) {
-        draw_x_shape(buf, static_cast<int>(center_x), static_cast<int>(center_y),
-                     static_cast<int>(fminf(ew, eh) * 0.33f), 3, eye_color);
-    } else {
-        if (fs.fx.edge_glow) {
-            const pixel_t glow = scale_color(eye_color, 2, 5);
-            draw_filled_rounded_rect(buf, static_cast<int>(ex) - 2, static_cast<int>(ey) - 2, static_cast<int>(ew) + 4,
-                                     static_cast<int>(eh) + 4, corner + 2, glow);
-        }
-        draw_filled_rounded_rect(buf, static_cast<int>(ex), static_cast<int>(ey), static_cast<int>(ew),
-                                 static_cast<int>(eh), corner, eye_color);
-    }
-
-    if (!fs.solid_eye) {
-        const float max_offset_x = fmaxf(0.0f, ew * 0.5f - PUPIL_R - 5.0f);
-        const float max_offset_y = fmaxf(0.0f, eh * 0.5f - PUPIL_R - 5.0f);
-        const float px = center_x + clampf(eye.gaze_x * GAZE_PUPIL_SHIFT, -max_offset_x, max_offset_x);
-        const float py = center_y + clampf(eye.gaze_y * GAZE_PUPIL_SHIFT, -max_offset_y, max_offset_y);
-        const int   pr = static_cast<int>(PUPIL_R * fmaxf(0.4f, eye.openness));
-        if (fs.anim.heart) {
-            draw_heart_shape(buf, px, py, PUPIL_R * HEART_PUPIL_SCALE, 10, 15, 30);
-        } else if (fs.anim.x_eyes) {
-            draw_x_shape(buf, static_cast<int>(px), static_cast<int>(py), pr, 2, rgb_to_color(10, 15, 30));
-        } else if (pr > 1) {
-            draw_filled_circle(buf, static_cast<int>(px), static_cast<int>(py), pr, rgb_to_color(10, 15, 30));
-        }
-    }
-
-    // V2 eyelid model: top/bottom coverage + diagonal slope.
-    const float lid_top = is_left ? fs.eyelids.top_l : fs.eyelids.top_r;
-    const float lid_bot = is_left ? fs.eyelids.bottom_l : fs.eyelids.bottom_r;
-    const float slope = fs.eyelids.slope;
-    const int   x0 = static_cast<int>(ex);
-    const int   x1 = static_cast<int>(ex + ew);
-    const int   y0 = static_cast<int>(ey);
-    const int   y1 = static_cast<int>(ey + eh);
-
-    for (int x = x0; x < x1; x++) {
-        if (x < 0 || x >= SCREEN_W) continue;
-        float nx = (static_cast<float>(x) - (ex + ew * 0.5f)) / fmaxf(1.0f, ew * 0.5f);
-        if (!is_left) {
-            nx = -nx;
-        }
-        const float slope_off = slope * 20.0f * nx;
-        const int   top_limit = static_cast<int>((ey - 0.5f) + eh * 2.0f * lid_top + slope_off);
-        const int   bot_limit = static_cast<int>((ey + eh) - eh * 2.0f * lid_bot);
-
-        if (top_limit > y0) {
-            draw_vline(buf, x, y0, top_limit, black);
-        }
-        if (bot_limit < y1) {
-            draw_vline(buf, x, bot_limit, y1, black);
-        }
+    uint32_t busy = s_refr_busy_us.load(std::memory_order_acquire);
+    if (s_refr_active.load(std::memory_order_acquire)) {
+        busy += now_us - s_refr_start_us.load(std::memory_order_relaxed);
     }
+    return busy;
 }
 
-static void render_mouth(pixel_t* buf, const FaceState& fs)
+// Time the display path has spent pushing frames, whichever path is live.
+static uint32_t display_busy_at(uint32_t now_us)
 {
-    if (!fs.show_mouth) return;
-
-    uint8_t r, g, b;
-    face_get_emotion_color(fs, r, g, b);
-
-    const float cx = MOUTH_CX + fs.mouth_offset_x * 10.0f;
-    const float cy = MOUTH_CY;
-    const float w = MOUTH_HALF_W * fs.mouth_width;
-    const float thick = MOUTH_THICKNESS;
-    const float curve = fs.mouth_curve * 40.0f;
-    const float openness = fs.mouth_open * 40.0f;
-    if (w < 1.0f) {
-        return;
-    }
-
-    const int   x0 = static_cast<int>(cx - w - thick);
-    const int   x1 = static_cast<int>(cx + w + thick);
-    const int   y0 = static_cast<int>(cy - fabsf(curve) - openness - thick);
-    const int   y1 = static_cast<int>(cy + fabsf(curve) + openness + thick);
-    const float half_thick = thick * 0.5f;
-
-    for (int y = (y0 < 0 ? 0 : y0); y < (y1 > SCREEN_H ? SCREEN_H : y1); y++) {
-        const int row = y * SCREEN_W;
-        for (int x = (x0 < 0 ? 0 : x0); x < (x1 > SCREEN_W ? SCREEN_W : x1); x++) {
-            const float px = static_cast<float>(x) + 0.5f;
-            const float py = static_cast<float>(y) + 0.5f;
-            const float nx = (px - cx) / w;
-            if (fabsf(nx) > 1.0f) continue;
-
-            const float shape = 1.0f - nx * nx;
-            const float curve_y = curve * shape;
-            const float upper_y = cy + curve_y - openness * shape;
-            const float lower_y = cy + curve_y + openness * shape;
-
-            float dist = 0.0f;
-            if (openness > 1.0f && upper_y < py && py < lower_y) {
-                dist = 0.0f;
-            } else {
-                dist = fminf(fabsf(py - upper_y), fabsf(py - lower_y));
-            }
-
-            const float alpha = 1.0f - smoothstepf(half_thick - 1.0f, half_thick + 1.0f, dist);
-            if (alpha > 0.01f) {
-                buf[row + x] = px_blend(buf[row + x], r, g, b, alpha);
-            }
-        }
-    }
+    return s_direct ? panel_present_busy_us(now_us) : refresh_busy_at(now_us);
 }
 
-static void render_fire_effect(pixel_t* buf, const FaceState& fs)
+static void display_refr_event_cb(lv_event_t* e)
 {
-    for (const auto& px : fs.fx.fire_pixels) {
-        if (!px.active || px.life <= 0.0f) continue;
-        int x = static_cast<int>(px.x);
-        int y = static_cast<int>(px.y);
-        if (x < 0 || x >= SCREEN_W || y < 0 || y >= SCREEN_H) continue;
-        pixel_t c;
-        if (px.heat > 0.85f)
-            c = rgb_to_color(255, 220, 120);
-        else if (px.heat > 0.65f)
-            c = rgb_to_color(255, 140, 20);
-        else if (px.heat > 0.40f)
-            c = rgb_to_color(220, 50, 0);
-        else
-            c = rgb_to_color(130, 20, 0);
-        draw_filled_rect(buf, x - 1, y - 1, 3, 3, c);
+    const uint32_t now_us = static_cast<uint32_t>(esp_timer_get_time());
+    if (lv_event_get_code(e) == LV_EVENT_REFR_START) {
+        s_refr_start_us.store(now_us, std::memory_order_relaxed);
+        s_refr_active.store(true, std::memory_order_release);
+    } else if (s_refr_active.load(std::memory_order_relaxed)) {
+        const uint32_t start_us = s_refr_start_us.load(std::memory_order_relaxed);
+        s_refr_busy_us.fetch_add(now_us - start_us, std::memory_order_release);
+        s_refr_active.store(false, std::memory_order_release);
     }
 }
 
-static void render_sparkles(pixel_t* buf, const FaceState& fs)
-{
-    for (const auto& sp : fs.fx.sparkle_pixels) {
-        if (!sp.active || sp.life == 0) continue;
-        if (sp.x < 0 || sp.x >= SCREEN_W || sp.y < 0 || sp.y >= SCREEN_H) continue;
-        buf[sp.y * SCREEN_W + sp.x] = rgb_to_color(255, 255, 255);
-    }
-}
+// ---- Render worker ----
+// face_render_frame hands its top band to face_render_worker_task. Task
+// notifications form the barrier: one wakes the worker, one returns to the
+// render task when the band is done.
+static std::atomic<TaskHandle_t> s_worker_task{nullptr};
+static TaskHandle_t              s_worker_caller = nullptr;
+static void (*s_worker_job)(void*) = nullptr;
+static void* s_worker_arg = nullptr;
 
-static void apply_afterglow(pixel_t* buf, const FaceState& fs)
+static void render_worker_start(void* ctx, void (*job)(void* arg), void* arg)
 {
-    if (!fs.fx.afterglow || !afterglow_buf) {
-        return;
-    }
-    const pixel_t bg = rgb_to_color(BG_R, BG_G, BG_B);
-    for (int y = 0; y < SCREEN_H; y++) {
-        const int ay = (y / FACE_AFTERGLOW_DOWNSAMPLE) * AFTERGLOW_W;
-        const int row = y * SCREEN_W;
-        for (int x = 0; x < SCREEN_W; x++) {
-            const int     aidx = ay + (x / FACE_AFTERGLOW_DOWNSAMPLE);
-            const pixel_t prev = afterglow_buf[aidx];
-            if (buf[row + x] == bg && prev != bg) {
-                buf[row + x] = scale_color(prev, 2, 5);
-            }
-        }
-    }
-    afterglow_copy_from_canvas(buf);
+    (void)ctx;
+    s_worker_job = job;
+    s_worker_arg = arg;
+    s_worker_caller = xTaskGetCurrentTaskHandle();
+    xTaskNotifyGive(s_worker_task.load(std::memory_order_acquire));
 }
 
-static void afterglow_copy_from_canvas(const pixel_t* canvas)
+static void render_worker_wait(void* ctx)
 {
-    if (!afterglow_buf || !canvas) {
-        return;
-    }
-    for (int y = 0; y < AFTERGLOW_H; y++) {
-        const int src_y = y * FACE_AFTERGLOW_DOWNSAMPLE;
-        const int dst_row = y * AFTERGLOW_W;
-        const int src_row = src_y * SCREEN_W;
-        for (int x = 0; x < AFTERGLOW_W; x++) {
-            afterglow_buf[dst_row + x] = canvas[src_row + (x * FACE_AFTERGLOW_DOWNSAMPLE)];
-        }
-    }
+    (void)ctx;
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
 }
 
-static void render_calibration(pixel_t* buf)
-{
-    const pixel_t bg = rgb_to_color(8, 8, 10);
-    const pixel_t grid = rgb_to_color(34, 34, 38);
-    const pixel_t axis = rgb_to_color(74, 74, 84);
-    const pixel_t ptt_outline = rgb_to_color(34, 180, 102);
-    const pixel_t action_outline = rgb_to_color(190, 98, 54);
-    const pixel_t ptt_fill = rgb_to_color(20, 96, 64);
-    const pixel_t action_fill = rgb_to_color(148, 78, 42);
-    const pixel_t touch = rgb_to_color(255, 228, 128);
-    const pixel_t cross = rgb_to_color(240, 250, 255);
-
-    draw_filled_rect(buf, 0, 0, SCREEN_W, SCREEN_H, bg);
-
-    for (int x = 0; x < SCREEN_W; x += 20) {
-        draw_vline(buf, x, 0, SCREEN_H - 1, (x % 40 == 0) ? axis : grid);
-    }
-    for (int y = 0; y < SCREEN_H; y += 20) {
-        draw_hline(buf, 0, SCREEN_W - 1, y, (y % 40 == 0) ? axis : grid);
-    }
-    draw_vline(buf, SCREEN_W / 2, 0, SCREEN_H - 1, rgb_to_color(120, 120, 130));
-    draw_hline(buf, 0, SCREEN_W - 1, SCREEN_H / 2, rgb_to_color(120, 120, 130));
-
-    const int hit = UI_ICON_HITBOX;
-    const int vis = UI_ICON_DIAMETER;
-    const int vis_r = vis / 2;
-    const int ptt_x = UI_ICON_MARGIN;
-    const int ptt_y = SCREEN_H - UI_ICON_MARGIN - hit;
-    const int action_x = SCREEN_W - UI_ICON_MARGIN - hit;
-    const int action_y = SCREEN_H - UI_ICON_MARGIN - hit;
-    const int ptt_cx = ptt_x + hit / 2;
-    const int ptt_cy = ptt_y + hit / 2;
-    const int action_cx = action_x + hit / 2;
-    const int action_cy = action_y + hit / 2;
-
-    draw_hline(buf, ptt_x, ptt_x + hit - 1, ptt_y, ptt_outline);
-    draw_hline(buf, ptt_x, ptt_x + hit - 1, ptt_y + hit - 1, ptt_outline);
-    draw_vline(buf, ptt_x, ptt_y, ptt_y + hit - 1, ptt_outline);
-    draw_vline(buf, ptt_x + hit - 1, ptt_y, ptt_y + hit - 1, ptt_outline);
-    draw_hline(buf, action_x, action_x + hit - 1, action_y, action_outline);
-    draw_hline(buf, action_x, action_x + hit - 1, action_y + hit - 1, action_outline);
-    draw_vline(buf, action_x, action_y, action_y + hit - 1, action_outline);
-    draw_vline(buf, action_x + hit - 1, action_y, action_y + hit - 1, action_outline);
-
-    draw_filled_circle(buf, ptt_cx, ptt_cy, vis_r, ptt_fill);
-    draw_filled_circle(buf, action_cx, action_cy, vis_r, action_fill);
-
-    if (s_last_touch_active && point_in_rect(s_last_touch_x, s_last_touch_y, ptt_x, ptt_y, hit, hit)) {
-        draw_filled_circle(buf, ptt_cx, ptt_cy, vis_r - 4, rgb_to_color(58, 214, 145));
-    }
-    if (s_last_touch_active && point_in_rect(s_last_touch_x, s_last_touch_y, action_x, action_y, hit, hit)) {
-        draw_filled_circle(buf, action_cx, action_cy, vis_r - 4, rgb_to_color(255, 140, 84));
-    }
-
-    const int tx = (s_last_touch_x < 0) ? 0 : ((s_last_touch_x >= SCREEN_W) ? (SCREEN_W - 1) : s_last_touch_x);
-    const int ty = (s_last_touch_y < 0) ? 0 : ((s_last_touch_y >= SCREEN_H) ? (SCREEN_H - 1) : s_last_touch_y);
-    draw_hline(buf, tx - 10, tx + 10, ty, cross);
-    draw_vline(buf, tx, ty - 10, ty + 10, cross);
-    draw_filled_circle(buf, tx, ty, 4, touch);
-}
+static void publish_touch_sample(uint8_t event_type, int x, int y);
+static void publish_button_event(FaceButtonId button_id, FaceButtonEventType event_type, uint8_t state);
+static void root_touch_event_cb(lv_event_t* e);
+static void update_calibration_labels(uint32_t now_ms, uint32_t next_switch_ms);
 
 static void update_calibration_labels(uint32_t now_ms, uint32_t next_switch_ms)
 {
@@ -573,253 +182,6 @@ static float now_s()
     return static_cast<float>(esp_timer_get_time()) / 1'000'000.0f;
 }
 
-static RectI make_rect_xyxy(int x0, int y0, int x1, int y1)
-{
-    RectI out = {};
-    if (x1 < x0 || y1 < y0) {
-        return out;
-    }
-    if (x1 < 0 || y1 < 0 || x0 >= SCREEN_W || y0 >= SCREEN_H) {
-        return out;
-    }
-    out.x0 = (x0 < 0) ? 0 : x0;
-    out.y0 = (y0 < 0) ? 0 : y0;
-    out.x1 = (x1 >= SCREEN_W) ? (SCREEN_W - 1) : x1;
-    out.y1 = (y1 >= SCREEN_H) ? (SCREEN_H - 1) : y1;
-    out.valid = (out.x1 >= out.x0) && (out.y1 >= out.y0);
-    return out;
-}
-
-static RectI make_rect_xywh(int x, int y, int w, int h)
-{
-    if (w <= 0 || h <= 0) return {};
-    return make_rect_xyxy(x, y, x + w - 1, y + h - 1);
-}
-
-static bool rects_touch_or_overlap(const RectI& a, const RectI& b)
-{
-    if (!a.valid || !b.valid) return false;
-    return !(a.x1 + 1 < b.x0 || b.x1 + 1 < a.x0 || a.y1 + 1 < b.y0 || b.y1 + 1 < a.y0);
-}
-
-static void rect_union_inplace(RectI& a, const RectI& b)
-{
-    if (!b.valid) return;
-    if (!a.valid) {
-        a = b;
-        return;
-    }
-    if (b.x0 < a.x0) a.x0 = b.x0;
-    if (b.y0 < a.y0) a.y0 = b.y0;
-    if (b.x1 > a.x1) a.x1 = b.x1;
-    if (b.y1 > a.y1) a.y1 = b.y1;
-    a.valid = true;
-}
-
-static void dirty_region_add_rect(DirtyRegion& region, RectI rect)
-{
-    if (!rect.valid || region.full) return;
-
-    // Merge with any touching/overlapping rectangles to keep rect count small.
-    for (int i = 0; i < region.count; i++) {
-        if (!rects_touch_or_overlap(region.rects[i], rect)) continue;
-        rect_union_inplace(rect, region.rects[i]);
-        region.rects[i] = region.rects[region.count - 1];
-        region.count--;
-        i--;
-    }
-
-    if (region.count >= DirtyRegion::MAX_RECTS) {
-        region.full = true;
-        region.count = 0;
-        return;
-    }
-    region.rects[region.count++] = rect;
-}
-
-static void dirty_region_add_xywh(DirtyRegion& region, int x, int y, int w, int h)
-{
-    dirty_region_add_rect(region, make_rect_xywh(x, y, w, h));
-}
-
-static void dirty_region_add_prev_curr(DirtyRegion& region, const RectI& prev, const RectI& curr)
-{
-    if (prev.valid) dirty_region_add_rect(region, prev);
-    if (curr.valid) dirty_region_add_rect(region, curr);
-}
-
-static RectI compute_eye_bounds(const FaceState& fs, bool is_left, float center_x, float center_y)
-{
-    const EyeState& eye = is_left ? fs.eye_l : fs.eye_r;
-    const float     breath = face_get_breath_scale(fs);
-    const float     ew = EYE_WIDTH * eye.width_scale * breath;
-    const float     eh = EYE_HEIGHT * eye.height_scale * fmaxf(0.25f, eye.openness) * breath;
-    if (eh < 2.0f) {
-        return {};
-    }
-
-    const float ex = center_x + eye.gaze_x * GAZE_EYE_SHIFT - ew / 2.0f;
-    const float ey = center_y + eye.gaze_y * GAZE_EYE_SHIFT - eh / 2.0f;
-    const float edge_pad = fs.fx.edge_glow ? 4.0f : 2.0f;
-
-    float x_min = ex - edge_pad;
-    float x_max = ex + ew + edge_pad;
-    float y_min = ey - edge_pad;
-    float y_max = ey + eh + edge_pad;
-
-    const float max_offset_x = fmaxf(0.0f, ew * 0.5f - PUPIL_R - 5.0f);
-    const float max_offset_y = fmaxf(0.0f, eh * 0.5f - PUPIL_R - 5.0f);
-    const float pupil_x = center_x + clampf(eye.gaze_x * GAZE_PUPIL_SHIFT, -max_offset_x, max_offset_x);
-    const float pupil_y = center_y + clampf(eye.gaze_y * GAZE_PUPIL_SHIFT, -max_offset_y, max_offset_y);
-    const float pupil_r = static_cast<float>(static_cast<int>(PUPIL_R * fmaxf(0.4f, eye.openness)));
-
-    if (fs.solid_eye && fs.anim.heart) {
-        const float heart_r = fminf(ew, eh) * 0.5f * HEART_SOLID_SCALE;
-        x_min = fminf(x_min, center_x - heart_r - 3.0f);
-        x_max = fmaxf(x_max, center_x + heart_r + 3.0f);
-        y_min = fminf(y_min, center_y - heart_r - 3.0f);
-        y_max = fmaxf(y_max, center_y + heart_r + 3.0f);
-    } else if (fs.solid_eye && fs.anim.x_eyes) {
-        const float x_r = fminf(ew, eh) * 0.33f + 4.0f;
-        x_min = fminf(x_min, center_x - x_r);
-        x_max = fmaxf(x_max, center_x + x_r);
-        y_min = fminf(y_min, center_y - x_r);
-        y_max = fmaxf(y_max, center_y + x_r);
-    } else if (!fs.solid_eye) {
-        if (fs.anim.heart) {
-            const float heart_r = PUPIL_R * HEART_PUPIL_SCALE + 3.0f;
-            x_min = fminf(x_min, pupil_x - heart_r);
-            x_max = fmaxf(x_max, pupil_x + heart_r);
-            y_min = fminf(y_min, pupil_y - heart_r);
-            y_max = fmaxf(y_max, pupil_y + heart_r);
-        } else if (fs.anim.x_eyes) {
-            const float x_r = pupil_r + 4.0f;
-            x_min = fminf(x_min, pupil_x - x_r);
-            x_max = fmaxf(x_max, pupil_x + x_r);
-            y_min = fminf(y_min, pupil_y - x_r);
-            y_max = fmaxf(y_max, pupil_y + x_r);
-        } else {
-            const float p_r = pupil_r + 2.0f;
-            x_min = fminf(x_min, pupil_x - p_r);
-            x_max = fmaxf(x_max, pupil_x + p_r);
-            y_min = fminf(y_min, pupil_y - p_r);
-            y_max = fmaxf(y_max, pupil_y + p_r);
-        }
-    }
-
-    // Eyelid vertical strokes can extend beyond eye box.
-    const float lid_top = is_left ? fs.eyelids.top_l : fs.eyelids.top_r;
-    const float lid_bot = is_left ? fs.eyelids.bottom_l : fs.eyelids.bottom_r;
-    const float slope_mag = fabsf(fs.eyelids.slope) * 20.0f;
-    const float top_limit_max = (ey - 0.5f) + eh * 2.0f * lid_top + slope_mag;
-    const float bot_limit = (ey + eh) - eh * 2.0f * lid_bot;
-    y_min = fminf(y_min, bot_limit - 1.0f);
-    y_max = fmaxf(y_max, top_limit_max + 1.0f);
-
-    return make_rect_xyxy(static_cast<int>(floorf(x_min)), static_cast<int>(floorf(y_min)),
-                          static_cast<int>(ceilf(x_max)), static_cast<int>(ceilf(y_max)));
-}
-
-static RectI compute_mouth_bounds(const FaceState& fs)
-{
-    if (!fs.show_mouth) return {};
-
-    const float cx = MOUTH_CX + fs.mouth_offset_x * 10.0f;
-    const float cy = MOUTH_CY;
-    const float w = MOUTH_HALF_W * fs.mouth_width;
-    const float thick = MOUTH_THICKNESS;
-    const float curve = fs.mouth_curve * 40.0f;
-    const float openness = fs.mouth_open * 40.0f;
-    if (w < 1.0f) return {};
-
-    const int x0 = static_cast<int>(floorf(cx - w - thick - 2.0f));
-    const int x1 = static_cast<int>(ceilf(cx + w + thick + 2.0f));
-    const int y0 = static_cast<int>(floorf(cy - fabsf(curve) - openness - thick - 2.0f));
-    const int y1 = static_cast<int>(ceilf(cy + fabsf(curve) + openness + thick + 2.0f));
-    return make_rect_xyxy(x0, y0, x1, y1);
-}
-
-static DirtyRegion compute_dirty_region(const FaceState& fs)
-{
-    DirtyRegion region = {};
-
-    if (!FACE_DIRTY_RECT || FACE_CALIBRATION_MODE) {
-        region.full = true;
-        s_prev_bounds = {};
-        s_prev_bounds.valid = true;
-        s_prev_bounds.full = true;
-        return region;
-    }
-
-    const bool full_now = (fs.system.mode != SystemMode::NONE) || fs.fx.afterglow || fs.anim.rage || fs.fx.sparkle;
-    const bool full_prev = s_prev_bounds.valid && s_prev_bounds.full;
-
-    RectI eye_l = {};
-    RectI eye_r = {};
-    RectI mouth = {};
-    RectI border = {};
-    RectI btn_left = make_rect_xywh(0, SCREEN_H - 46, 60, 46);              // must match conv_border.cpp
-    RectI btn_right = make_rect_xywh(SCREEN_W - 60, SCREEN_H - 46, 60, 46); // must match conv_border.cpp
-
-    if (!full_now) {
-        eye_l = compute_eye_bounds(fs, true, LEFT_EYE_CX, LEFT_EYE_CY);
-        eye_r = compute_eye_bounds(fs, false, RIGHT_EYE_CX, RIGHT_EYE_CY);
-        mouth = compute_mouth_bounds(fs);
-        border.valid = conv_border_active();
-    }
-
-    if (full_now || full_prev) {
-        region.full = true;
-    } else {
-        dirty_region_add_prev_curr(region, s_prev_bounds.eye_l, eye_l);
-        dirty_region_add_prev_curr(region, s_prev_bounds.eye_r, eye_r);
-        dirty_region_add_prev_curr(region, s_prev_bounds.mouth, mouth);
-
-        // Corner buttons are rendered in software and can animate independently.
-        dirty_region_add_rect(region, btn_left);
-        dirty_region_add_rect(region, btn_right);
-
-        if (border.valid || s_prev_bounds.border.valid) {
-            constexpr int edge = 20;
-            dirty_region_add_xywh(region, 0, 0, SCREEN_W, edge);
-            dirty_region_add_xywh(region, 0, SCREEN_H - edge, SCREEN_W, edge);
-            dirty_region_add_xywh(region, 0, edge, edge, SCREEN_H - 2 * edge);
-            dirty_region_add_xywh(region, SCREEN_W - edge, edge, edge, SCREEN_H - 2 * edge);
-        }
-
-        if (region.count == 0) {
-            region.full = true;
-        }
-    }
-
-    s_prev_bounds.eye_l = eye_l;
-    s_prev_bounds.eye_r = eye_r;
-    s_prev_bounds.mouth = mouth;
-    s_prev_bounds.border = border;
-    s_prev_bounds.btn_left = btn_left;
-    s_prev_bounds.btn_right = btn_right;
-    s_prev_bounds.full = full_now;
-    s_prev_bounds.valid = true;
-
-    return region;
-}
-
-static uint32_t dirty_region_area(const DirtyRegion& region)
-{
-    if (region.full) {
-        return static_cast<uint32_t>(SCREEN_W * SCREEN_H);
-    }
-    uint32_t sum = 0;
-    for (uint8_t i = 0; i < region.count; i++) {
-        const RectI& r = region.rects[i];
-        if (!r.valid) continue;
-        const uint32_t w = static_cast<uint32_t>(r.x1 - r.x0 + 1);
-        const uint32_t h = static_cast<uint32_t>(r.y1 - r.y0 + 1);
-        sum += w * h;
-    }
-    return (sum > 0U) ? sum : static_cast<uint32_t>(SCREEN_W * SCREEN_H);
-}
-
 static void publish_touch_sample(uint8_t event_type, int x, int y)
 {
     TouchSample* slot = g_touch.write_slot();
@@ -908,27 +270,52 @@ static void root_touch_event_cb(lv_event_t* e)
 
 void face_ui_create(lv_obj_t* parent)
 {
-    // Allocate canvas buffer in PSRAM
-    canvas_buf = static_cast<pixel_t*>(heap_caps_malloc(CANVAS_BYTES, MALLOC_CAP_SPIRAM));
-    if (!canvas_buf) {
+    // Allocate canvas buffers in PSRAM; a missing back buffer only costs the overlap.
+    for (uint8_t i = 0; i < FACE_CANVAS_BUFFERS; i++) {
+        canvas_bufs[i] = static_cast<pixel_t*>(heap_caps_malloc(CANVAS_BYTES, MALLOC_CAP_SPIRAM));
+        if (!canvas_bufs[i]) break;
+        memset(canvas_bufs[i], 0, CANVAS_BYTES);
+        s_canvas_count++;
+    }
+    if (s_canvas_count == 0) {
         ESP_LOGE(TAG, "failed to allocate canvas buffer in PSRAM!");
         return;
     }
+    if (s_canvas_count < FACE_CANVAS_BUFFERS) {
+        ESP_LOGW(TAG, "only %u of %u canvas buffers allocated; rendering under the LVGL lock",
+                 static_cast<unsigned>(s_canvas_count), static_cast<unsigned>(FACE_CANVAS_BUFFERS));
+    }
+    s_canvas_back = s_canvas_count > 1 ? 1 : 0;
     afterglow_buf = static_cast<pixel_t*>(heap_caps_malloc(AFTERGLOW_BYTES, MALLOC_CAP_SPIRAM));
     if (!afterglow_buf) {
         ESP_LOGW(TAG, "failed to allocate afterglow buffer; disabling afterglow effect");
     } else {
         memset(afterglow_buf, 0, AFTERGLOW_BYTES);
     }
+    face_render_init(afterglow_buf, s_canvas_count);
+
+    s_presenter = panel_presenter();
+    s_direct = s_presenter.present != nullptr;
+    lv_display_t* disp = lv_obj_get_display(parent);
+    if (s_direct) {
+        // Touch layer only: with no styles, press states never invalidate it,
+        // so LVGL does not draw over the face once the first refresh is done.
+        canvas_obj = lv_obj_create(parent);
+        lv_obj_remove_style_all(canvas_obj);
+        lv_obj_set_size(canvas_obj, SCREEN_W, SCREEN_H);
+    } else {
+        canvas_obj = lv_canvas_create(parent);
+        lv_canvas_set_buffer(canvas_obj, canvas_bufs[0], SCREEN_W, SCREEN_H, CANVAS_COLOR_FORMAT);
+        // Clear to black
+        lv_canvas_fill_bg(canvas_obj, lv_color_black(), LV_OPA_COVER);
 
-    canvas_obj = lv_canvas_create(parent);
-    lv_canvas_set_buffer(canvas_obj, canvas_buf, SCREEN_W, SCREEN_H, CANVAS_COLOR_FORMAT);
+        // Refresh windows for the render / flush overlap figures.
+        lv_display_add_event_cb(disp, display_refr_event_cb, LV_EVENT_REFR_START, nullptr);
+        lv_display_add_event_cb(disp, display_refr_event_cb, LV_EVENT_REFR_READY, nullptr);
+    }
     lv_obj_align(canvas_obj, LV_ALIGN_TOP_MID, 0, 0);
     lv_obj_add_flag(canvas_obj, LV_OBJ_FLAG_CLICKABLE);
 
-    // Clear to black
-    lv_canvas_fill_bg(canvas_obj, lv_color_black(), LV_OPA_COVER);
-
     // Root touch telemetry hooks (press / drag / release).
     lv_obj_add_event_cb(canvas_obj, root_touch_event_cb, LV_EVENT_PRESSED, nullptr);
     lv_obj_add_event_cb(canvas_obj, root_touch_event_cb, LV_EVENT_PRESSING, nullptr);
@@ -965,83 +352,81 @@ void face_ui_create(lv_obj_t* parent)
         lv_obj_move_foreground(calib_header_bg);
     }
 
-    ESP_LOGI(TAG, "face UI created (%dx%d canvas in PSRAM, afterglow=%dx%d)", SCREEN_W, SCREEN_H, AFTERGLOW_W,
-             AFTERGLOW_H);
+    if (s_direct) {
+        // Let LVGL paint the screen once now, while nothing else uses the SPI
+        // bus; after this it has nothing left to refresh.
+        lv_refr_now(disp);
+    }
+
+    ESP_LOGI(TAG, "face UI created (%ux %dx%d canvas in PSRAM, afterglow=%dx%d, %s present)",
+             static_cast<unsigned>(s_canvas_count), SCREEN_W, SCREEN_H, AFTERGLOW_W, AFTERGLOW_H,
+             s_direct ? "direct" : "LVGL");
 }
 
-void face_ui_update(const FaceState& fs)
+void face_ui_render(const FaceState& fs)
 {
-    if (!canvas_buf) return;
-
-    const uint64_t render_start_us =
-        (FACE_PERF_TELEMETRY && s_collect_render_perf) ? static_cast<uint64_t>(esp_timer_get_time()) : 0ULL;
-    uint64_t stage_start_us = render_start_us;
-    auto     sample_stage = [&](uint32_t& out_us) {
-        if (!(FACE_PERF_TELEMETRY && s_collect_render_perf)) {
-            return;
-        }
-        const uint64_t now = static_cast<uint64_t>(esp_timer_get_time());
-        out_us = static_cast<uint32_t>(now - stage_start_us);
-        stage_start_us = now;
-    };
+    // The back buffer is still queued if the last present missed the lock.
+    if (s_canvas_count == 0 || (s_pending && s_canvas_count > 1)) return;
+    if (s_direct && s_canvas_count == 1) {
+        s_presenter.wait(s_presenter.ctx); // the only canvas is still being pushed
+    }
 
+    pixel_t*           buf = canvas_bufs[s_canvas_back];
+    const bool         collect = FACE_PERF_TELEMETRY && s_collect_render_perf;
+    const uint64_t     render_start_us = collect ? static_cast<uint64_t>(esp_timer_get_time()) : 0ULL;
+    const uint32_t     busy_start_us = collect ? display_busy_at(static_cast<uint32_t>(render_start_us)) : 0U;
     RenderPerfSnapshot perf = {};
-    draw_filled_rect(canvas_buf, 0, 0, SCREEN_W, SCREEN_H, rgb_to_color(BG_R, BG_G, BG_B));
+    DirtyRegion        dirty = {};
 
     if (FACE_CALIBRATION_MODE) {
-        render_calibration(canvas_buf);
-        sample_stage(perf.overlay_us);
+        face_render_calibration(buf, s_last_touch_x, s_last_touch_y, s_last_touch_active);
+        dirty.full = true;
+        if (collect) {
+            perf.overlay_us = static_cast<uint32_t>(static_cast<uint64_t>(esp_timer_get_time()) - render_start_us);
+        }
     } else {
-        // Always render face (system modes drive face state via system_face_apply)
-        render_eye(canvas_buf, fs.eye_l, fs, true, LEFT_EYE_CX, LEFT_EYE_CY);
-        render_eye(canvas_buf, fs.eye_r, fs, false, RIGHT_EYE_CX, RIGHT_EYE_CY);
-        sample_stage(perf.eyes_us);
+        dirty = face_render_frame(buf, fs, collect ? &perf : nullptr);
+    }
 
-        render_mouth(canvas_buf, fs);
-        sample_stage(perf.mouth_us);
+    perf.dirty_px = dirty_region_area(dirty);
+    s_pending_dirty = dirty;
+    s_pending = true;
 
-        if (fs.anim.rage) {
-            render_fire_effect(canvas_buf, fs);
-        }
-        render_sparkles(canvas_buf, fs);
-        apply_afterglow(canvas_buf, fs);
-        sample_stage(perf.effects_us);
-
-        // System mode icon overlays (drawn on top of face)
-        if (fs.system.mode == SystemMode::ERROR_DISPLAY) {
-            system_face_render_error_icon(canvas_buf);
-        } else if (fs.system.mode == SystemMode::LOW_BATTERY) {
-            system_face_render_battery_icon(canvas_buf, fs.system.param);
-        } else if (fs.system.mode == SystemMode::UPDATING) {
-            system_face_render_updating_bar(canvas_buf, fs.system.param);
-        }
-        sample_stage(perf.overlay_us);
-
-        // Conversation border overlay + corner buttons — suppress during system overlays (spec §4.4)
-        if (fs.system.mode == SystemMode::NONE) {
-            if (FACE_PERF_TELEMETRY && s_collect_render_perf) {
-                const uint64_t border_start_us = static_cast<uint64_t>(esp_timer_get_time());
-                conv_border_render(canvas_buf);
-                const uint64_t border_frame_done_us = static_cast<uint64_t>(esp_timer_get_time());
-                conv_border_render_buttons(canvas_buf);
-                const uint64_t border_done_us = static_cast<uint64_t>(esp_timer_get_time());
-                perf.border_frame_us = static_cast<uint32_t>(border_frame_done_us - border_start_us);
-                perf.border_buttons_us = static_cast<uint32_t>(border_done_us - border_frame_done_us);
-            } else {
-                conv_border_render(canvas_buf);
-                conv_border_render_buttons(canvas_buf);
-            }
-        }
-        sample_stage(perf.border_us);
+    if (collect && render_start_us > 0ULL) {
+        const uint64_t end_us = static_cast<uint64_t>(esp_timer_get_time());
+        perf.render_us = static_cast<uint32_t>(end_us - render_start_us);
+        s_last_render_perf = perf;
 
-        if ((fs.system.mode != SystemMode::NONE || !fs.fx.afterglow) && afterglow_buf) {
-            afterglow_copy_from_canvas(canvas_buf);
-        }
+        // Display refresh time that ran while this frame was being drawn.
+        const uint32_t hidden_us = display_busy_at(static_cast<uint32_t>(end_us)) - busy_start_us;
+        s_last_overlap_us = hidden_us < perf.render_us ? hidden_us : perf.render_us;
     }
+}
 
-    const DirtyRegion dirty = compute_dirty_region(fs);
-    perf.dirty_px = dirty_region_area(dirty);
-    if (FACE_DIRTY_RECT && !dirty.full && dirty.count > 0) {
+void face_ui_present()
+{
+    if (!s_pending) return;
+    s_pending = false;
+
+    if (s_direct) {
+        s_presenter.wait(s_presenter.ctx);
+        s_presenter.present(s_presenter.ctx, canvas_bufs[s_canvas_back], s_pending_dirty);
+        s_canvas_back = static_cast<uint8_t>((s_canvas_back + 1) % s_canvas_count);
+        return;
+    }
+
+    if (s_canvas_count > 1) {
+        // Repoint the canvas at the new frame in place: lv_canvas_set_buffer
+        // would invalidate the whole object and defeat the dirty rects.
+        lv_draw_buf_t* db = lv_canvas_get_draw_buf(canvas_obj);
+        db->data = reinterpret_cast<uint8_t*>(canvas_bufs[s_canvas_back]);
+        db->unaligned_data = db->data;
+        lv_image_cache_drop(db);
+        s_canvas_back = static_cast<uint8_t>((s_canvas_back + 1) % s_canvas_count);
+    }
+
+    const DirtyRegion& dirty = s_pending_dirty;
+    if (FACE_DIRTY_RECT && !dirty.full) { // no rects: nothing changed
         for (uint8_t i = 0; i < dirty.count; i++) {
             const RectI& r = dirty.rects[i];
             if (!r.valid) continue;
@@ -1057,14 +442,10 @@ void face_ui_update(const FaceState& fs)
         // Invalidate canvas to trigger LVGL refresh
         lv_obj_invalidate(canvas_obj);
     }
-
-    if (FACE_PERF_TELEMETRY && s_collect_render_perf && render_start_us > 0ULL) {
-        perf.render_us = static_cast<uint32_t>(static_cast<uint64_t>(esp_timer_get_time()) - render_start_us);
-        s_last_render_perf = perf;
-    }
 }
 
-static void apply_face_flags(FaceState& fs, uint8_t flags)
+// Face flags as commanded, minus the effects the quality governor has shed.
+static void apply_face_flags(FaceState& fs, uint8_t flags, uint8_t shed)
 {
     const uint8_t masked = static_cast<uint8_t>(flags & FACE_FLAGS_ALL);
     fs.anim.idle = (masked & FACE_FLAG_IDLE_WANDER) != 0;
@@ -1073,7 +454,48 @@ static void apply_face_flags(FaceState& fs, uint8_t flags)
     fs.show_mouth = (masked & FACE_FLAG_SHOW_MOUTH) != 0;
     fs.fx.edge_glow = (masked & FACE_FLAG_EDGE_GLOW) != 0;
     fs.fx.sparkle = (masked & FACE_FLAG_SPARKLE) != 0;
-    fs.fx.afterglow = (masked & FACE_FLAG_AFTERGLOW) != 0;
+    fs.fx.afterglow = (masked & FACE_FLAG_AFTERGLOW) != 0 && afterglow_buf != nullptr;
+    quality_apply(fs, shed);
+}
+
+// Effects the quality governor can shed for this frame (see quality_active_mask).
+static uint8_t quality_active(const FaceState& fs, uint8_t flags)
+{
+    if (!afterglow_buf) flags = static_cast<uint8_t>(flags & ~FACE_FLAG_AFTERGLOW);
+    return quality_active_mask(fs, flags, face_render_system_renderer() == SystemRenderer::OVERLAY_V2);
+}
+
+// ---- Frame pacing ----
+
+static void pace_timer_cb(void* arg)
+{
+    (void)arg;
+    xSemaphoreGive(s_pace_sem);
+}
+
+static bool pace_init()
+{
+    s_pace_sem = xSemaphoreCreateBinary();
+    if (!s_pace_sem) return false;
+    esp_timer_create_args_t args = {};
+    args.callback = pace_timer_cb;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "face_pace";
+    return esp_timer_create(&args, &s_pace_timer) == ESP_OK;
+}
+
+// Block until esp_timer_get_time() reaches deadline_us. Without the pacing
+// timer, falls back to whole ticks rounded up.
+static void pace_sleep_until(int64_t deadline_us)
+{
+    const int64_t wait_us = deadline_us - esp_timer_get_time();
+    if (wait_us <= 0) return;
+    if (s_pace_timer && esp_timer_start_once(s_pace_timer, static_cast<uint64_t>(wait_us)) == ESP_OK) {
+        xSemaphoreTake(s_pace_sem, portMAX_DELAY);
+        return;
+    }
+    const int64_t tick_us = 1'000'000 / configTICK_RATE_HZ;
+    vTaskDelay(static_cast<TickType_t>((wait_us + tick_us - 1) / tick_us));
 }
 
 // ---- FreeRTOS task ----
@@ -1114,6 +536,17 @@ std::atomic<uint8_t>  g_system_mode{0};
 std::atomic<uint32_t> g_cmd_seq_last{0};
 std::atomic<uint32_t> g_cmd_applied_us{0};
 
+void face_render_worker_task(void* arg)
+{
+    (void)arg;
+    s_worker_task.store(xTaskGetCurrentTaskHandle(), std::memory_order_release);
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        s_worker_job(s_worker_arg);
+        xTaskNotifyGive(s_worker_caller);
+    }
+}
+
 void face_ui_task(void* arg)
 {
     ESP_LOGI(TAG, "face_ui_task started (%d FPS)", ANIM_FPS);
@@ -1126,6 +559,7 @@ void face_ui_task(void* arg)
     uint32_t  last_conv_state_cmd_us = 0;
     bool      last_led_talking = false;
     bool      last_led_listening = false;
+    bool      worker_attached = false;
     uint32_t  next_touch_cycle_ms = 0;
     uint32_t  next_frame_log_ms = static_cast<uint32_t>(esp_timer_get_time() / 1000ULL) + FRAME_TIME_LOG_INTERVAL_MS;
     uint32_t  frame_count = 0;
@@ -1152,12 +586,28 @@ void face_ui_task(void* arg)
     uint64_t  log_border_frame_sum_us = 0;
     uint64_t  log_border_buttons_sum_us = 0;
     uint32_t  log_border_samples = 0;
+    uint32_t  log_ring_builds_base = conv_border_stats().ring_builds;
+    uint64_t  perf_overlap_sum_us = 0;
+    uint64_t  perf_overlap_render_sum_us = 0;
+    uint32_t  perf_display_busy_base_us = display_busy_at(static_cast<uint32_t>(esp_timer_get_time()));
 
-    apply_face_flags(fs, g_cmd_flags.load(std::memory_order_relaxed));
-    if (!afterglow_buf) {
-        fs.fx.afterglow = false;
+    uint32_t  perf_pace_overruns = 0;
+    uint16_t  perf_quality_changes = 0;
+    uint32_t  log_pace_overruns = 0;
+    uint8_t   face_flags = g_cmd_flags.load(std::memory_order_relaxed);
+
+    MouthCacheStats perf_mouth_cache_base = mouth_cache_stats();
+    FaceRenderStats perf_render_stats_base = face_render_stats();
+    AnimClock       anim_clock;
+    QualityGovernor quality;
+    int64_t         pace_start_us = esp_timer_get_time(); // start of the next frame on the schedule
+
+    if (!pace_init()) {
+        ESP_LOGE(TAG, "failed to create frame pacing timer; pacing on ticks");
     }
 
+    apply_face_flags(fs, face_flags, 0);
+
     display_set_backlight(DEFAULT_BRIGHTNESS);
 
     if (FACE_CALIBRATION_MODE) {
@@ -1177,6 +627,7 @@ void face_ui_task(void* arg)
         const uint64_t frame_start_us = static_cast<uint64_t>(esp_timer_get_time());
         const uint32_t now_us = static_cast<uint32_t>(esp_timer_get_time());
         const uint32_t now_ms = now_us / 1000U;
+        const float    anim_dt = anim_clock_tick(anim_clock, static_cast<int64_t>(frame_start_us));
         // 1. Apply latest latched state command.
         const uint32_t state_cmd_us = g_cmd_state_us.load(std::memory_order_acquire);
         if (state_cmd_us != 0 && state_cmd_us != last_state_cmd_us) {
@@ -1247,11 +698,8 @@ void face_ui_task(void* arg)
         if (flags_cmd_us != 0 && flags_cmd_us != last_flags_cmd_us) {
             last_flags_cmd_us = flags_cmd_us;
             latest_cmd_rx_us = flags_cmd_us;
-            const uint8_t flags = g_cmd_flags.load(std::memory_order_relaxed);
-            apply_face_flags(fs, flags);
-            if (!afterglow_buf) {
-                fs.fx.afterglow = false;
-            }
+            face_flags = g_cmd_flags.load(std::memory_order_relaxed);
+            apply_face_flags(fs, face_flags, quality.shed);
         }
 
         // 5b. Apply latest latched conv_state command.
@@ -1265,8 +713,8 @@ void face_ui_task(void* arg)
         // Feed talking energy to border for SPEAKING reactivity.
         conv_border_set_energy(fs.talking_energy);
 
-        // Advance border animation.
-        conv_border_update(1.0f / ANIM_FPS);
+        // Advance border animation by the measured frame time.
+        conv_border_update(anim_dt);
 
         if (FACE_CALIBRATION_MODE && CALIB_TOUCH_AUTOCYCLE_MS > 0) {
             const int32_t delta_ms = static_cast<int32_t>(now_ms - next_touch_cycle_ms);
@@ -1281,7 +729,7 @@ void face_ui_task(void* arg)
         }
 
         // 6. Advance animations
-        face_state_update(fs);
+        face_state_update(fs, anim_dt);
 
         // 6b. System face: override face state for system modes (before render)
         if (fs.system.mode != SystemMode::NONE) {
@@ -1311,11 +759,31 @@ void face_ui_task(void* arg)
             last_led_listening = listening;
         }
 
-        // 6. Render under LVGL lock
+        // The worker task starts on the other core; split bands once it runs.
+        if (FACE_RENDER_WORKER && !worker_attached && s_worker_task.load(std::memory_order_acquire)) {
+            FaceRenderWorker worker;
+            worker.start = render_worker_start;
+            worker.wait = render_worker_wait;
+            face_render_set_worker(&worker);
+            worker_attached = true;
+        }
+
+        // 6. Render into the back canvas (outside the LVGL lock with direct
+        //    present or two canvases), then present it.
         s_collect_render_perf = FACE_PERF_TELEMETRY && ((frame_idx % FACE_PERF_SAMPLE_DIV) == 0U);
         s_last_render_perf = {};
-        if (lvgl_port_lock(100)) {
-            face_ui_update(fs);
+        s_last_overlap_us = 0;
+        if (s_direct || s_canvas_count > 1) {
+            face_ui_render(fs);
+        }
+        if (s_direct) {
+            face_ui_present();
+            g_cmd_applied_us.store(static_cast<uint32_t>(esp_timer_get_time()), std::memory_order_release);
+        } else if (lvgl_port_lock(100)) {
+            if (s_canvas_count <= 1) {
+                face_ui_render(fs);
+            }
+            face_ui_present();
             if (FACE_CALIBRATION_MODE) {
                 update_calibration_labels(now_ms, next_touch_cycle_ms);
             }
@@ -1333,6 +801,21 @@ void face_ui_task(void* arg)
             frame_max_us = frame_us;
         }
 
+        // 8. Shed or restore one effect when a governor window closes.
+        if (FACE_QUALITY_GOVERNOR) {
+            const int change = quality_governor_add_frame(quality, frame_us, quality_active(fs, face_flags));
+            if (change != 0 || fs.fx.shed != quality.shed) {
+                apply_face_flags(fs, face_flags, quality.shed);
+            }
+            if (change != 0) {
+                perf_quality_changes++;
+                ESP_LOGI(TAG, "quality %s: level=%u shed=0x%02x p95=%u us budget=%u us",
+                         change > 0 ? "shed" : "restore", static_cast<unsigned>(quality.level),
+                         static_cast<unsigned>(quality.shed), static_cast<unsigned>(quality.last_p95_us),
+                         static_cast<unsigned>(quality.budget_us));
+            }
+        }
+
         if (FACE_PERF_TELEMETRY) {
             perf_window_frames++;
             perf_frame_sum_us += frame_us;
@@ -1355,6 +838,8 @@ void face_ui_task(void* arg)
                 perf_border_sum_us += rp.border_us;
                 perf_effects_sum_us += rp.effects_us;
                 perf_overlay_sum_us += rp.overlay_us;
+                perf_overlap_sum_us += s_last_overlap_us;
+                perf_overlap_render_sum_us += rp.render_us;
                 log_border_samples++;
                 log_border_frame_sum_us += rp.border_frame_us;
                 log_border_buttons_sum_us += rp.border_buttons_us;
@@ -1394,9 +879,38 @@ void face_ui_task(void* arg)
                     perf_cmd_latency_samples > 0U
                         ? static_cast<uint32_t>(perf_cmd_latency_sum_us / perf_cmd_latency_samples)
                         : 0U;
+                const MouthCacheStats mc = mouth_cache_stats();
+                out->mouth_cache_hits = mc.hits - perf_mouth_cache_base.hits;
+                out->mouth_cache_misses = mc.misses - perf_mouth_cache_base.misses;
+                out->mouth_cache_bytes = mc.bytes_used;
+                out->mouth_cache_bytes_total = mc.bytes_total;
+                perf_mouth_cache_base = mc;
+                const FaceRenderStats rs = face_render_stats();
+                const uint32_t        rs_frames = rs.frames - perf_render_stats_base.frames;
+                const uint32_t        rs_skipped = rs.skipped - perf_render_stats_base.skipped;
+                out->idle_skip_frames = static_cast<uint16_t>(rs_skipped > 0xFFFFU ? 0xFFFFU : rs_skipped);
+                out->idle_skip_pct = rs_frames > 0U ? static_cast<uint8_t>(rs_skipped * 100U / rs_frames) : 0U;
+                perf_render_stats_base = rs;
+                const uint32_t display_busy_us = display_busy_at(static_cast<uint32_t>(esp_timer_get_time()));
+                out->flush_us_avg = perf_window_frames > 0U
+                                        ? (display_busy_us - perf_display_busy_base_us) / perf_window_frames
+                                        : 0U;
+                perf_display_busy_base_us = display_busy_us;
+                out->overlap_us_avg =
+                    perf_stage_samples > 0U ? static_cast<uint32_t>(perf_overlap_sum_us / perf_stage_samples) : 0U;
+                out->overlap_pct = perf_overlap_render_sum_us > 0U
+                                       ? static_cast<uint8_t>(perf_overlap_sum_us * 100U / perf_overlap_render_sum_us)
+                                       : 0U;
+                out->canvas_buffers = s_canvas_count;
+                out->direct_present = s_direct ? 1U : 0U;
                 out->perf_sample_div = FACE_PERF_SAMPLE_DIV;
                 out->dirty_rect_enabled = FACE_DIRTY_RECT ? 1U : 0U;
                 out->afterglow_downsample = FACE_AFTERGLOW_DOWNSAMPLE;
+                out->frame_us_p95 = quality.last_p95_us;
+                out->pace_overruns = perf_pace_overruns;
+                out->quality_level = quality.level;
+                out->quality_shed = quality.shed;
+                out->quality_changes = perf_quality_changes;
                 g_face_perf.publish();
 
                 perf_frame_sum_us = 0;
@@ -1409,11 +923,15 @@ void face_ui_task(void* arg)
                 perf_effects_sum_us = 0;
                 perf_overlay_sum_us = 0;
                 perf_stage_samples = 0;
+                perf_overlap_sum_us = 0;
+                perf_overlap_render_sum_us = 0;
                 perf_dirty_px_sum = 0;
                 perf_spi_bytes_sum = 0;
                 perf_cmd_latency_sum_us = 0;
                 perf_cmd_latency_samples = 0;
                 perf_window_frames = 0;
+                perf_pace_overruns = 0;
+                perf_quality_changes = 0;
                 next_perf_pub_ms = now_ms + 1000U;
             }
         }
@@ -1424,22 +942,37 @@ void face_ui_task(void* arg)
                 (log_border_samples > 0) ? static_cast<uint32_t>(log_border_frame_sum_us / log_border_samples) : 0U;
             const uint32_t border_buttons_avg =
                 (log_border_samples > 0) ? static_cast<uint32_t>(log_border_buttons_sum_us / log_border_samples) : 0U;
+            const uint32_t ring_builds = conv_border_stats().ring_builds;
             ESP_LOGI(TAG,
-                     "frame stats avg=%u us max=%u us fps=%.1f system=%u border_frame=%u border_buttons=%u samples=%u",
+                     "frame stats avg=%u us max=%u us fps=%.1f overruns=%u system=%u border_frame=%u "
+                     "border_buttons=%u ring_builds=%u samples=%u",
                      static_cast<unsigned>(avg_us), static_cast<unsigned>(frame_max_us), fps,
-                     static_cast<unsigned>(fs.system.mode), static_cast<unsigned>(border_frame_avg),
-                     static_cast<unsigned>(border_buttons_avg), static_cast<unsigned>(log_border_samples));
+                     static_cast<unsigned>(log_pace_overruns), static_cast<unsigned>(fs.system.mode),
+                     static_cast<unsigned>(border_frame_avg), static_cast<unsigned>(border_buttons_avg),
+                     static_cast<unsigned>(ring_builds - log_ring_builds_base),
+                     static_cast<unsigned>(log_border_samples));
+            log_ring_builds_base = ring_builds;
             frame_count = 0;
             frame_accum_us = 0;
             frame_max_us = 0;
+            log_pace_overruns = 0;
             log_border_samples = 0;
             log_border_frame_sum_us = 0;
             log_border_buttons_sum_us = 0;
             next_frame_log_ms = now_ms + FRAME_TIME_LOG_INTERVAL_MS;
         }
 
-        // 7. Sleep for frame period
+        // 9. Sleep until the next frame deadline. A frame that ran past it is
+        //    counted as an overrun and the schedule restarts after a short
+        //    yield, so late frames do not run back to back to catch up.
         frame_idx++;
-        vTaskDelay(pdMS_TO_TICKS(1000 / ANIM_FPS));
+        pace_start_us += FACE_FRAME_BUDGET_US;
+        const int64_t pace_now_us = esp_timer_get_time();
+        if (pace_now_us >= pace_start_us) {
+            perf_pace_overruns++;
+            log_pace_overruns++;
+            pace_start_us = pace_now_us + PACE_OVERRUN_YIELD_US;
+        }
+        pace_sleep_until(pace_start_us);
     }
 }
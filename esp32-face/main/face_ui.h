@@ -7,9 +7,20 @@
 // Create LVGL objects for the face. Call once after LVGL init.
 void face_ui_create(lv_obj_t* parent);
 
-// Update LVGL objects from FaceState. Call under LVGL lock.
-void face_ui_update(const FaceState& fs);
+// Render FaceState into the back canvas. With direct present or
+// FACE_CANVAS_BUFFERS == 2 this needs no LVGL lock and overlaps the display
+// push; with a single LVGL canvas it draws the displayed buffer, so call it
+// under the LVGL lock.
+void face_ui_render(const FaceState& fs);
+
+// Show the last rendered frame: hand its dirty rects to the direct presenter,
+// or swap canvases and invalidate them in LVGL (call under LVGL lock then).
+void face_ui_present();
 
 // FreeRTOS task: consumes latched state/system/talking commands + gesture queue,
 // updates FaceState, and renders via LVGL.
 void face_ui_task(void* arg);
+
+// FreeRTOS task: render worker for the face's top band (see
+// face_render_set_worker). face_ui_task attaches it once it is running.
+void face_render_worker_task(void* arg);
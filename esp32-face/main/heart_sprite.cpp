@@ -0,0 +1,179 @@
+#include "heart_sprite.h"
+#include "alpha_rle.h"
+#include "config.h"
+
+#include <cmath>
+
+// ═══════════════════════════════════════════════════════════════════
+//  Layout
+// ═══════════════════════════════════════════════════════════════════
+//
+// Size snaps to FACE_HEART_SPRITE_SIZE_STEP px buckets and the center is a
+// whole pixel (the display list rounds it), so a sprite is keyed by its size
+// bucket alone and the center is a blit offset. A sprite is rasterized with
+// the analytic sd_heart the first time its key is drawn and kept as an
+// alpha_rle.h mask whose top-left pixel sits at (x0, y0) relative to the
+// center. Sprites live in fixed arena slots, evicted least-recently-used.
+
+struct SpriteKey {
+    int16_t size = 0; // in FACE_HEART_SPRITE_SIZE_STEP buckets
+
+    bool operator==(const SpriteKey& o) const
+    {
+        return size == o.size;
+    }
+};
+
+struct Sprite {
+    SpriteKey key;
+    int16_t   x0 = 0;
+    int16_t   y0 = 0;
+    uint16_t  rows = 0;
+    uint16_t  bytes = 0;
+    uint32_t  stamp = 0;
+    bool      valid = false;
+};
+
+static Sprite   s_sprites[FACE_HEART_SPRITE_SLOTS];
+static uint8_t  s_arena[FACE_HEART_SPRITE_SLOTS][FACE_HEART_SPRITE_SLOT_BYTES];
+static uint32_t s_clock = 0;
+static uint32_t s_hits = 0;
+static uint32_t s_misses = 0;
+
+static float clampf(float v, float lo, float hi)
+{
+    if (v < lo) return lo;
+    if (v > hi) return hi;
+    return v;
+}
+
+static float smoothstepf(float edge0, float edge1, float x)
+{
+    if (fabsf(edge1 - edge0) < 1e-6f) {
+        return x < edge0 ? 0.0f : 1.0f;
+    }
+    const float t = clampf((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+static float sd_heart(float px, float py, float cx, float cy, float size)
+{
+    const float x = fabsf(px - cx) / size;
+    const float y = (cy - py) / size + 0.5f;
+
+    float d = 0.0f;
+    if (y + x > 1.0f) {
+        const float dx = x - 0.25f;
+        const float dy = y - 0.75f;
+        d = sqrtf(dx * dx + dy * dy) - 0.35355339f;
+    } else {
+        const float dy1 = y - 1.0f;
+        const float d1 = x * x + dy1 * dy1;
+        const float t = fmaxf(x + y, 0.0f) * 0.5f;
+        const float dx2 = x - t;
+        const float dy2 = y - t;
+        const float d2 = dx2 * dx2 + dy2 * dy2;
+        d = sqrtf(fminf(d1, d2));
+        if (x < y) {
+            d = -d;
+        }
+    }
+
+    return d * size;
+}
+
+// ═══════════════════════════════════════════════════════════════════
+//  Miss path: rasterize, draw and record
+// ═══════════════════════════════════════════════════════════════════
+
+static Sprite& pick_victim()
+{
+    Sprite* victim = &s_sprites[0];
+    for (auto& s : s_sprites) {
+        if (!s.valid) return s;
+        if (s.stamp < victim->stamp) victim = &s;
+    }
+    return *victim;
+}
+
+static void draw_miss(pixel_t* buf, const SpriteKey& key, int ox, int oy, uint8_t r, uint8_t g, uint8_t b)
+{
+    const float size = static_cast<float>(key.size) * FACE_HEART_SPRITE_SIZE_STEP;
+    const int   lx0 = static_cast<int>(floorf(-size - 2.0f));
+    const int   lx1 = static_cast<int>(ceilf(size + 2.0f));
+    const int   ly0 = lx0;
+    const int   ly1 = lx1;
+    const int   width = lx1 - lx0;
+    if (width > ALPHA_RLE_MAX_W) return; // far larger than any eye heart
+
+    Sprite* s = &pick_victim();
+    s->valid = false;
+    s->key = key;
+    s->x0 = static_cast<int16_t>(lx0);
+    s->y0 = static_cast<int16_t>(ly0);
+    s->rows = 0;
+    s->bytes = 0;
+    uint8_t* slot = s_arena[s - s_sprites];
+
+    uint8_t alpha[ALPHA_RLE_MAX_W];
+    for (int ly = ly0; ly < ly1; ly++) {
+        const float py = static_cast<float>(ly) + 0.5f;
+        for (int i = 0; i < width; i++) {
+            const float d = sd_heart(static_cast<float>(lx0 + i) + 0.5f, py, 0.0f, 0.0f, size);
+            const float a = 1.0f - smoothstepf(-0.5f, 0.5f, d);
+            alpha[i] = a > 0.01f ? px_alpha_u8(a) : 0;
+        }
+        alpha_row_blit(buf, alpha, width, ox + lx0, oy + ly, r, g, b);
+        if (s && !alpha_rle_encode_row(slot, FACE_HEART_SPRITE_SLOT_BYTES, s->bytes, alpha, width)) {
+            s = nullptr; // does not fit the slot; this size stays uncached
+        } else if (s) {
+            s->rows++;
+        }
+    }
+
+    if (s) {
+        s->stamp = s_clock;
+        s->valid = true;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════
+//  Public API
+// ═══════════════════════════════════════════════════════════════════
+
+void heart_sprite_draw(pixel_t* buf, int cx, int cy, float size, uint8_t r, uint8_t g, uint8_t b)
+{
+    if (size < 1.0f) {
+        return;
+    }
+
+    SpriteKey key;
+    key.size = static_cast<int16_t>(lroundf(size / FACE_HEART_SPRITE_SIZE_STEP));
+    const int ox = cx;
+    const int oy = cy;
+
+    s_clock++;
+    for (auto& s : s_sprites) {
+        if (s.valid && s.key == key) {
+            s.stamp = s_clock;
+            s_hits++;
+            alpha_rle_blit(buf, s_arena[&s - s_sprites], s.rows, ox + s.x0, oy + s.y0, r, g, b);
+            return;
+        }
+    }
+
+    s_misses++;
+    draw_miss(buf, key, ox, oy, r, g, b);
+}
+
+HeartSpriteStats heart_sprite_stats()
+{
+    HeartSpriteStats st;
+    st.hits = s_hits;
+    st.misses = s_misses;
+    for (const auto& s : s_sprites) {
+        if (s.valid) st.bytes_used += s.bytes;
+    }
+    st.bytes_total = sizeof(s_arena);
+    return st;
+}
@@ -0,0 +1,24 @@
+#pragma once
+// Heart sprite cache — anti-aliased heart masks (HEART gesture, LOVE mood)
+// rasterized once per size bucket and stored as run-length alpha spans, then
+// blitted in the fill color at a whole-pixel center. An animated size picks the
+// nearest bucket instead of re-evaluating the heart SDF per pixel every frame.
+
+#include "pixel.h"
+
+#include <cstdint>
+
+// Cumulative counters since boot; callers diff them per window.
+struct HeartSpriteStats {
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t bytes_used = 0;  // encoded mask bytes held by valid sprites
+    uint32_t bytes_total = 0; // static arena size
+};
+
+// Draw a heart of half-extent size (px) centered at the pixel corner (cx, cy)
+// into buf (SCREEN_W x SCREEN_H), clipped to the screen. size snaps to the
+// nearest FACE_HEART_SPRITE_SIZE_STEP bucket.
+void heart_sprite_draw(pixel_t* buf, int cx, int cy, float size, uint8_t r, uint8_t g, uint8_t b);
+
+HeartSpriteStats heart_sprite_stats();
@@ -0,0 +1,325 @@
+#include "mouth_cache.h"
+#include "alpha_rle.h"
+#include "config.h"
+
+#include <cmath>
+#include <cstddef>
+
+// ═══════════════════════════════════════════════════════════════════
+//  Layout
+// ═══════════════════════════════════════════════════════════════════
+//
+// Shape parameters are snapped to 1/Q_SHAPE px (open and half_w optionally to a
+// coarser MouthShape::snap grid first) and the mouth center to 1/Q_PHASE
+// px. The integer part of the center is a blit offset, so moving the mouth
+// sideways by whole pixels reuses the same mask.
+//
+// An entry is an alpha_rle.h mask whose top-left pixel sits at (x0, y0)
+// relative to the integer center. Entries live in fixed arena slots, evicted
+// least-recently-used.
+
+static constexpr float Q_SHAPE = 2.0f; // steps per px for curve / open / half_w / thick
+static constexpr int   Q_PHASE = 4;    // sub-pixel steps for the center
+static constexpr int   MAX_MASK_W = ALPHA_RLE_MAX_W; // cacheable width
+
+struct Key {
+    int16_t curve = 0;
+    int16_t open = 0;
+    int16_t half_w = 0;
+    int16_t thick = 0;
+    uint8_t phase_x = 0;
+    uint8_t phase_y = 0;
+
+    bool operator==(const Key& o) const
+    {
+        return curve == o.curve && open == o.open && half_w == o.half_w && thick == o.thick &&
+               phase_x == o.phase_x && phase_y == o.phase_y;
+    }
+};
+
+struct Entry {
+    Key      key;
+    int16_t  x0 = 0;
+    int16_t  y0 = 0;
+    uint16_t rows = 0;
+    uint16_t bytes = 0;
+    uint32_t stamp = 0;
+    bool     valid = false;
+};
+
+// Quantized shape in mask-local coordinates (center at (cx, cy) inside the
+// first pixel, i.e. 0 <= cx, cy < 1).
+struct Geometry {
+    float cx;
+    float cy;
+    float w;
+    float thick;
+    float curve;
+    float open;
+};
+
+static Entry    s_entries[FACE_MOUTH_CACHE_SLOTS];
+static uint8_t  s_arena[FACE_MOUTH_CACHE_SLOTS][FACE_MOUTH_CACHE_SLOT_BYTES];
+static uint32_t s_clock = 0;
+static uint32_t s_hits = 0;
+static uint32_t s_misses = 0;
+
+static float clampf(float v, float lo, float hi)
+{
+    if (v < lo) return lo;
+    if (v > hi) return hi;
+    return v;
+}
+
+static float smoothstepf(float edge0, float edge1, float x)
+{
+    if (fabsf(edge1 - edge0) < 1e-6f) {
+        return x < edge0 ? 0.0f : 1.0f;
+    }
+    const float t = clampf((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+static int16_t quantize(float v)
+{
+    return static_cast<int16_t>(lroundf(v * Q_SHAPE));
+}
+
+static float snap(float v, float step)
+{
+    return step > 0.0f ? roundf(v / step) * step : v;
+}
+
+// ═══════════════════════════════════════════════════════════════════
+//  Coverage (column-analytic)
+// ═══════════════════════════════════════════════════════════════════
+//
+// For a column the lip centerlines upper_y / lower_y are closed-form in nx, so
+// the stroke's vertical extent is known before touching a pixel. Each column
+// gets a band of rows that can be non-zero and, inside it, a run that is
+// certainly opaque (distance <= half_thick - 1, where the smoothstep is 0).
+// Only the fringe rows in between evaluate the distance and smoothstep. The
+// ranges are padded conservatively and the fringe uses the exact per-pixel
+// formula, so the mask is bit-identical to evaluating the SDF everywhere.
+
+struct MouthColumn {
+    float   upper_y;
+    float   lower_y;
+    int16_t band0; // [band0, band1): rows that may be non-zero
+    int16_t band1;
+    int16_t solid0; // [solid0, solid1): rows that are 255
+    int16_t solid1;
+};
+
+static int16_t clamp_row(float v, int lo, int hi)
+{
+    return static_cast<int16_t>(v < lo ? lo : (v > hi ? hi : v));
+}
+
+static MouthColumn column_setup(const Geometry& g, int lx, int ly0, int ly1)
+{
+    MouthColumn c = {};
+    const float px = static_cast<float>(lx) + 0.5f;
+    const float nx = (px - g.cx) / g.w;
+    if (fabsf(nx) > 1.0f) {
+        c.band0 = c.band1 = static_cast<int16_t>(ly0);
+        return c;
+    }
+
+    const float shape = 1.0f - nx * nx;
+    const float curve_y = g.curve * shape;
+    c.upper_y = g.cy + curve_y - g.open * shape;
+    c.lower_y = g.cy + curve_y + g.open * shape;
+
+    // Row ly is centered at ly + 0.5; eps keeps boundary rows on the exact path.
+    constexpr float eps = 1e-3f;
+    const float     half_thick = g.thick * 0.5f;
+    const float     lo = fminf(c.upper_y, c.lower_y);
+    const float     hi = fmaxf(c.upper_y, c.lower_y);
+    const float     reach = half_thick + 1.0f;
+    c.band0 = clamp_row(floorf(lo - reach - 0.5f), ly0, ly1);
+    c.band1 = clamp_row(ceilf(hi + reach - 0.5f) + 1.0f, ly0, ly1);
+
+    const float core = half_thick - 1.0f;
+    const bool  joined = (g.open > 1.0f && c.upper_y <= c.lower_y) || (hi - lo) <= 2.0f * core;
+    if (core >= 0.0f && joined) {
+        c.solid0 = clamp_row(ceilf(lo - core - 0.5f + eps), ly0, ly1);
+        c.solid1 = clamp_row(floorf(hi + core - 0.5f - eps) + 1.0f, ly0, ly1);
+    }
+    if (c.solid1 < c.solid0) c.solid1 = c.solid0;
+    return c;
+}
+
+static uint8_t fringe_alpha(const Geometry& g, const MouthColumn& c, int ly)
+{
+    const float py = static_cast<float>(ly) + 0.5f;
+
+    float dist = 0.0f;
+    if (g.open > 1.0f && c.upper_y < py && py < c.lower_y) {
+        dist = 0.0f;
+    } else {
+        dist = fminf(fabsf(py - c.upper_y), fabsf(py - c.lower_y));
+    }
+
+    const float half_thick = g.thick * 0.5f;
+    const float alpha = 1.0f - smoothstepf(half_thick - 1.0f, half_thick + 1.0f, dist);
+    return alpha > 0.01f ? px_alpha_u8(alpha) : 0;
+}
+
+static void coverage_row(const Geometry& g, const MouthColumn* cols, int n, int ly, uint8_t* alpha)
+{
+    for (int i = 0; i < n; i++) {
+        const MouthColumn& c = cols[i];
+        if (ly < c.band0 || ly >= c.band1) {
+            alpha[i] = 0;
+        } else if (ly >= c.solid0 && ly < c.solid1) {
+            alpha[i] = 255;
+        } else {
+            alpha[i] = fringe_alpha(g, c, ly);
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════
+//  Miss path: rasterize, draw and record
+// ═══════════════════════════════════════════════════════════════════
+
+// Per-column setup and one row of coverage for draw_miss. Kept off the stack
+// (about 5.6 KB); the mouth is drawn by one band at a time, never concurrently.
+static constexpr int MAX_COLS = SCREEN_W > MAX_MASK_W ? SCREEN_W : MAX_MASK_W;
+static MouthColumn   s_cols[MAX_COLS];
+static uint8_t       s_alpha[MAX_COLS];
+
+static Entry& pick_victim()
+{
+    Entry* victim = &s_entries[0];
+    for (auto& e : s_entries) {
+        if (!e.valid) return e;
+        if (e.stamp < victim->stamp) victim = &e;
+    }
+    return *victim;
+}
+
+static void draw_miss(pixel_t* buf, const Key& key, const Geometry& geo, int ox, int oy, uint8_t r, uint8_t g,
+                      uint8_t b)
+{
+    const float reach_x = geo.w + geo.thick;
+    const float reach_y = fabsf(geo.curve) + geo.open + geo.thick;
+    const int   lx0 = static_cast<int>(floorf(geo.cx - reach_x));
+    const int   lx1 = static_cast<int>(ceilf(geo.cx + reach_x));
+    const int   ly0 = static_cast<int>(floorf(geo.cy - reach_y));
+    const int   ly1 = static_cast<int>(ceilf(geo.cy + reach_y));
+    const int   width = lx1 - lx0;
+    if (width <= 0 || ly1 <= ly0) return;
+
+    // Cacheable shapes are rasterized over their whole width; anything wider
+    // is drawn uncached over its on-screen columns only.
+    Entry* e = nullptr;
+    int    c_lo = lx0;
+    int    c_hi = lx1;
+    if (width <= MAX_MASK_W) {
+        e = &pick_victim();
+        e->valid = false;
+        e->key = key;
+        e->x0 = static_cast<int16_t>(lx0);
+        e->y0 = static_cast<int16_t>(ly0);
+        e->rows = 0;
+        e->bytes = 0;
+    } else {
+        if (c_lo < -ox) c_lo = -ox;
+        if (c_hi > SCREEN_W - ox) c_hi = SCREEN_W - ox;
+        if (c_hi <= c_lo) return;
+    }
+    uint8_t*  slot = e ? s_arena[e - s_entries] : nullptr;
+    const int n = c_hi - c_lo;
+
+    for (int i = 0; i < n; i++) {
+        s_cols[i] = column_setup(geo, c_lo + i, ly0, ly1);
+    }
+
+    for (int ly = ly0; ly < ly1; ly++) {
+        coverage_row(geo, s_cols, n, ly, s_alpha);
+        alpha_row_blit(buf, s_alpha, n, ox + c_lo, oy + ly, r, g, b);
+        if (e && !alpha_rle_encode_row(slot, FACE_MOUTH_CACHE_SLOT_BYTES, e->bytes, s_alpha, n)) {
+            e = nullptr; // does not fit the slot; this shape stays uncached
+        } else if (e) {
+            e->rows++;
+        }
+    }
+
+    if (e) {
+        e->stamp = s_clock;
+        e->valid = true;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════
+//  Public API
+// ═══════════════════════════════════════════════════════════════════
+
+MouthKey mouth_cache_key(const MouthShape& shape)
+{
+    MouthKey k;
+    k.curve = quantize(shape.curve);
+    k.open = quantize(snap(shape.open, shape.snap));
+    k.half_w = quantize(snap(shape.half_w, shape.snap));
+    k.thick = quantize(shape.thick);
+    int ox = 0;
+    int oy = 0;
+    alpha_rle_origin(shape.cx, Q_PHASE, ox, k.phase_x);
+    alpha_rle_origin(shape.cy, Q_PHASE, oy, k.phase_y);
+    k.ox = static_cast<int16_t>(ox);
+    k.oy = static_cast<int16_t>(oy);
+    return k;
+}
+
+void mouth_cache_draw(pixel_t* buf, const MouthShape& shape, uint8_t r, uint8_t g, uint8_t b)
+{
+    mouth_cache_draw(buf, mouth_cache_key(shape), r, g, b);
+}
+
+void mouth_cache_draw(pixel_t* buf, const MouthKey& mk, uint8_t r, uint8_t g, uint8_t b)
+{
+    Key key;
+    key.curve = mk.curve;
+    key.open = mk.open;
+    key.half_w = mk.half_w;
+    key.thick = mk.thick;
+    key.phase_x = mk.phase_x;
+    key.phase_y = mk.phase_y;
+    const int ox = mk.ox;
+    const int oy = mk.oy;
+    if (key.half_w <= 0) return;
+
+    s_clock++;
+    for (auto& e : s_entries) {
+        if (e.valid && e.key == key) {
+            e.stamp = s_clock;
+            s_hits++;
+            alpha_rle_blit(buf, s_arena[&e - s_entries], e.rows, ox + e.x0, oy + e.y0, r, g, b);
+            return;
+        }
+    }
+
+    s_misses++;
+    Geometry geo;
+    geo.cx = static_cast<float>(key.phase_x) / Q_PHASE;
+    geo.cy = static_cast<float>(key.phase_y) / Q_PHASE;
+    geo.w = static_cast<float>(key.half_w) / Q_SHAPE;
+    geo.thick = static_cast<float>(key.thick) / Q_SHAPE;
+    geo.curve = static_cast<float>(key.curve) / Q_SHAPE;
+    geo.open = static_cast<float>(key.open) / Q_SHAPE;
+    draw_miss(buf, key, geo, ox, oy, r, g, b);
+}
+
+MouthCacheStats mouth_cache_stats()
+{
+    MouthCacheStats st;
+    st.hits = s_hits;
+    st.misses = s_misses;
+    for (const auto& e : s_entries) {
+        if (e.valid) st.bytes_used += e.bytes;
+    }
+    st.bytes_total = sizeof(s_arena);
+    return st;
+}
@@ -0,0 +1,57 @@
+#pragma once
+// Mouth coverage cache — anti-aliased mouth masks stored as run-length alpha
+// spans, keyed on the quantized mouth shape. Talking cycles through a small set
+// of shapes, so most frames blit a cached mask in the emotion color instead of
+// re-evaluating the mouth SDF per pixel.
+
+#include "pixel.h"
+
+#include <cstdint>
+
+// Mouth shape in screen pixels (see render_mouth in face_render.cpp).
+struct MouthShape {
+    float cx = 0.0f;
+    float cy = 0.0f;
+    float half_w = 0.0f;
+    float thick = 0.0f;
+    float curve = 0.0f;
+    float open = 0.0f;
+    float snap = 0.0f; // > 0: snap open and half_w to this grid (px) first
+};
+
+// Cumulative counters since boot; callers diff them per window.
+struct MouthCacheStats {
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t bytes_used = 0;  // encoded mask bytes held by valid entries
+    uint32_t bytes_total = 0; // static arena size
+};
+
+// A mouth shape as the cache quantizes it: mask parameters in 1/2 px, the
+// center's sub-pixel phase and its integer origin. Equal keys draw the same
+// pixels, so the face renderer diffs frames on them.
+struct MouthKey {
+    int16_t curve = 0;
+    int16_t open = 0;
+    int16_t half_w = 0; // <= 0: nothing to draw
+    int16_t thick = 0;
+    uint8_t phase_x = 0;
+    uint8_t phase_y = 0;
+    int16_t ox = 0;
+    int16_t oy = 0;
+
+    bool operator==(const MouthKey& o) const
+    {
+        return curve == o.curve && open == o.open && half_w == o.half_w && thick == o.thick &&
+               phase_x == o.phase_x && phase_y == o.phase_y && ox == o.ox && oy == o.oy;
+    }
+    bool operator!=(const MouthKey& o) const { return !(*this == o); }
+};
+
+MouthKey mouth_cache_key(const MouthShape& shape);
+
+// Draw the mouth into buf (SCREEN_W x SCREEN_H), clipped to the screen.
+void mouth_cache_draw(pixel_t* buf, const MouthShape& shape, uint8_t r, uint8_t g, uint8_t b);
+void mouth_cache_draw(pixel_t* buf, const MouthKey& key, uint8_t r, uint8_t g, uint8_t b);
+
+MouthCacheStats mouth_cache_stats();
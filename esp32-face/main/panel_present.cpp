@@ -0,0 +1,159 @@
+#include "panel_present.h"
+#include "config.h"
+
+#include "esp_heap_caps.h"
+#include "esp_lcd_panel_ops.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include <atomic>
+#include <cstring>
+
+static const char* TAG = "panel_present";
+
+// ═══════════════════════════════════════════════════════════════════
+//  Staging
+// ═══════════════════════════════════════════════════════════════════
+//
+// Canvas rows are SCREEN_W apart in PSRAM, so a rect narrower than the screen
+// is not one contiguous block. Each rect is cut into strips of whole rows that
+// fit FACE_PRESENT_STRIP_PX, copied into one of two internal DMA buffers, and
+// queued with esp_lcd_panel_draw_bitmap(). The canvas is already in panel
+// byte order (FACE_PIXEL_SWAPPED), so the copy is a plain memcpy per row.
+//
+// draw_bitmap() sends CASET/RASET as polled parameters, and the SPI panel IO
+// drains every queued color transfer before a parameter write. So when a
+// strip is queued the previous one has finished: the other staging buffer is
+// free to fill while this one is on the bus.
+
+static esp_lcd_panel_handle_t s_panel = nullptr;
+static pixel_t*               s_stage[2] = {};
+static uint8_t                s_stage_idx = 0;
+
+static SemaphoreHandle_t s_go = nullptr;   // face_ui -> task: frame queued
+static SemaphoreHandle_t s_done = nullptr; // task -> face_ui: canvas released
+static const pixel_t*    s_canvas = nullptr;
+static DirtyRegion       s_dirty = {};
+static bool              s_in_flight = false; // face_ui side only
+
+static std::atomic<bool>     s_busy{false};
+static std::atomic<uint32_t> s_busy_start_us{0};
+static std::atomic<uint32_t> s_busy_us{0};
+
+static void copy_row(pixel_t* dst, const pixel_t* src, int n)
+{
+    if (FACE_PIXEL_SWAPPED) {
+        std::memcpy(dst, src, n * sizeof(pixel_t));
+        return;
+    }
+    for (int i = 0; i < n; i++) {
+        dst[i] = px_bswap(src[i]);
+    }
+}
+
+static void push_rect(const RectI& r)
+{
+    const int w = r.x1 - r.x0 + 1;
+    const int rows_per_strip = FACE_PRESENT_STRIP_PX / w;
+    for (int y = r.y0; y <= r.y1; y += rows_per_strip) {
+        const int rows = (r.y1 - y + 1) < rows_per_strip ? (r.y1 - y + 1) : rows_per_strip;
+        pixel_t* stage = s_stage[s_stage_idx];
+        s_stage_idx ^= 1;
+
+        const pixel_t* src = s_canvas + y * SCREEN_W + r.x0;
+        for (int k = 0; k < rows; k++) {
+            copy_row(stage + k * w, src + k * SCREEN_W, w);
+        }
+        esp_lcd_panel_draw_bitmap(s_panel, r.x0, y, r.x1 + 1, y + rows, stage);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════
+//  Presenter (face_ui side)
+// ═══════════════════════════════════════════════════════════════════
+
+static void present(void* ctx, const pixel_t* canvas, const DirtyRegion& dirty)
+{
+    (void)ctx;
+    s_canvas = canvas;
+    s_dirty = dirty;
+    s_in_flight = true;
+    xSemaphoreGive(s_go);
+}
+
+static void wait(void* ctx)
+{
+    (void)ctx;
+    if (!s_in_flight) return;
+    xSemaphoreTake(s_done, portMAX_DELAY);
+    s_in_flight = false;
+}
+
+// ═══════════════════════════════════════════════════════════════════
+//  Public API
+// ═══════════════════════════════════════════════════════════════════
+
+bool panel_present_init(esp_lcd_panel_handle_t panel)
+{
+    for (auto& stage : s_stage) {
+        stage = static_cast<pixel_t*>(
+            heap_caps_malloc(FACE_PRESENT_STRIP_PX * sizeof(pixel_t), MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL));
+        if (!stage) {
+            ESP_LOGE(TAG, "failed to allocate %u-px DMA staging strip", static_cast<unsigned>(FACE_PRESENT_STRIP_PX));
+            return false;
+        }
+    }
+    s_go = xSemaphoreCreateBinary();
+    s_done = xSemaphoreCreateBinary();
+    if (!s_go || !s_done) {
+        ESP_LOGE(TAG, "failed to create present semaphores");
+        return false;
+    }
+    s_panel = panel;
+    ESP_LOGI(TAG, "direct present ready (2 x %u-px strips)", static_cast<unsigned>(FACE_PRESENT_STRIP_PX));
+    return true;
+}
+
+FacePresenter panel_presenter(void)
+{
+    FacePresenter p;
+    if (!s_panel) return p;
+    p.present = present;
+    p.wait = wait;
+    return p;
+}
+
+uint32_t panel_present_busy_us(uint32_t now_us)
+{
+    uint32_t busy = s_busy_us.load(std::memory_order_acquire);
+    if (s_busy.load(std::memory_order_acquire)) {
+        busy += now_us - s_busy_start_us.load(std::memory_order_relaxed);
+    }
+    return busy;
+}
+
+void panel_present_task(void* arg)
+{
+    (void)arg;
+    ESP_LOGI(TAG, "panel present task started");
+
+    for (;;) {
+        xSemaphoreTake(s_go, portMAX_DELAY);
+        const uint32_t start_us = static_cast<uint32_t>(esp_timer_get_time());
+        s_busy_start_us.store(start_us, std::memory_order_relaxed);
+        s_busy.store(true, std::memory_order_release);
+
+        face_present_for_each_rect(s_dirty, push_rect);
+
+        // The last strip may still be on the bus, but it is staged: the
+        // canvas is free.
+        const uint32_t end_us = static_cast<uint32_t>(esp_timer_get_time());
+        s_busy_us.fetch_add(end_us - start_us, std::memory_order_release);
+        s_busy.store(false, std::memory_order_release);
+        xSemaphoreGive(s_done);
+    }
+}
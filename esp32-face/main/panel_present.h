@@ -0,0 +1,26 @@
+#pragma once
+// Direct face presentation: dirty rects go from the canvas to the ILI9341 via
+// esp_lcd_panel_draw_bitmap() DMA, without LVGL's refresh or draw buffers.
+
+#include "face_present.h"
+
+#include "esp_lcd_types.h"
+
+#include <cstdint>
+
+// Allocate the DMA staging strips and sync objects. Call once after
+// display_init(), before panel_present_task starts. Returns false (and leaves
+// the presenter unusable) if internal DMA memory is short.
+bool panel_present_init(esp_lcd_panel_handle_t panel);
+
+// Presenter handle for face_ui. present is nullptr unless panel_present_init()
+// succeeded, in which case face_ui keeps presenting through LVGL.
+FacePresenter panel_presenter(void);
+
+// Cumulative time the present task has spent pushing frames, counting an
+// in-progress push up to now_us. Differences give the push time in a window.
+uint32_t panel_present_busy_us(uint32_t now_us);
+
+// FreeRTOS task: copies presented rects into the staging strips and queues
+// them to the panel.
+void panel_present_task(void* arg);
@@ -0,0 +1,42 @@
+#pragma once
+// Drawing for the particle pools (particles.h): a white pixel per sparkle, a
+// 3x3 ember per fire particle colored by heat. Footprints must match
+// compute_particles() in face_render.cpp, which marks them dirty.
+
+#include "particles.h"
+#include "pixel_span.h"
+
+template <int N>
+void sparkle_draw(pixel_t* buf, const SparklePool<N>& p)
+{
+    const pixel_t white = px_rgb(255, 255, 255);
+    for (int i = 0; i < p.count; i++) {
+        buf[p.y[i] * SCREEN_W + p.x[i]] = white;
+    }
+}
+
+inline pixel_t fire_color(float heat)
+{
+    if (heat > 0.85f) return px_rgb(255, 220, 120);
+    if (heat > 0.65f) return px_rgb(255, 140, 20);
+    if (heat > 0.40f) return px_rgb(220, 50, 0);
+    return px_rgb(130, 20, 0);
+}
+
+template <int N>
+void fire_draw(pixel_t* buf, const FirePool<N>& p)
+{
+    for (int i = 0; i < p.count; i++) {
+        const int x = static_cast<int>(p.x[i]);
+        const int y = static_cast<int>(p.y[i]);
+        if (x < 0 || x >= SCREEN_W || y < 0 || y >= SCREEN_H) continue;
+        const int     x0 = x > 0 ? x - 1 : 0;
+        const int     x1 = x + 1 < SCREEN_W ? x + 2 : SCREEN_W;
+        const int     y0 = y > 0 ? y - 1 : 0;
+        const int     y1 = y + 1 < SCREEN_H ? y + 2 : SCREEN_H;
+        const pixel_t c = fire_color(p.heat[i]);
+        for (int py = y0; py < y1; py++) {
+            px_span_fill(buf + py * SCREEN_W + x0, x1 - x0, c);
+        }
+    }
+}
@@ -0,0 +1,115 @@
+#pragma once
+// Sparkle and fire particle pools — struct-of-arrays with the live particles
+// packed at the front. Indices [0, count) are alive; a particle that dies is
+// replaced by the last live one, so stepping, drawing (particle_draw.h) and
+// the dirty tiles touch only live particles in contiguous arrays. Capacities
+// are template parameters: EffectsState uses MAX_SPARKLE_PIXELS and
+// MAX_FIRE_PIXELS, host/particle_bench instantiates larger pools.
+
+#include "config.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+
+template <int N>
+struct SparklePool {
+    static_assert(N > 0, "empty sparkle pool");
+    static constexpr int CAPACITY = N;
+
+    int16_t x[N]{};
+    int16_t y[N]{};
+    uint8_t life[N]{}; // steps left, > 0 while alive
+    int     count = 0;
+
+    void remove(int i)
+    {
+        const int last = --count;
+        x[i] = x[last];
+        y[i] = y[last];
+        life[i] = life[last];
+    }
+};
+
+template <int N>
+struct FirePool {
+    static_assert(N > 0, "empty fire pool");
+    static constexpr int CAPACITY = N;
+
+    float x[N]{};
+    float y[N]{};
+    float life[N]{}; // steps left
+    float heat[N]{}; // 1 at spawn, cools every step
+    int   count = 0;
+
+    void remove(int i)
+    {
+        const int last = --count;
+        x[i] = x[last];
+        y[i] = y[last];
+        life[i] = life[last];
+        heat[i] = heat[last];
+    }
+};
+
+inline float particle_randf()
+{
+    return static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+}
+
+inline float particle_randf_range(float lo, float hi)
+{
+    return lo + particle_randf() * (hi - lo);
+}
+
+// One fixed step: age every sparkle, then `burst` times spawn one at a random
+// pixel with probability `chance` while there is room.
+template <int N>
+void sparkle_step(SparklePool<N>& p, float chance, int burst = 1)
+{
+    for (int i = 0; i < p.count;) {
+        if (--p.life[i] == 0) {
+            p.remove(i); // the moved particle is stepped at i next
+        } else {
+            i++;
+        }
+    }
+
+    for (int b = 0; b < burst; b++) {
+        if (particle_randf() >= chance || p.count >= N) continue;
+        const int i = p.count++;
+        p.x[i] = static_cast<int16_t>(rand() % SCREEN_W);
+        p.y[i] = static_cast<int16_t>(rand() % SCREEN_H);
+        p.life[i] = static_cast<uint8_t>(5 + (rand() % 11));
+    }
+}
+
+// One fixed step: embers drift and rise, cool and burn out; then `burst` times
+// with probability 0.3, one spawns above each eye while there is room.
+template <int N>
+void fire_step(FirePool<N>& p, int burst = 1)
+{
+    for (int i = 0; i < p.count;) {
+        p.x[i] += particle_randf_range(-1.5f, 1.5f);
+        p.y[i] -= 3.0f;
+        p.life[i] -= 1.0f;
+        p.heat[i] *= 0.9f;
+        if (p.life[i] <= 1.0f || p.y[i] < 0.0f) {
+            p.remove(i);
+        } else {
+            i++;
+        }
+    }
+
+    for (int b = 0; b < burst; b++) {
+        if (particle_randf() >= 0.3f) continue;
+        for (float cx : {LEFT_EYE_CX, RIGHT_EYE_CX}) {
+            if (p.count >= N) break;
+            const int i = p.count++;
+            p.x[i] = cx + particle_randf_range(-20.0f, 20.0f);
+            p.y[i] = LEFT_EYE_CY - 30.0f;
+            p.life[i] = static_cast<float>(5 + (rand() % 11));
+            p.heat[i] = 1.0f;
+        }
+    }
+}
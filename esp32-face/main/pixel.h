@@ -1,85 +1,136 @@
 #pragma once
 // RGB565 pixel helpers for direct-buffer rendering.
 // Format: RRRRRGGGGGGBBBBB (5-6-5 bit layout within uint16_t)
+//
+// Pixels are stored in one of two byte orders. PxOrder::NATIVE keeps the
+// 5-6-5 value in CPU order. PxOrder::SWAPPED stores it byte-swapped, which on
+// the little-endian ESP32-S3 is the big-endian stream the ILI9341 expects, so
+// the canvas goes to the panel untouched. Every helper takes the order as a
+// template parameter defaulting to the canvas order PX_ORDER
+// (FACE_PIXEL_SWAPPED in config.h); callers never see the difference.
+
+#include "config.h"
 
 #include <cstdint>
 
 using pixel_t = uint16_t;
 
+enum class PxOrder : uint8_t {
+    NATIVE,
+    SWAPPED,
+};
+
+constexpr PxOrder PX_ORDER = FACE_PIXEL_SWAPPED ? PxOrder::SWAPPED : PxOrder::NATIVE;
+
+// ---- Byte order -------------------------------------------------------------
+
+constexpr pixel_t px_bswap(pixel_t p)
+{
+    return static_cast<pixel_t>((p << 8) | (p >> 8));
+}
+
+// Converts between the 5-6-5 value and its stored form (the same swap both
+// ways). Also normalizes a canvas of order O for comparison.
+template <PxOrder O = PX_ORDER>
+constexpr pixel_t px_order(pixel_t p)
+{
+    return O == PxOrder::SWAPPED ? px_bswap(p) : p;
+}
+
 // ---- Encode / Decode --------------------------------------------------------
 
+template <PxOrder O = PX_ORDER>
 inline pixel_t px_rgb(uint8_t r, uint8_t g, uint8_t b)
 {
-    return static_cast<pixel_t>(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+    return px_order<O>(static_cast<pixel_t>(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)));
 }
 
+template <PxOrder O = PX_ORDER>
 inline uint8_t px_r(pixel_t p)
 {
-    const uint8_t r5 = static_cast<uint8_t>((p >> 11) & 0x1F);
+    const uint8_t r5 = static_cast<uint8_t>((px_order<O>(p) >> 11) & 0x1F);
     return static_cast<uint8_t>((r5 << 3) | (r5 >> 2));
 }
 
+template <PxOrder O = PX_ORDER>
 inline uint8_t px_g(pixel_t p)
 {
-    const uint8_t g6 = static_cast<uint8_t>((p >> 5) & 0x3F);
+    const uint8_t g6 = static_cast<uint8_t>((px_order<O>(p) >> 5) & 0x3F);
     return static_cast<uint8_t>((g6 << 2) | (g6 >> 4));
 }
 
+template <PxOrder O = PX_ORDER>
 inline uint8_t px_b(pixel_t p)
 {
-    const uint8_t b5 = static_cast<uint8_t>(p & 0x1F);
+    const uint8_t b5 = static_cast<uint8_t>(px_order<O>(p) & 0x1F);
     return static_cast<uint8_t>((b5 << 3) | (b5 >> 2));
 }
 
 // ---- Arithmetic -------------------------------------------------------------
+template <PxOrder O = PX_ORDER>
 inline pixel_t px_scale(pixel_t p, uint8_t num, uint8_t den)
 {
-    const uint16_t r = static_cast<uint16_t>(((p >> 11) & 0x1F) * num / den);
-    const uint16_t g = static_cast<uint16_t>(((p >> 5) & 0x3F) * num / den);
-    const uint16_t b = static_cast<uint16_t>((p & 0x1F) * num / den);
-    return static_cast<pixel_t>((r << 11) | (g << 5) | b);
+    const pixel_t  v = px_order<O>(p);
+    const uint16_t r = static_cast<uint16_t>(((v >> 11) & 0x1F) * num / den);
+    const uint16_t g = static_cast<uint16_t>(((v >> 5) & 0x3F) * num / den);
+    const uint16_t b = static_cast<uint16_t>((v & 0x1F) * num / den);
+    return px_order<O>(static_cast<pixel_t>((r << 11) | (g << 5) | b));
 }
 
-inline pixel_t px_blend(pixel_t bg, uint8_t r, uint8_t g, uint8_t b, float alpha)
+// ---- Fixed-point blending (alpha 0..255) -----------------------------------
+// Integer replacement for the old float path bg + (fg - bg) * alpha, computed
+// on the 8-bit expansion of bg. Within +-1 LSB per 565 channel of the float
+// result (exhaustively checked by host/test_pixel_blend.cpp).
+
+inline uint8_t px_alpha_u8(float alpha)
 {
-    if (alpha >= 0.999f) return px_rgb(r, g, b);
-    if (alpha <= 0.001f) return bg;
-    const uint8_t bg_r = px_r(bg);
-    const uint8_t bg_g = px_g(bg);
-    const uint8_t bg_b = px_b(bg);
-    return px_rgb(static_cast<uint8_t>(bg_r + static_cast<int>((r - bg_r) * alpha)),
-                  static_cast<uint8_t>(bg_g + static_cast<int>((g - bg_g) * alpha)),
-                  static_cast<uint8_t>(bg_b + static_cast<int>((b - bg_b) * alpha)));
+    if (alpha <= 0.0f) return 0;
+    if (alpha >= 1.0f) return 255;
+    return static_cast<uint8_t>(alpha * 255.0f + 0.5f);
 }
 
-// Experimental fixed-point blend for post-baseline A/B profiling.
-// Keep disabled for baseline fidelity; enable only when callsites are explicitly
-// migrated to pass alpha in 0..255 space.
-//
-// inline pixel_t px_scale_255(pixel_t p, uint8_t scale_255)
-// {
-//     if (scale_255 == 255) return p;
-//     if (scale_255 == 0) return 0;
-//
-//     const uint16_t r = (((p >> 11) & 0x1F) * scale_255) >> 8;
-//     const uint16_t g = (((p >> 5) & 0x3F) * scale_255) >> 8;
-//     const uint16_t b = ((p & 0x1F) * scale_255) >> 8;
-//
-//     return static_cast<pixel_t>((r << 11) | (g << 5) | b);
-// }
-//
-// inline pixel_t px_blend_u8(pixel_t bg, uint8_t r, uint8_t g, uint8_t b, uint8_t alpha)
-// {
-//     if (alpha == 255) return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
-//     if (alpha == 0) return bg;
-//
-//     const uint8_t bg_r = (bg >> 8) & 0xF8;
-//     const uint8_t bg_g = (bg >> 3) & 0xFC;
-//     const uint8_t bg_b = (bg << 3) & 0xF8;
-//
-//     const uint8_t out_r = bg_r + (((r - bg_r) * alpha) >> 8);
-//     const uint8_t out_g = bg_g + (((g - bg_g) * alpha) >> 8);
-//     const uint8_t out_b = bg_b + (((b - bg_b) * alpha) >> 8);
-//
-//     return ((out_r & 0xF8) << 8) | ((out_g & 0xFC) << 3) | (out_b >> 3);
-// }
+// bg + (fg - bg) * a / 256, with a in 0..256.
+inline int px_lerp_ch(int bg, int fg, int a256)
+{
+    return bg + (((fg - bg) * a256) >> 8);
+}
+
+template <PxOrder O = PX_ORDER>
+inline pixel_t px_blend_u8(pixel_t bg, uint8_t r, uint8_t g, uint8_t b, uint8_t alpha)
+{
+    if (alpha == 255) return px_rgb<O>(r, g, b);
+    if (alpha == 0) return bg;
+    const int a256 = alpha + (alpha >> 7); // 0..255 -> 0..256
+    return px_rgb<O>(static_cast<uint8_t>(px_lerp_ch(px_r<O>(bg), r, a256)),
+                     static_cast<uint8_t>(px_lerp_ch(px_g<O>(bg), g, a256)),
+                     static_cast<uint8_t>(px_lerp_ch(px_b<O>(bg), b, a256)));
+}
+
+// p * s256 / 256 per channel, s256 in 0..256. Shared by px_scale_255 and the
+// span kernels in pixel_span.h.
+template <PxOrder O = PX_ORDER>
+inline pixel_t px_scale_q8(pixel_t p, uint32_t s256)
+{
+    const pixel_t  v = px_order<O>(p);
+    const uint32_t r = (((v >> 11) & 0x1Fu) * s256) >> 8;
+    const uint32_t g = (((v >> 5) & 0x3Fu) * s256) >> 8;
+    const uint32_t b = ((v & 0x1Fu) * s256) >> 8;
+    return px_order<O>(static_cast<pixel_t>((r << 11) | (g << 5) | b));
+}
+
+// Q8 multiplier for a num/den ratio, rounded up so that px_scale_q8 floors to
+// the same value as px_scale(p, num, den). That holds for small den only;
+// host/test_pixel_span.cpp checks every ratio the renderer uses.
+constexpr uint32_t px_q8_ratio(uint32_t num, uint32_t den)
+{
+    return (256u * num + den - 1u) / den;
+}
+
+// p * scale / 255 per channel (scale 255 = identity, 0 = black).
+template <PxOrder O = PX_ORDER>
+inline pixel_t px_scale_255(pixel_t p, uint8_t scale)
+{
+    if (scale == 255) return p;
+    if (scale == 0) return 0;
+    return px_scale_q8<O>(p, scale + (scale >> 7));
+}
@@ -0,0 +1,187 @@
+#pragma once
+// Row kernels for RGB565 spans, two pixels per 32-bit word (SWAR).
+//
+// Each kernel peels one scalar pixel to reach 4-byte alignment, runs the word
+// loop, then finishes an odd tail pixel. Channel math keeps each pixel in its
+// own 16-bit lane and never carries across it, so results are bit-identical to
+// the scalar helpers in pixel.h (host/test_pixel_span.cpp checks this) and the
+// lane order does not depend on endianness. Byte-swapped canvases (PxOrder::
+// SWAPPED) swap each lane into 5-6-5 order around the math and back.
+
+#include "pixel.h"
+
+#include <cstdint>
+
+// uint32_t view of the pixel buffer; may_alias keeps the word loads legal
+// against pixel_t stores.
+typedef uint32_t __attribute__((__may_alias__)) px_pair_t;
+
+// ---- Lane helpers -----------------------------------------------------------
+
+constexpr uint32_t PX_LANE5 = 0x001F001Fu;
+constexpr uint32_t PX_LANE6 = 0x003F003Fu;
+constexpr uint32_t PX_LANE8 = 0x00FF00FFu;
+
+inline bool px_span_aligned(const pixel_t* p)
+{
+    return (reinterpret_cast<uintptr_t>(p) & 3u) == 0;
+}
+
+inline uint32_t px_pair(pixel_t p)
+{
+    return static_cast<uint32_t>(p) | (static_cast<uint32_t>(p) << 16);
+}
+
+// px_order for both lanes of a word.
+template <PxOrder O = PX_ORDER>
+inline uint32_t px_pair_order(uint32_t w)
+{
+    if (O == PxOrder::NATIVE) return w;
+    return ((w & PX_LANE8) << 8) | ((w >> 8) & PX_LANE8);
+}
+
+inline uint32_t px_pair_scale_q8(uint32_t w, uint32_t s256)
+{
+    const uint32_t r = ((((w >> 11) & PX_LANE5) * s256) >> 8) & PX_LANE5;
+    const uint32_t g = ((((w >> 5) & PX_LANE6) * s256) >> 8) & PX_LANE6;
+    const uint32_t b = (((w & PX_LANE5) * s256) >> 8) & PX_LANE5;
+    return (r << 11) | (g << 5) | b;
+}
+
+// Same math as px_blend_u8: bg8 + ((fg8 - bg8) * a256 >> 8) rewritten as
+// (bg8 * (256 - a256) + fg8 * a256) >> 8, which stays non-negative and under
+// 16 bits per lane. fg_* are the per-lane fg8 * a256 terms, pre-paired.
+inline uint32_t px_pair_blend(uint32_t w, uint32_t fg_r, uint32_t fg_g, uint32_t fg_b, uint32_t inv)
+{
+    const uint32_t r5 = (w >> 11) & PX_LANE5;
+    const uint32_t g6 = (w >> 5) & PX_LANE6;
+    const uint32_t b5 = w & PX_LANE5;
+    const uint32_t r8 = (r5 << 3) | ((r5 >> 2) & 0x00070007u);
+    const uint32_t g8 = (g6 << 2) | ((g6 >> 4) & 0x00030003u);
+    const uint32_t b8 = (b5 << 3) | ((b5 >> 2) & 0x00070007u);
+    const uint32_t r = (((r8 * inv + fg_r) >> 8) & PX_LANE8) >> 3;
+    const uint32_t g = (((g8 * inv + fg_g) >> 8) & PX_LANE8) >> 2;
+    const uint32_t b = (((b8 * inv + fg_b) >> 8) & PX_LANE8) >> 3;
+    return ((r & PX_LANE5) << 11) | ((g & PX_LANE6) << 5) | (b & PX_LANE5);
+}
+
+// ---- Kernels ----------------------------------------------------------------
+
+// dst[0..n) = color.
+inline void px_span_fill(pixel_t* dst, int n, pixel_t color)
+{
+    if (n <= 0) return;
+    if (!px_span_aligned(dst)) {
+        *dst++ = color;
+        n--;
+    }
+    const uint32_t w = px_pair(color);
+    px_pair_t*     d = reinterpret_cast<px_pair_t*>(dst);
+    for (int i = 0; i < n / 2; i++) {
+        d[i] = w;
+    }
+    if (n & 1) dst[n - 1] = color;
+}
+
+// dst[i] = px_scale_q8(dst[i], s256), s256 in 0..256.
+template <PxOrder O = PX_ORDER>
+inline void px_span_scale(pixel_t* dst, int n, uint32_t s256)
+{
+    if (n <= 0 || s256 >= 256) return;
+    if (!px_span_aligned(dst)) {
+        *dst = px_scale_q8<O>(*dst, s256);
+        dst++;
+        n--;
+    }
+    px_pair_t* d = reinterpret_cast<px_pair_t*>(dst);
+    for (int i = 0; i < n / 2; i++) {
+        d[i] = px_pair_order<O>(px_pair_scale_q8(px_pair_order<O>(d[i]), s256));
+    }
+    if (n & 1) dst[n - 1] = px_scale_q8<O>(dst[n - 1], s256);
+}
+
+// dst[i] = px_blend_u8(dst[i], r, g, b, alpha) with one alpha for the span.
+template <PxOrder O = PX_ORDER>
+inline void px_span_blend(pixel_t* dst, int n, uint8_t r, uint8_t g, uint8_t b, uint8_t alpha)
+{
+    if (n <= 0 || alpha == 0) return;
+    if (alpha == 255) {
+        px_span_fill(dst, n, px_rgb<O>(r, g, b));
+        return;
+    }
+    if (!px_span_aligned(dst)) {
+        *dst = px_blend_u8<O>(*dst, r, g, b, alpha);
+        dst++;
+        n--;
+    }
+    const uint32_t a256 = alpha + (alpha >> 7);
+    const uint32_t inv = 256u - a256;
+    const uint32_t fg_r = (r * a256) * 0x00010001u;
+    const uint32_t fg_g = (g * a256) * 0x00010001u;
+    const uint32_t fg_b = (b * a256) * 0x00010001u;
+    px_pair_t*     d = reinterpret_cast<px_pair_t*>(dst);
+    for (int i = 0; i < n / 2; i++) {
+        d[i] = px_pair_order<O>(px_pair_blend(px_pair_order<O>(d[i]), fg_r, fg_g, fg_b, inv));
+    }
+    if (n & 1) dst[n - 1] = px_blend_u8<O>(dst[n - 1], r, g, b, alpha);
+}
+
+// dst[i] = px_blend_u8(dst[i], r, g, b, mask[i]). AA masks are mostly 0 or
+// 255 with a thin fringe, so pairs with equal alpha take the word path and
+// mixed pairs fall back to scalar.
+template <PxOrder O = PX_ORDER>
+inline void px_span_blend_mask(pixel_t* dst, const uint8_t* mask, int n, uint8_t r, uint8_t g, uint8_t b)
+{
+    if (n <= 0) return;
+    if (!px_span_aligned(dst)) {
+        *dst = px_blend_u8<O>(*dst, r, g, b, *mask);
+        dst++;
+        mask++;
+        n--;
+    }
+    const uint32_t solid = px_pair(px_rgb<O>(r, g, b));
+    px_pair_t*     d = reinterpret_cast<px_pair_t*>(dst);
+    for (int i = 0; i < n / 2; i++) {
+        const uint8_t a0 = mask[2 * i];
+        const uint8_t a1 = mask[2 * i + 1];
+        if (a0 != a1) {
+            dst[2 * i] = px_blend_u8<O>(dst[2 * i], r, g, b, a0);
+            dst[2 * i + 1] = px_blend_u8<O>(dst[2 * i + 1], r, g, b, a1);
+        } else if (a0 == 255) {
+            d[i] = solid;
+        } else if (a0 != 0) {
+            const uint32_t a256 = a0 + (a0 >> 7);
+            d[i] = px_pair_order<O>(px_pair_blend(px_pair_order<O>(d[i]), (r * a256) * 0x00010001u,
+                                                  (g * a256) * 0x00010001u, (b * a256) * 0x00010001u, 256u - a256));
+        }
+    }
+    if (n & 1) dst[n - 1] = px_blend_u8<O>(dst[n - 1], r, g, b, mask[n - 1]);
+}
+
+// dst[i] = px_scale_255(dst[i], scale[i * step]), step 1 or -1 (a map row
+// read mirrored). Multiplier maps are smooth, so neighbours often share a
+// value: equal pairs take the word path, 255 pairs are skipped, mixed pairs
+// fall back to scalar.
+template <PxOrder O = PX_ORDER>
+inline void px_span_scale_map(pixel_t* dst, const uint8_t* scale, int n, int step = 1)
+{
+    if (n <= 0) return;
+    if (!px_span_aligned(dst)) {
+        *dst = px_scale_255<O>(*dst, *scale);
+        dst++;
+        scale += step;
+        n--;
+    }
+    px_pair_t* d = reinterpret_cast<px_pair_t*>(dst);
+    for (int i = 0; i < n / 2; i++) {
+        const uint8_t s0 = scale[2 * i * step];
+        const uint8_t s1 = scale[(2 * i + 1) * step];
+        if (s0 != s1) {
+            dst[2 * i] = px_scale_255<O>(dst[2 * i], s0);
+            dst[2 * i + 1] = px_scale_255<O>(dst[2 * i + 1], s1);
+        } else if (s0 != 255) {
+            d[i] = px_pair_order<O>(px_pair_scale_q8(px_pair_order<O>(d[i]), s0 + (s0 >> 7)));
+        }
+    }
+    if (n & 1) dst[n - 1] = px_scale_255<O>(dst[n - 1], scale[(n - 1) * step]);
+}
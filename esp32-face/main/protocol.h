@@ -177,6 +177,28 @@ struct __attribute__((packed)) FaceHeartbeatPerfTailPayload {
     uint16_t perf_sample_div;
     uint8_t  dirty_rect_enabled;
     uint8_t  afterglow_downsample;
+    // Frame pacing and quality governor (older firmware ends the tail above).
+    uint32_t frame_us_p95;
+    uint32_t pace_overruns;
+    uint8_t  quality_level;
+    uint8_t  quality_shed;
+    uint16_t quality_changes;
+    // Display list idle skips (older firmware ends the tail above).
+    uint16_t idle_skip_frames;
+    uint8_t  idle_skip_pct;
+    uint8_t  reserved;
+    // Mouth mask cache (older firmware ends the tail above).
+    uint32_t mouth_cache_hits;
+    uint32_t mouth_cache_misses;
+    uint32_t mouth_cache_bytes;
+    uint32_t mouth_cache_bytes_total;
+    // Display refresh and render overlap (older firmware ends the tail above).
+    uint32_t flush_us_avg;
+    uint32_t overlap_us_avg;
+    uint8_t  overlap_pct;
+    uint8_t  canvas_buffers;
+    uint8_t  direct_present;
+    uint8_t  reserved2;
 };
 
 // ---- v2 extended payloads ----
@@ -0,0 +1,97 @@
+#include "quality_governor.h"
+
+#include "protocol.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace
+{
+
+constexpr uint8_t BACKOFF_MAX = 4;
+
+uint32_t window_p95(const QualityGovernor& gov)
+{
+    constexpr std::size_t n = FACE_QUALITY_WINDOW_FRAMES;
+    constexpr std::size_t k = (n * 95 + 99) / 100 - 1; // nearest rank
+    uint32_t              sorted[n];
+    std::copy(gov.samples, gov.samples + n, sorted);
+    std::nth_element(sorted, sorted + k, sorted + n);
+    return sorted[k];
+}
+
+uint8_t popcount8(uint8_t bits)
+{
+    uint8_t n = 0;
+    for (; bits != 0; bits &= static_cast<uint8_t>(bits - 1U)) n++;
+    return n;
+}
+
+} // namespace
+
+int quality_governor_add_frame(QualityGovernor& gov, uint32_t frame_us, uint8_t active)
+{
+    gov.samples[gov.count++] = frame_us;
+    if (gov.count < FACE_QUALITY_WINDOW_FRAMES) return 0;
+    gov.count = 0;
+
+    // An effect that went inactive has nothing left to restore.
+    gov.shed &= active;
+    gov.level = popcount8(gov.shed);
+
+    const uint32_t p95 = window_p95(gov);
+    const bool     restored = gov.just_restored;
+    gov.last_p95_us = p95;
+    gov.just_restored = false;
+
+    if (p95 > gov.budget_us) {
+        gov.calm_windows = 0;
+        // The effect restored last window did not fit: wait longer next time.
+        if (restored && gov.backoff < BACKOFF_MAX) gov.backoff++;
+        const uint8_t candidates = static_cast<uint8_t>(active & ~gov.shed);
+        if (candidates == 0) return 0;
+        gov.shed |= static_cast<uint8_t>(candidates & -candidates); // first in shed order
+        gov.level++;
+        return 1;
+    }
+    if (restored) gov.backoff = 0;
+
+    const bool headroom = static_cast<uint64_t>(p95) * 100U <=
+                          static_cast<uint64_t>(gov.budget_us) * FACE_QUALITY_RESTORE_PCT;
+    if (gov.level == 0 || !headroom) {
+        gov.calm_windows = 0;
+        return 0;
+    }
+    if (++gov.calm_windows < (FACE_QUALITY_RESTORE_WINDOWS << gov.backoff)) return 0;
+    gov.calm_windows = 0;
+    uint8_t last = static_cast<uint8_t>(1U << (QUALITY_LEVEL_MAX - 1));
+    while (!(gov.shed & last)) last >>= 1;
+    gov.shed &= static_cast<uint8_t>(~last); // last shed comes back first
+    gov.level--;
+    gov.just_restored = true;
+    return -1;
+}
+
+uint8_t quality_active_mask(const FaceState& fs, uint8_t flags, bool overlay_v2)
+{
+    if (fs.system.mode != SystemMode::NONE && overlay_v2) {
+        uint8_t active = 0;
+        if (SYSTEM_FX_GLITCH && fs.system.mode == SystemMode::ERROR_DISPLAY) active |= QUALITY_SHED_GLITCH;
+        if (SYSTEM_FX_VIGNETTE) active |= QUALITY_SHED_VIGNETTE;
+        if (SYSTEM_FX_SCANLINES) active |= QUALITY_SHED_SCANLINES;
+        return active;
+    }
+    uint8_t active = 0;
+    if (flags & FACE_FLAG_SPARKLE) active |= QUALITY_SHED_SPARKLE;
+    if (flags & FACE_FLAG_AFTERGLOW) active |= QUALITY_SHED_AFTERGLOW;
+    if (flags & FACE_FLAG_EDGE_GLOW) active |= QUALITY_SHED_EDGE_GLOW;
+    return active;
+}
+
+void quality_apply(FaceState& fs, uint8_t shed)
+{
+    fs.fx.shed = shed;
+    if (shed & QUALITY_SHED_SPARKLE) fs.fx.sparkle = false;
+    if (shed & QUALITY_SHED_AFTERGLOW) fs.fx.afterglow = false;
+    if (shed & QUALITY_SHED_EDGE_GLOW) fs.fx.edge_glow = false;
+}
@@ -0,0 +1,52 @@
+#pragma once
+// Adaptive quality governor — sheds optional effects while the p95 frame time
+// is over the frame budget and restores them once there is headroom again.
+// Effects go in a fixed order, cheapest loss first, skipping any that are not
+// active (nothing to gain from shedding them); the governor level is the
+// number of them shed. Decisions are made once per window of frames.
+
+#include "config.h"
+#include "face_state.h"
+
+#include <cstdint>
+
+// Bits of EffectsState::shed, in shed order.
+enum QualityShed : uint8_t {
+    QUALITY_SHED_SPARKLE = 1U << 0,
+    QUALITY_SHED_AFTERGLOW = 1U << 1,
+    QUALITY_SHED_EDGE_GLOW = 1U << 2,
+    QUALITY_SHED_GLITCH = 1U << 3, // SYSTEM_FX_* follow the config.h fallback order
+    QUALITY_SHED_VIGNETTE = 1U << 4,
+    QUALITY_SHED_SCANLINES = 1U << 5,
+};
+
+constexpr uint8_t QUALITY_LEVEL_MAX = 6;
+
+struct QualityGovernor {
+    uint32_t budget_us = FACE_FRAME_BUDGET_US;
+    uint32_t samples[FACE_QUALITY_WINDOW_FRAMES]{};
+    uint8_t  count = 0;
+    uint8_t  level = 0;         // effects shed
+    uint8_t  shed = 0;          // QualityShed bits of those effects
+    uint8_t  calm_windows = 0;  // consecutive windows under the restore threshold
+    uint8_t  backoff = 0;       // restores undone by the next window; doubles the wait
+    bool     just_restored = false;
+    uint32_t last_p95_us = 0;   // p95 of the last full window
+};
+
+// Record one frame's busy time (render + present, not the pacing sleep).
+// active holds the QualityShed bits of the effects that would be drawn if
+// none were shed; only those are shed or waited on for a restore, and shed
+// bits of effects that went inactive are dropped when the window closes.
+// Returns +1 when the window closed with an effect shed, -1 when one was
+// restored, 0 otherwise.
+int quality_governor_add_frame(QualityGovernor& gov, uint32_t frame_us, uint8_t active);
+
+// QualityShed bits of the effects drawn for fs with no effect shed: the face
+// effects requested by flags (FACE_FLAG_*), or the SYSTEM_FX_* effects while
+// overlay_v2 draws a system mode instead of the face.
+uint8_t quality_active_mask(const FaceState& fs, uint8_t flags, bool overlay_v2);
+
+// Turn off the shed effects in fs and record them in fs.fx.shed. Call after
+// the face flags are applied, since those set sparkle / afterglow / edge glow.
+void quality_apply(FaceState& fs, uint8_t shed);
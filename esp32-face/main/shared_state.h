@@ -148,9 +148,25 @@ struct FacePerfSnapshot {
     uint32_t dirty_px_avg = 0;
     uint32_t spi_bytes_per_s = 0;
     uint32_t cmd_rx_to_apply_us_avg = 0;
+    uint32_t mouth_cache_hits = 0;   // mouth mask cache hits in this window
+    uint32_t mouth_cache_misses = 0; // ... and misses
+    uint32_t mouth_cache_bytes = 0;  // encoded bytes held / arena size below
+    uint32_t mouth_cache_bytes_total = 0;
+    uint32_t flush_us_avg = 0;   // display refresh / direct push time per frame
+    uint32_t overlap_us_avg = 0; // render time hidden behind a refresh (sampled frames)
     uint16_t perf_sample_div = 0;
     uint8_t  dirty_rect_enabled = 0;
     uint8_t  afterglow_downsample = 0;
+    uint8_t  overlap_pct = 0;    // overlap_us / render_us, percent
+    uint8_t  canvas_buffers = 0; // 2 = render overlaps the display refresh
+    uint8_t  direct_present = 0; // 1 = esp_lcd DMA from the canvas, 0 = LVGL refresh
+    uint32_t frame_us_p95 = 0;    // p95 busy time of the last quality governor window
+    uint32_t pace_overruns = 0;   // frames that missed their deadline in this window
+    uint8_t  quality_level = 0;   // effects shed by the quality governor
+    uint8_t  quality_shed = 0;    // QualityShed bits (quality_governor.h)
+    uint16_t quality_changes = 0; // governor sheds + restores in this window
+    uint16_t idle_skip_frames = 0; // frames with no display list change, nothing redrawn
+    uint8_t  idle_skip_pct = 0;    // idle_skip_frames / rendered frames, percent
 };
 
 struct FacePerfBuffer {
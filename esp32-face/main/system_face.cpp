@@ -5,6 +5,7 @@
 #include "system_face.h"
 
 #include "config.h"
+#include "pixel_span.h"
 
 #include <cmath>
 #include <cstdint>
@@ -296,14 +297,8 @@ static float smoothstep(float edge0, float edge1, float x)
 static void blend_pixel(pixel_t* buf, int idx, int r, int g, int b, float alpha)
 {
     if (alpha < 0.01f) return;
-    const uint16_t c = buf[idx];
-    const int      old_r = (c >> 11) << 3;
-    const int      old_g = ((c >> 5) & 0x3F) << 2;
-    const int      old_b = (c & 0x1F) << 3;
-    const int      nr = static_cast<int>(old_r + (r - old_r) * alpha);
-    const int      ng = static_cast<int>(old_g + (g - old_g) * alpha);
-    const int      nb = static_cast<int>(old_b + (b - old_b) * alpha);
-    buf[idx] = static_cast<pixel_t>(((nr >> 3) << 11) | ((ng >> 2) << 5) | (nb >> 3));
+    buf[idx] = px_blend_u8(buf[idx], static_cast<uint8_t>(r), static_cast<uint8_t>(g), static_cast<uint8_t>(b),
+                           px_alpha_u8(alpha));
 }
 
 } // namespace
@@ -431,14 +426,10 @@ void system_face_render_updating_bar(pixel_t* buf, float progress)
     constexpr int bar_x1 = SCREEN_W - 20;
     const int     fill_x = bar_x0 + static_cast<int>((bar_x1 - bar_x0) * clampf(progress, 0.0f, 1.0f));
 
+    const uint8_t a = px_alpha_u8(0.8f);
     for (int y = bar_y; y < bar_y + bar_h && y < SCREEN_H; y++) {
-        const int row = y * SCREEN_W;
-        for (int x = bar_x0; x < bar_x1; x++) {
-            if (x < fill_x) {
-                blend_pixel(buf, row + x, 80, 135, 220, 0.8f);
-            } else {
-                blend_pixel(buf, row + x, 30, 40, 60, 0.8f);
-            }
-        }
+        pixel_t* row = buf + y * SCREEN_W;
+        px_span_blend(row + bar_x0, fill_x - bar_x0, 80, 135, 220, a);
+        px_span_blend(row + fill_x, bar_x1 - fill_x, 30, 40, 60, a);
     }
 }
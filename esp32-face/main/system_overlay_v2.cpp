@@ -1,9 +1,12 @@
 #include "system_overlay_v2.h"
 
 #include "config.h"
+#include "pixel_span.h"
+#include "quality_governor.h"
 
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 
 namespace
 {
@@ -18,6 +21,12 @@ struct Rgb {
 
 constexpr Rgb BG{10, 10, 14};
 
+// Angle and noise terms of the booting and updating screens, and the error
+// glitch rows, are evaluated at this reduced resolution and cover the whole
+// cell; edges that depend on distance stay per pixel.
+constexpr int   OVERLAY_CELL = 2;
+constexpr float OVERLAY_CELL_RADIUS = 0.7072f * OVERLAY_CELL; // center to corner, rounded up
+
 static int clampi(int v, int lo, int hi)
 {
     if (v < lo) return lo;
@@ -50,10 +59,7 @@ static pixel_t rgb_to_color(const Rgb& c)
 
 static void fill_screen(pixel_t* buf, const Rgb& c)
 {
-    const pixel_t color = rgb_to_color(c);
-    for (int i = 0; i < SCREEN_W * SCREEN_H; i++) {
-        buf[i] = color;
-    }
+    px_span_fill(buf, SCREEN_W * SCREEN_H, rgb_to_color(c));
 }
 
 static void set_px_blend(pixel_t* buf, int idx, const Rgb& c, float alpha)
@@ -61,9 +67,9 @@ static void set_px_blend(pixel_t* buf, int idx, const Rgb& c, float alpha)
     if (!buf || idx < 0 || idx >= (SCREEN_W * SCREEN_H) || alpha <= 0.0f) {
         return;
     }
-    alpha = clampf(alpha, 0.0f, 1.0f);
-    buf[idx] = px_blend(buf[idx], static_cast<uint8_t>(clampi(c.r, 0, 255)), static_cast<uint8_t>(clampi(c.g, 0, 255)),
-                        static_cast<uint8_t>(clampi(c.b, 0, 255)), alpha);
+    buf[idx] = px_blend_u8(buf[idx], static_cast<uint8_t>(clampi(c.r, 0, 255)),
+                           static_cast<uint8_t>(clampi(c.g, 0, 255)), static_cast<uint8_t>(clampi(c.b, 0, 255)),
+                           px_alpha_u8(alpha));
 }
 
 static float sd_rounded_box(float px, float py, float cx, float cy, float hw, float hh, float r)
@@ -120,48 +126,76 @@ static void render_booting(pixel_t* buf, float elapsed)
     const float angle = fmodf(elapsed * 3.0f, 2.0f * PI);
     const float radar_r = 90.0f;
 
+    const uint8_t grid_a = px_alpha_u8(0.2f);
     for (int y = 0; y < SCREEN_H; y++) {
         const int row = y * SCREEN_W;
-        for (int x = 0; x < SCREEN_W; x++) {
-            if ((x % 40) == 0 || (y % 40) == 0) {
-                set_px_blend(buf, row + x, Rgb{0, 50, 100}, 0.2f);
-            }
+        if ((y % 40) == 0) {
+            px_span_blend(buf + row, SCREEN_W, 0, 50, 100, grid_a);
+            continue;
+        }
+        for (int x = 0; x < SCREEN_W; x += 40) {
+            set_px_blend(buf, row + x, Rgb{0, 50, 100}, 0.2f);
         }
     }
 
+    // The sweep angle and its noise sparkles are taken once per 2x2 cell and
+    // cover the whole cell; distance, so the ring edge, stays per pixel.
     const int x0 = clampi(static_cast<int>(cx - radar_r), 0, SCREEN_W - 1);
     const int x1 = clampi(static_cast<int>(cx + radar_r), 0, SCREEN_W - 1);
     const int y0 = clampi(static_cast<int>(cy - radar_r), 0, SCREEN_H - 1);
     const int y1 = clampi(static_cast<int>(cy + radar_r), 0, SCREEN_H - 1);
 
     const int tick = static_cast<int>(elapsed * 120.0f);
-    for (int y = y0; y <= y1; y++) {
-        const int row = y * SCREEN_W;
-        for (int x = x0; x <= x1; x++) {
-            const float dx = static_cast<float>(x - cx);
-            const float dy = static_cast<float>(y - cy);
-            const float dist = sqrtf(dx * dx + dy * dy);
-
-            const float ring_sdf = fabsf(dist - radar_r);
-            const float alpha_ring = 1.0f - smoothstep(1.0f, 3.0f, ring_sdf);
-            if (alpha_ring > 0.0f) {
-                set_px_blend(buf, row + x, Rgb{0, 200, 255}, alpha_ring);
-            }
-
-            if (dist < radar_r) {
-                const float pixel_angle = atan2f(dy, dx);
-                float       diff = fmodf((pixel_angle - angle + PI), 2.0f * PI);
+    for (int cell_y = y0; cell_y <= y1; cell_y += OVERLAY_CELL) {
+        const int   cell_y1 = cell_y + OVERLAY_CELL - 1 < y1 ? cell_y + OVERLAY_CELL - 1 : y1;
+        const float cdy = static_cast<float>(cell_y - cy) + 0.5f;
+        for (int cell_x = x0; cell_x <= x1; cell_x += OVERLAY_CELL) {
+            const int   cell_x1 = cell_x + OVERLAY_CELL - 1 < x1 ? cell_x + OVERLAY_CELL - 1 : x1;
+            const float cdx = static_cast<float>(cell_x - cx) + 0.5f;
+            const float cell_dist = sqrtf(cdx * cdx + cdy * cdy);
+            if (cell_dist > radar_r + 3.0f + OVERLAY_CELL_RADIUS) continue;
+
+            float intensity = 0.0f;
+            if (cell_dist < radar_r + OVERLAY_CELL_RADIUS) {
+                float diff = fmodf((atan2f(cdy, cdx) - angle + PI), 2.0f * PI);
                 if (diff < 0.0f) diff += 2.0f * PI;
                 diff -= PI;
                 if (diff < 0.0f) diff += 2.0f * PI;
                 if (diff > 0.0f && diff < 1.0f) {
-                    float intensity = (1.0f - diff) * 0.6f;
-                    if (((x * y) % 43 == 0) && (noise01(x, y, tick) < 0.10f)) {
+                    intensity = (1.0f - diff) * 0.6f;
+                    const int nx = cell_x / OVERLAY_CELL;
+                    const int ny = cell_y / OVERLAY_CELL;
+                    if (((nx * ny) % 43 == 0) && (noise01(nx, ny, tick) < 0.10f)) {
                         intensity = 1.0f;
                     }
-                    const int g = static_cast<int>(255.0f * intensity);
-                    const int b = static_cast<int>(200.0f * intensity);
-                    set_px_blend(buf, row + x, Rgb{0, g, b}, intensity);
+                }
+            }
+            const Rgb  sweep{0, static_cast<int>(255.0f * intensity), static_cast<int>(200.0f * intensity)};
+            const bool near_ring = fabsf(cell_dist - radar_r) < 3.0f + OVERLAY_CELL_RADIUS;
+            if (!near_ring) {
+                // Wholly inside the radar: no per-pixel distance needed.
+                if (intensity <= 0.0f) continue;
+                for (int y = cell_y; y <= cell_y1; y++) {
+                    for (int x = cell_x; x <= cell_x1; x++) {
+                        set_px_blend(buf, y * SCREEN_W + x, sweep, intensity);
+                    }
+                }
+                continue;
+            }
+
+            for (int y = cell_y; y <= cell_y1; y++) {
+                const int row = y * SCREEN_W;
+                for (int x = cell_x; x <= cell_x1; x++) {
+                    const float dx = static_cast<float>(x - cx);
+                    const float dy = static_cast<float>(y - cy);
+                    const float dist = sqrtf(dx * dx + dy * dy);
+                    const float alpha_ring = 1.0f - smoothstep(1.0f, 3.0f, fabsf(dist - radar_r));
+                    if (alpha_ring > 0.0f) {
+                        set_px_blend(buf, row + x, Rgb{0, 200, 255}, alpha_ring);
+                    }
+                    if (intensity > 0.0f && dist < radar_r) {
+                        set_px_blend(buf, row + x, sweep, intensity);
+                    }
                 }
             }
         }
@@ -190,50 +224,97 @@ static void render_booting(pixel_t* buf, float elapsed)
     }
 }
 
-static void render_error(pixel_t* buf, float elapsed)
+// The error screen's warning triangle and mark never move, so which of them
+// covers each pixel is classified once and kept as runs per row (bit 0: the
+// triangle's alpha is above zero, bit 1: the mark's). The runs span the
+// columns the per-channel split and the glitch shift can sample.
+constexpr int ERROR_SHIFT_PAD = 4 + 10;
+constexpr int ERROR_COLS = SCREEN_W + 2 * ERROR_SHIFT_PAD;
+constexpr int ERROR_MAX_RUNS = 8;
+
+struct ErrorRow {
+    int16_t end[ERROR_MAX_RUNS]; // exclusive, in padded columns
+    uint8_t cls[ERROR_MAX_RUNS];
+    uint8_t runs;
+};
+
+static ErrorRow s_error_rows[SCREEN_H];
+static bool     s_error_rows_built = false;
+
+static uint8_t error_class(float sx, float sy)
 {
-    const int   cx = SCREEN_W / 2;
-    const int   cy = SCREEN_H / 2;
-    const float tri_r = 70.0f;
+    constexpr float cx = static_cast<float>(SCREEN_W / 2);
+    constexpr float cy = static_cast<float>(SCREEN_H / 2);
+    constexpr float tri_r = 70.0f;
+    const float     d_tri = sd_equilateral_triangle(sx, sy, cx, cy, tri_r);
+    const float     d_in = sd_equilateral_triangle(sx, sy, cx, cy + 5.0f, tri_r - 15.0f);
+    const float     d_mark = fminf(sd_rounded_box(sx, sy, cx, cy - 10.0f, 6.0f, 20.0f, 2.0f),
+                                   sd_circle(sx, sy, cx, cy + 25.0f, 6.0f));
+    const float     ay = 1.0f - smoothstep(0.0f, 2.0f, fminf(d_tri, -d_in));
+    const float     am = 1.0f - smoothstep(0.0f, 2.0f, d_mark);
+    return static_cast<uint8_t>((ay > 0.0f ? 1U : 0U) | (am > 0.0f ? 2U : 0U));
+}
+
+static void build_error_rows()
+{
+    for (int y = 0; y < SCREEN_H; y++) {
+        ErrorRow& r = s_error_rows[y];
+        r.runs = 0;
+        for (int c = 0; c < ERROR_COLS; c++) {
+            const uint8_t cls = error_class(static_cast<float>(c - ERROR_SHIFT_PAD), static_cast<float>(y));
+            if (r.runs > 0 && r.cls[r.runs - 1] == cls) {
+                r.end[r.runs - 1] = static_cast<int16_t>(c + 1);
+            } else if (r.runs < ERROR_MAX_RUNS) {
+                r.cls[r.runs] = cls;
+                r.end[r.runs] = static_cast<int16_t>(c + 1);
+                r.runs++;
+            } else {
+                r.end[r.runs - 1] = static_cast<int16_t>(c + 1); // convex shapes stay far below the cap
+            }
+        }
+    }
+    s_error_rows_built = true;
+}
+
+static void render_error(pixel_t* buf, float elapsed, bool glitch)
+{
+    if (!s_error_rows_built) build_error_rows();
+
     const float pulse = (sinf(elapsed * 8.0f) + 1.0f) * 0.5f;
     const Rgb   bg{static_cast<int>(40.0f * pulse), 0, 0};
     const int   tick = static_cast<int>(elapsed * 60.0f);
 
-    auto alpha_pair = [cx, cy, tri_r](float sx, float sy, float* ay, float* am) {
-        const float d_tri = sd_equilateral_triangle(sx, sy, static_cast<float>(cx), static_cast<float>(cy), tri_r);
-        const float d_in =
-            sd_equilateral_triangle(sx, sy, static_cast<float>(cx), static_cast<float>(cy + 5), tri_r - 15.0f);
-        const float d_mark =
-            fminf(sd_rounded_box(sx, sy, static_cast<float>(cx), static_cast<float>(cy - 10), 6.0f, 20.0f, 2.0f),
-                  sd_circle(sx, sy, static_cast<float>(cx), static_cast<float>(cy + 25), 6.0f));
-        *ay = 1.0f - smoothstep(0.0f, 2.0f, fminf(d_tri, -d_in));
-        *am = 1.0f - smoothstep(0.0f, 2.0f, d_mark);
-    };
+    // One pixel per (red, green, blue) class triple: red samples 4 px left,
+    // blue 4 px right.
+    pixel_t lut[64];
+    for (int i = 0; i < 64; i++) {
+        const int cr = i & 3;
+        const int cg = (i >> 2) & 3;
+        const int cb = (i >> 4) & 3;
+        const int r = (cr & 2) ? 10 : ((cr & 1) ? 255 : bg.r);
+        const int g = (cg & 2) ? 0 : ((cg & 1) ? 200 : bg.g);
+        const int b = cb ? 0 : bg.b;
+        lut[i] = px_rgb(static_cast<uint8_t>(r), static_cast<uint8_t>(g), static_cast<uint8_t>(b));
+    }
 
+    uint8_t line[ERROR_COLS];
     for (int y = 0; y < SCREEN_H; y++) {
-        const int row = y * SCREEN_W;
-        const int off_x = (SYSTEM_FX_GLITCH && noise01(17, y, tick) < 0.05f)
-                              ? static_cast<int>(noise01(23, y, tick) * 21.0f) - 10
+        const ErrorRow& er = s_error_rows[y];
+        int             c = 0;
+        for (int i = 0; i < er.runs; i++) {
+            memset(line + c, er.cls[i], static_cast<size_t>(er.end[i] - c));
+            c = er.end[i];
+        }
+
+        // Glitch rows are picked per row pair, the noise runs at half height.
+        const int gy = y / OVERLAY_CELL;
+        const int off_x = (glitch && noise01(17, gy, tick) < 0.05f)
+                              ? static_cast<int>(noise01(23, gy, tick) * 21.0f) - 10
                               : 0;
+        const uint8_t* src = line + ERROR_SHIFT_PAD + off_x;
+        pixel_t*       row = buf + y * SCREEN_W;
         for (int x = 0; x < SCREEN_W; x++) {
-            float ay_r = 0.0f, am_r = 0.0f;
-            float ay_g = 0.0f, am_g = 0.0f;
-            float ay_b = 0.0f, am_b = 0.0f;
-            alpha_pair(static_cast<float>(x + off_x - 4), static_cast<float>(y), &ay_r, &am_r);
-            alpha_pair(static_cast<float>(x + off_x), static_cast<float>(y), &ay_g, &am_g);
-            alpha_pair(static_cast<float>(x + off_x + 4), static_cast<float>(y), &ay_b, &am_b);
-
-            int r = bg.r;
-            int g = bg.g;
-            int b = bg.b;
-            if (ay_r > 0.0f) r = 255;
-            if (am_r > 0.0f) r = 10;
-            if (ay_g > 0.0f) g = 200;
-            if (am_g > 0.0f) g = 0;
-            if (ay_b > 0.0f) b = 0;
-            if (am_b > 0.0f) b = 0;
-            buf[row + x] = px_rgb(static_cast<uint8_t>(clampi(r, 0, 255)), static_cast<uint8_t>(clampi(g, 0, 255)),
-                                  static_cast<uint8_t>(clampi(b, 0, 255)));
+            row[x] = lut[src[x - 4] | (src[x] << 2) | (src[x + 4] << 4)];
         }
     }
 }
@@ -261,6 +342,13 @@ static void render_battery(pixel_t* buf, const FaceState& fs, float elapsed)
     const int y0 = clampi(cy - 60, 0, SCREEN_H - 1);
     const int y1 = clampi(cy + 60, 0, SCREEN_H - 1);
 
+    // The fill edge moves per column only; one sinf per column, not per pixel.
+    const float fill_max = (static_cast<float>(cx - bw + 4)) + (2.0f * static_cast<float>(bw - 4) * lvl);
+    float       fill_edge[SCREEN_W];
+    for (int x = x0; x <= x1; x++) {
+        fill_edge[x] = fill_max + sinf(static_cast<float>(x) * 0.1f + elapsed * 5.0f) * 3.0f;
+    }
+
     for (int y = y0; y <= y1; y++) {
         const int row = y * SCREEN_W;
         for (int x = x0; x <= x1; x++) {
@@ -279,10 +367,8 @@ static void render_battery(pixel_t* buf, const FaceState& fs, float elapsed)
                 set_px_blend(buf, row + x, Rgb{200, 200, 210}, alpha_shell);
             }
 
-            const float fill_max = (static_cast<float>(cx - bw + 4)) + (2.0f * static_cast<float>(bw - 4) * lvl);
             if (d_in < 0.0f) {
-                const float wave = sinf(static_cast<float>(x) * 0.1f + elapsed * 5.0f) * 3.0f;
-                if (px < fill_max + wave) {
+                if (px < fill_edge[x]) {
                     const float gloss = (py - static_cast<float>(cy - bh)) / static_cast<float>(2 * bh);
                     int         r = static_cast<int>(col.r * (0.8f + 0.4f * gloss));
                     int         g = static_cast<int>(col.g * (0.8f + 0.4f * gloss));
@@ -317,31 +403,53 @@ static void render_updating(pixel_t* buf, float elapsed)
     const int y0 = clampi(cy - 60, 0, SCREEN_H - 1);
     const int y1 = clampi(cy + 60, 0, SCREEN_H - 1);
 
-    for (int y = y0; y <= y1; y++) {
-        const int row = y * SCREEN_W;
-        for (int x = x0; x <= x1; x++) {
-            const float dx = static_cast<float>(x - cx);
-            const float dy = static_cast<float>(y - cy);
-            const float dist = sqrtf(dx * dx + dy * dy);
-            const float angle = atan2f(dy, dx);
-
-            const float a1 = fmodf(angle + elapsed * 2.0f + 2.0f * PI, 2.0f * PI);
-            if (fabsf(dist - 50.0f) < 3.0f && a1 > 0.0f && a1 < 4.0f) {
-                set_px_blend(buf, row + x, Rgb{0, 255, 100}, 1.0f);
+    // Arc angles are taken once per 2x2 cell, and only in cells that reach an
+    // arc band; distance, so the arc and dot edges, stays per pixel.
+    const float pulse_r = 8.0f + sinf(elapsed * 10.0f) * 2.0f;
+    for (int cell_y = y0; cell_y <= y1; cell_y += OVERLAY_CELL) {
+        const int   cell_y1 = cell_y + OVERLAY_CELL - 1 < y1 ? cell_y + OVERLAY_CELL - 1 : y1;
+        const float cdy = static_cast<float>(cell_y - cy) + 0.5f;
+        for (int cell_x = x0; cell_x <= x1; cell_x += OVERLAY_CELL) {
+            const int   cell_x1 = cell_x + OVERLAY_CELL - 1 < x1 ? cell_x + OVERLAY_CELL - 1 : x1;
+            const float cdx = static_cast<float>(cell_x - cx) + 0.5f;
+            const float cell_dist = sqrtf(cdx * cdx + cdy * cdy);
+            const bool  near_dot = cell_dist < pulse_r + 1.0f + 2.0f * OVERLAY_CELL_RADIUS;
+            const bool  near_outer = fabsf(cell_dist - 50.0f) < 3.0f + OVERLAY_CELL_RADIUS;
+            const bool  near_inner = fabsf(cell_dist - 35.0f) < 4.0f + OVERLAY_CELL_RADIUS;
+            if (!near_dot && !near_outer && !near_inner) continue;
+
+            bool outer_on = false;
+            bool inner_on = false;
+            if (near_outer || near_inner) {
+                const float angle = atan2f(cdy, cdx);
+                const float a1 = fmodf(angle + elapsed * 2.0f + 2.0f * PI, 2.0f * PI);
+                const float a2 = fmodf(angle - elapsed * 5.0f + 1.5f * 100.0f, 1.5f);
+                outer_on = near_outer && a1 > 0.0f && a1 < 4.0f;
+                inner_on = near_inner && a2 < 1.0f;
             }
 
-            const float a2 = fmodf(angle - elapsed * 5.0f + 1.5f * 100.0f, 1.5f);
-            if (fabsf(dist - 35.0f) < 4.0f && a2 < 1.0f) {
-                set_px_blend(buf, row + x, Rgb{0, 200, 255}, 1.0f);
-            }
-
-            const float pulse_r = 8.0f + sinf(elapsed * 10.0f) * 2.0f;
-            const float alpha_dot =
-                1.0f - smoothstep(-1.0f, 1.0f,
-                                  sd_circle(static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f,
-                                            static_cast<float>(cx), static_cast<float>(cy), pulse_r));
-            if (alpha_dot > 0.0f) {
-                set_px_blend(buf, row + x, Rgb{255, 255, 255}, alpha_dot);
+            for (int y = cell_y; y <= cell_y1; y++) {
+                const int row = y * SCREEN_W;
+                for (int x = cell_x; x <= cell_x1; x++) {
+                    const float dx = static_cast<float>(x - cx);
+                    const float dy = static_cast<float>(y - cy);
+                    const float dist = sqrtf(dx * dx + dy * dy);
+                    if (outer_on && fabsf(dist - 50.0f) < 3.0f) {
+                        set_px_blend(buf, row + x, Rgb{0, 255, 100}, 1.0f);
+                    }
+                    if (inner_on && fabsf(dist - 35.0f) < 4.0f) {
+                        set_px_blend(buf, row + x, Rgb{0, 200, 255}, 1.0f);
+                    }
+                    if (near_dot) {
+                        const float alpha_dot =
+                            1.0f - smoothstep(-1.0f, 1.0f,
+                                              sd_circle(static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f,
+                                                        static_cast<float>(cx), static_cast<float>(cy), pulse_r));
+                        if (alpha_dot > 0.0f) {
+                            set_px_blend(buf, row + x, Rgb{255, 255, 255}, alpha_dot);
+                        }
+                    }
+                }
             }
         }
     }
@@ -394,37 +502,47 @@ static void render_shutdown(pixel_t* buf, float elapsed)
 
 static void apply_scanlines(pixel_t* buf)
 {
-    if (!SYSTEM_FX_SCANLINES) {
-        return;
-    }
+    constexpr uint32_t SCANLINE_Q8 = px_q8_ratio(4, 5);
     for (int y = 0; y < SCREEN_H; y += 2) {
-        const int row = y * SCREEN_W;
-        for (int x = 0; x < SCREEN_W; x++) {
-            buf[row + x] = px_scale(buf[row + x], 4, 5);
-        }
+        px_span_scale(buf + y * SCREEN_W, SCREEN_W, SCANLINE_Q8);
     }
 }
 
-static void apply_vignette(pixel_t* buf)
+// Vignette, with the scanlines folded in, as one px_scale_255 multiplier per
+// pixel. Both are symmetric about (SCREEN_W / 2, SCREEN_H / 2) — scanline rows
+// are the even ones, and |y - SCREEN_H / 2| has the parity of y — so the map
+// holds one quadrant indexed by |dx|, |dy|. Built on first use and again when
+// the scanlines are shed or restored.
+constexpr int POSTFX_CX = SCREEN_W / 2;
+constexpr int POSTFX_CY = SCREEN_H / 2;
+constexpr int POSTFX_MAP_W = POSTFX_CX + 1;
+constexpr int POSTFX_MAP_H = POSTFX_CY + 1;
+
+static uint8_t s_postfx_map[POSTFX_MAP_H][POSTFX_MAP_W];
+static int     s_postfx_scanlines = -1; // what the map was built with, -1 = not built
+
+static void build_postfx_map(bool scanlines)
 {
-    if (!SYSTEM_FX_VIGNETTE) {
-        return;
+    const float max_dist = sqrtf(static_cast<float>(POSTFX_CX * POSTFX_CX + POSTFX_CY * POSTFX_CY));
+    for (int dy = 0; dy < POSTFX_MAP_H; dy++) {
+        const float line = (scanlines && dy % 2 == 0) ? 0.8f : 1.0f;
+        for (int dx = 0; dx < POSTFX_MAP_W; dx++) {
+            const float dist = sqrtf(static_cast<float>(dx * dx + dy * dy));
+            const float v = (1.0f - smoothstep(max_dist * 0.5f, max_dist, dist)) * line;
+            s_postfx_map[dy][dx] = static_cast<uint8_t>(clampi(static_cast<int>(v * 255.0f + 0.5f), 0, 255));
+        }
     }
-    const float cx = static_cast<float>(SCREEN_W) * 0.5f;
-    const float cy = static_cast<float>(SCREEN_H) * 0.5f;
-    const float max_dist = sqrtf(cx * cx + cy * cy);
+    s_postfx_scanlines = scanlines ? 1 : 0;
+}
+
+static void apply_vignette(pixel_t* buf, bool scanlines)
+{
+    if (s_postfx_scanlines != (scanlines ? 1 : 0)) build_postfx_map(scanlines);
     for (int y = 0; y < SCREEN_H; y++) {
-        const int row = y * SCREEN_W;
-        for (int x = 0; x < SCREEN_W; x++) {
-            const float   dx = static_cast<float>(x) - cx;
-            const float   dy = static_cast<float>(y) - cy;
-            const float   dist = sqrtf(dx * dx + dy * dy);
-            const float   v = 1.0f - smoothstep(max_dist * 0.5f, max_dist, dist);
-            const pixel_t p = buf[row + x];
-            buf[row + x] = px_rgb(static_cast<uint8_t>(clampi(static_cast<int>(px_r(p) * v), 0, 255)),
-                                  static_cast<uint8_t>(clampi(static_cast<int>(px_g(p) * v), 0, 255)),
-                                  static_cast<uint8_t>(clampi(static_cast<int>(px_b(p) * v), 0, 255)));
-        }
+        const uint8_t* m = s_postfx_map[y < POSTFX_CY ? POSTFX_CY - y : y - POSTFX_CY];
+        pixel_t*       row = buf + y * SCREEN_W;
+        px_span_scale_map(row, m + POSTFX_CX, POSTFX_CX, -1); // |dx| = POSTFX_CX - x
+        px_span_scale_map(row + POSTFX_CX, m, SCREEN_W - POSTFX_CX);
     }
 }
 
@@ -441,7 +559,7 @@ void render_system_overlay_v2(pixel_t* buf, const FaceState& fs, float now_secon
         render_booting(buf, elapsed);
         break;
     case SystemMode::ERROR_DISPLAY:
-        render_error(buf, elapsed);
+        render_error(buf, elapsed, SYSTEM_FX_GLITCH && !(fs.fx.shed & QUALITY_SHED_GLITCH));
         break;
     case SystemMode::LOW_BATTERY:
         render_battery(buf, fs, elapsed);
@@ -455,6 +573,15 @@ void render_system_overlay_v2(pixel_t* buf, const FaceState& fs, float now_secon
     case SystemMode::NONE:
         break;
     }
-    apply_scanlines(buf);
-    apply_vignette(buf);
+    system_overlay_post_fx(buf, SYSTEM_FX_SCANLINES && !(fs.fx.shed & QUALITY_SHED_SCANLINES),
+                           SYSTEM_FX_VIGNETTE && !(fs.fx.shed & QUALITY_SHED_VIGNETTE));
+}
+
+void system_overlay_post_fx(pixel_t* buf, bool scanlines, bool vignette)
+{
+    if (vignette) {
+        apply_vignette(buf, scanlines);
+    } else if (scanlines) {
+        apply_scanlines(buf);
+    }
 }
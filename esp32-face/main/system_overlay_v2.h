@@ -6,3 +6,7 @@
 // Render full-screen system overlays (boot/error/battery/updating/shutdown)
 // with Python-v2 parity effects.
 void render_system_overlay_v2(pixel_t* buf, const FaceState& fs, float now_seconds);
+
+// Scanlines and vignette over a finished frame, one table-driven pass when the
+// vignette is on. Applied by render_system_overlay_v2 unless shed.
+void system_overlay_post_fx(pixel_t* buf, bool scanlines, bool vignette);
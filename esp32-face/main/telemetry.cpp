@@ -171,6 +171,22 @@ void telemetry_task(void* arg)
                     tail.perf_sample_div = perf->perf_sample_div;
                     tail.dirty_rect_enabled = perf->dirty_rect_enabled;
                     tail.afterglow_downsample = perf->afterglow_downsample;
+                    tail.frame_us_p95 = perf->frame_us_p95;
+                    tail.pace_overruns = perf->pace_overruns;
+                    tail.quality_level = perf->quality_level;
+                    tail.quality_shed = perf->quality_shed;
+                    tail.quality_changes = perf->quality_changes;
+                    tail.idle_skip_frames = perf->idle_skip_frames;
+                    tail.idle_skip_pct = perf->idle_skip_pct;
+                    tail.mouth_cache_hits = perf->mouth_cache_hits;
+                    tail.mouth_cache_misses = perf->mouth_cache_misses;
+                    tail.mouth_cache_bytes = perf->mouth_cache_bytes;
+                    tail.mouth_cache_bytes_total = perf->mouth_cache_bytes_total;
+                    tail.flush_us_avg = perf->flush_us_avg;
+                    tail.overlap_us_avg = perf->overlap_us_avg;
+                    tail.overlap_pct = perf->overlap_pct;
+                    tail.canvas_buffers = perf->canvas_buffers;
+                    tail.direct_present = perf->direct_present;
                     memcpy(payload + payload_len, &tail, sizeof(tail));
                     payload_len += sizeof(tail);
                 }
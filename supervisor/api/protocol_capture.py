@@ -59,6 +59,10 @@ _HEARTBEAT_BASE_FMT = struct.Struct("<IIII")
 _HEARTBEAT_USB_FMT = struct.Struct("<IIIIIIIIIIII")
 _HEARTBEAT_TAIL_FMT = struct.Struct("<BBBB")
 _HEARTBEAT_PERF_FMT = struct.Struct("<IIIIIIIIIIIIIHBB")
+_HEARTBEAT_GOVERNOR_FMT = struct.Struct("<IIBBH")
+_HEARTBEAT_IDLE_SKIP_FMT = struct.Struct("<HBB")
+_HEARTBEAT_MOUTH_CACHE_FMT = struct.Struct("<IIII")
+_HEARTBEAT_PRESENT_FMT = struct.Struct("<IIBBBB")
 
 
 @dataclass(slots=True)
@@ -295,6 +299,58 @@ def _decode_fields(pkt_type: int, payload: bytes) -> dict[str, Any]:
                     "dirty_rect_enabled": bool(perf[14]),
                     "afterglow_downsample": perf[15],
                 }
+                gov_off = perf_off + _HEARTBEAT_PERF_FMT.size
+                if len(payload) >= gov_off + _HEARTBEAT_GOVERNOR_FMT.size:
+                    p95, overruns, level, shed, changes = (
+                        _HEARTBEAT_GOVERNOR_FMT.unpack_from(payload, gov_off)
+                    )
+                    decoded["perf"].update(
+                        {
+                            "frame_us_p95": p95,
+                            "pace_overruns": overruns,
+                            "quality_level": level,
+                            "quality_shed": f"0x{shed:02x}",
+                            "quality_changes": changes,
+                        }
+                    )
+                    skip_off = gov_off + _HEARTBEAT_GOVERNOR_FMT.size
+                    if len(payload) >= skip_off + _HEARTBEAT_IDLE_SKIP_FMT.size:
+                        skip_frames, skip_pct, _ = _HEARTBEAT_IDLE_SKIP_FMT.unpack_from(
+                            payload, skip_off
+                        )
+                        decoded["perf"].update(
+                            {
+                                "idle_skip_frames": skip_frames,
+                                "idle_skip_pct": skip_pct,
+                            }
+                        )
+                        mc_off = skip_off + _HEARTBEAT_IDLE_SKIP_FMT.size
+                        if len(payload) >= mc_off + _HEARTBEAT_MOUTH_CACHE_FMT.size:
+                            mc_hits, mc_misses, mc_bytes, mc_total = (
+                                _HEARTBEAT_MOUTH_CACHE_FMT.unpack_from(payload, mc_off)
+                            )
+                            decoded["perf"].update(
+                                {
+                                    "mouth_cache_hits": mc_hits,
+                                    "mouth_cache_misses": mc_misses,
+                                    "mouth_cache_bytes": mc_bytes,
+                                    "mouth_cache_bytes_total": mc_total,
+                                }
+                            )
+                            pr_off = mc_off + _HEARTBEAT_MOUTH_CACHE_FMT.size
+                            if len(payload) >= pr_off + _HEARTBEAT_PRESENT_FMT.size:
+                                flush, overlap, overlap_pct, canvases, direct, _ = (
+                                    _HEARTBEAT_PRESENT_FMT.unpack_from(payload, pr_off)
+                                )
+                                decoded["perf"].update(
+                                    {
+                                        "flush_us_avg": flush,
+                                        "overlap_us_avg": overlap,
+                                        "overlap_pct": overlap_pct,
+                                        "canvas_buffers": canvases,
+                                        "direct_present": bool(direct),
+                                    }
+                                )
             return decoded
     except (struct.error, IndexError):
         pass
@@ -156,6 +156,22 @@ class RobotState:
     face_perf_sample_div: int = 0
     face_perf_dirty_rect_enabled: bool = False
     face_perf_afterglow_downsample: int = 0
+    face_perf_frame_us_p95: int = 0
+    face_perf_pace_overruns: int = 0
+    face_perf_quality_level: int = 0
+    face_perf_quality_shed: int = 0
+    face_perf_quality_changes: int = 0
+    face_perf_idle_skip_frames: int = 0
+    face_perf_idle_skip_pct: int = 0
+    face_perf_mouth_cache_hits: int = 0
+    face_perf_mouth_cache_misses: int = 0
+    face_perf_mouth_cache_bytes: int = 0
+    face_perf_mouth_cache_bytes_total: int = 0
+    face_perf_flush_us_avg: int = 0
+    face_perf_overlap_us_avg: int = 0
+    face_perf_overlap_pct: int = 0
+    face_perf_canvas_buffers: int = 0
+    face_perf_direct_present: bool = False
     face_seq: int = 0
     face_rx_mono_ms: float = 0.0
 
@@ -246,6 +262,22 @@ class RobotState:
                 "sample_div": self.face_perf_sample_div,
                 "dirty_rect_enabled": self.face_perf_dirty_rect_enabled,
                 "afterglow_downsample": self.face_perf_afterglow_downsample,
+                "frame_us_p95": self.face_perf_frame_us_p95,
+                "pace_overruns": self.face_perf_pace_overruns,
+                "quality_level": self.face_perf_quality_level,
+                "quality_shed": self.face_perf_quality_shed,
+                "quality_changes": self.face_perf_quality_changes,
+                "idle_skip_frames": self.face_perf_idle_skip_frames,
+                "idle_skip_pct": self.face_perf_idle_skip_pct,
+                "mouth_cache_hits": self.face_perf_mouth_cache_hits,
+                "mouth_cache_misses": self.face_perf_mouth_cache_misses,
+                "mouth_cache_bytes": self.face_perf_mouth_cache_bytes,
+                "mouth_cache_bytes_total": self.face_perf_mouth_cache_bytes_total,
+                "flush_us_avg": self.face_perf_flush_us_avg,
+                "overlap_us_avg": self.face_perf_overlap_us_avg,
+                "overlap_pct": self.face_perf_overlap_pct,
+                "canvas_buffers": self.face_perf_canvas_buffers,
+                "direct_present": self.face_perf_direct_present,
             },
             "face_seq": self.face_seq,
             "face_rx_mono_ms": round(self.face_rx_mono_ms, 1),
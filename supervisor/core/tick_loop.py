@@ -478,6 +478,24 @@ class TickLoop:
             self.robot.face_perf_sample_div = hb.perf_sample_div
             self.robot.face_perf_dirty_rect_enabled = hb.perf_dirty_rect_enabled
             self.robot.face_perf_afterglow_downsample = hb.perf_afterglow_downsample
+            self.robot.face_perf_frame_us_p95 = hb.perf_frame_us_p95
+            self.robot.face_perf_pace_overruns = hb.perf_pace_overruns
+            self.robot.face_perf_quality_level = hb.perf_quality_level
+            self.robot.face_perf_quality_shed = hb.perf_quality_shed
+            self.robot.face_perf_quality_changes = hb.perf_quality_changes
+            self.robot.face_perf_idle_skip_frames = hb.perf_idle_skip_frames
+            self.robot.face_perf_idle_skip_pct = hb.perf_idle_skip_pct
+            self.robot.face_perf_mouth_cache_hits = hb.perf_mouth_cache_hits
+            self.robot.face_perf_mouth_cache_misses = hb.perf_mouth_cache_misses
+            self.robot.face_perf_mouth_cache_bytes = hb.perf_mouth_cache_bytes
+            self.robot.face_perf_mouth_cache_bytes_total = (
+                hb.perf_mouth_cache_bytes_total
+            )
+            self.robot.face_perf_flush_us_avg = hb.perf_flush_us_avg
+            self.robot.face_perf_overlap_us_avg = hb.perf_overlap_us_avg
+            self.robot.face_perf_overlap_pct = hb.perf_overlap_pct
+            self.robot.face_perf_canvas_buffers = hb.perf_canvas_buffers
+            self.robot.face_perf_direct_present = hb.perf_direct_present
 
         # Sync face button state
         btn = self._face.last_button
@@ -111,6 +111,22 @@ class HeartbeatTelemetry:
     perf_sample_div: int = 0
     perf_dirty_rect_enabled: bool = False
     perf_afterglow_downsample: int = 0
+    perf_frame_us_p95: int = 0
+    perf_pace_overruns: int = 0
+    perf_quality_level: int = 0
+    perf_quality_shed: int = 0
+    perf_quality_changes: int = 0
+    perf_idle_skip_frames: int = 0
+    perf_idle_skip_pct: int = 0
+    perf_mouth_cache_hits: int = 0
+    perf_mouth_cache_misses: int = 0
+    perf_mouth_cache_bytes: int = 0
+    perf_mouth_cache_bytes_total: int = 0
+    perf_flush_us_avg: int = 0
+    perf_overlap_us_avg: int = 0
+    perf_overlap_pct: int = 0
+    perf_canvas_buffers: int = 0
+    perf_direct_present: bool = False
     seq: int = 0
     rx_mono_ms: float = 0.0
 
@@ -452,6 +468,22 @@ class FaceClient:
                 perf_sample_div=hb.perf_sample_div,
                 perf_dirty_rect_enabled=bool(hb.perf_dirty_rect_enabled),
                 perf_afterglow_downsample=hb.perf_afterglow_downsample,
+                perf_frame_us_p95=hb.perf_frame_us_p95,
+                perf_pace_overruns=hb.perf_pace_overruns,
+                perf_quality_level=hb.perf_quality_level,
+                perf_quality_shed=hb.perf_quality_shed,
+                perf_quality_changes=hb.perf_quality_changes,
+                perf_idle_skip_frames=hb.perf_idle_skip_frames,
+                perf_idle_skip_pct=hb.perf_idle_skip_pct,
+                perf_mouth_cache_hits=hb.perf_mouth_cache_hits,
+                perf_mouth_cache_misses=hb.perf_mouth_cache_misses,
+                perf_mouth_cache_bytes=hb.perf_mouth_cache_bytes,
+                perf_mouth_cache_bytes_total=hb.perf_mouth_cache_bytes_total,
+                perf_flush_us_avg=hb.perf_flush_us_avg,
+                perf_overlap_us_avg=hb.perf_overlap_us_avg,
+                perf_overlap_pct=hb.perf_overlap_pct,
+                perf_canvas_buffers=hb.perf_canvas_buffers,
+                perf_direct_present=bool(hb.perf_direct_present),
                 seq=pkt.seq,
                 rx_mono_ms=pkt.t_pi_rx_ns / 1_000_000.0
                 if pkt.t_pi_rx_ns
@@ -516,6 +548,22 @@ class FaceClient:
                 "sample_div": hb.perf_sample_div,
                 "dirty_rect_enabled": hb.perf_dirty_rect_enabled,
                 "afterglow_downsample": hb.perf_afterglow_downsample,
+                "frame_us_p95": hb.perf_frame_us_p95,
+                "pace_overruns": hb.perf_pace_overruns,
+                "quality_level": hb.perf_quality_level,
+                "quality_shed": hb.perf_quality_shed,
+                "quality_changes": hb.perf_quality_changes,
+                "idle_skip_frames": hb.perf_idle_skip_frames,
+                "idle_skip_pct": hb.perf_idle_skip_pct,
+                "mouth_cache_hits": hb.perf_mouth_cache_hits,
+                "mouth_cache_misses": hb.perf_mouth_cache_misses,
+                "mouth_cache_bytes": hb.perf_mouth_cache_bytes,
+                "mouth_cache_bytes_total": hb.perf_mouth_cache_bytes_total,
+                "flush_us_avg": hb.perf_flush_us_avg,
+                "overlap_us_avg": hb.perf_overlap_us_avg,
+                "overlap_pct": hb.perf_overlap_pct,
+                "canvas_buffers": hb.perf_canvas_buffers,
+                "direct_present": hb.perf_direct_present,
             },
             "seq": hb.seq,
             "rx_mono_ms": round(hb.rx_mono_ms, 1),
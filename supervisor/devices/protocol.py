@@ -367,11 +367,32 @@ class FaceHeartbeatPayload:
     perf_sample_div: int = 0
     perf_dirty_rect_enabled: int = 0
     perf_afterglow_downsample: int = 0
+    perf_frame_us_p95: int = 0
+    perf_pace_overruns: int = 0
+    perf_quality_level: int = 0
+    perf_quality_shed: int = 0
+    perf_quality_changes: int = 0
+    perf_idle_skip_frames: int = 0
+    perf_idle_skip_pct: int = 0
+    perf_mouth_cache_hits: int = 0
+    perf_mouth_cache_misses: int = 0
+    perf_mouth_cache_bytes: int = 0
+    perf_mouth_cache_bytes_total: int = 0
+    perf_flush_us_avg: int = 0
+    perf_overlap_us_avg: int = 0
+    perf_overlap_pct: int = 0
+    perf_canvas_buffers: int = 0
+    perf_direct_present: int = 0
 
     _BASE_FMT = struct.Struct("<IIII")  # 16 bytes
     _USB_FMT = struct.Struct("<IIIIIIIIIIII")  # 48 bytes
     _TAIL_FMT = struct.Struct("<BBBB")  # dtr, rts, ptt_listening, reserved
     _PERF_FMT = struct.Struct("<IIIIIIIIIIIIIHBB")
+    _GOVERNOR_FMT = struct.Struct("<IIBBH")  # p95, overruns, level, shed, changes
+    _IDLE_SKIP_FMT = struct.Struct("<HBB")  # idle_skip_frames, idle_skip_pct, reserved
+    _MOUTH_CACHE_FMT = struct.Struct("<IIII")  # hits, misses, bytes, bytes_total
+    # flush_us_avg, overlap_us_avg, overlap_pct, canvas_buffers, direct_present, reserved
+    _PRESENT_FMT = struct.Struct("<IIBBBB")
 
     @classmethod
     def unpack(cls, data: bytes) -> FaceHeartbeatPayload:
@@ -428,6 +449,48 @@ class FaceHeartbeatPayload:
         if len(data) >= (perf_off + cls._PERF_FMT.size):
             perf = cls._PERF_FMT.unpack_from(data, perf_off)
 
+        governor = (
+            0,  # perf_frame_us_p95
+            0,  # perf_pace_overruns
+            0,  # perf_quality_level
+            0,  # perf_quality_shed
+            0,  # perf_quality_changes
+        )
+        governor_off = perf_off + cls._PERF_FMT.size
+        if len(data) >= (governor_off + cls._GOVERNOR_FMT.size):
+            governor = cls._GOVERNOR_FMT.unpack_from(data, governor_off)
+
+        idle_skip = (
+            0,  # perf_idle_skip_frames
+            0,  # perf_idle_skip_pct
+            0,  # reserved
+        )
+        idle_skip_off = governor_off + cls._GOVERNOR_FMT.size
+        if len(data) >= (idle_skip_off + cls._IDLE_SKIP_FMT.size):
+            idle_skip = cls._IDLE_SKIP_FMT.unpack_from(data, idle_skip_off)
+
+        mouth_cache = (
+            0,  # perf_mouth_cache_hits
+            0,  # perf_mouth_cache_misses
+            0,  # perf_mouth_cache_bytes
+            0,  # perf_mouth_cache_bytes_total
+        )
+        mouth_cache_off = idle_skip_off + cls._IDLE_SKIP_FMT.size
+        if len(data) >= (mouth_cache_off + cls._MOUTH_CACHE_FMT.size):
+            mouth_cache = cls._MOUTH_CACHE_FMT.unpack_from(data, mouth_cache_off)
+
+        present = (
+            0,  # perf_flush_us_avg
+            0,  # perf_overlap_us_avg
+            0,  # perf_overlap_pct
+            0,  # perf_canvas_buffers
+            0,  # perf_direct_present
+            0,  # reserved
+        )
+        present_off = mouth_cache_off + cls._MOUTH_CACHE_FMT.size
+        if len(data) >= (present_off + cls._PRESENT_FMT.size):
+            present = cls._PRESENT_FMT.unpack_from(data, present_off)
+
         return cls(
             uptime_ms=base[0],
             status_tx_count=base[1],
@@ -465,6 +528,22 @@ class FaceHeartbeatPayload:
             perf_sample_div=perf[13],
             perf_dirty_rect_enabled=perf[14],
             perf_afterglow_downsample=perf[15],
+            perf_frame_us_p95=governor[0],
+            perf_pace_overruns=governor[1],
+            perf_quality_level=governor[2],
+            perf_quality_shed=governor[3],
+            perf_quality_changes=governor[4],
+            perf_idle_skip_frames=idle_skip[0],
+            perf_idle_skip_pct=idle_skip[1],
+            perf_mouth_cache_hits=mouth_cache[0],
+            perf_mouth_cache_misses=mouth_cache[1],
+            perf_mouth_cache_bytes=mouth_cache[2],
+            perf_mouth_cache_bytes_total=mouth_cache[3],
+            perf_flush_us_avg=present[0],
+            perf_overlap_us_avg=present[1],
+            perf_overlap_pct=present[2],
+            perf_canvas_buffers=present[3],
+            perf_direct_present=present[4],
         )
 
 
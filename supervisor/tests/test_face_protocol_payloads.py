@@ -30,7 +30,13 @@ def test_face_status_payload_v2_unpack() -> None:
     assert status.t_state_applied_us == 5678
 
 
-def _heartbeat_payload(with_perf: bool) -> bytes:
+def _heartbeat_payload(
+    with_perf: bool,
+    with_governor: bool = False,
+    with_idle_skip: bool = False,
+    with_mouth_cache: bool = False,
+    with_present: bool = False,
+) -> bytes:
     base = struct.pack("<IIII", 1000, 10, 11, 12)
     usb = struct.pack(
         "<IIIIIIIIIIII",
@@ -70,7 +76,45 @@ def _heartbeat_payload(with_perf: bool) -> bytes:
         1,  # dirty_rect_enabled
         2,  # afterglow_downsample
     )
-    return payload + perf
+    if not with_governor:
+        return payload + perf
+    governor = struct.pack(
+        "<IIBBH",
+        38000,  # frame_us_p95
+        4,  # pace_overruns
+        2,  # quality_level
+        0x03,  # quality_shed
+        1,  # quality_changes
+    )
+    if not with_idle_skip:
+        return payload + perf + governor
+    idle_skip = struct.pack(
+        "<HBB",
+        12,  # idle_skip_frames
+        40,  # idle_skip_pct
+        0,  # reserved
+    )
+    if not with_mouth_cache:
+        return payload + perf + governor + idle_skip
+    mouth_cache = struct.pack(
+        "<IIII",
+        290,  # mouth_cache_hits
+        10,  # mouth_cache_misses
+        3072,  # mouth_cache_bytes
+        8192,  # mouth_cache_bytes_total
+    )
+    if not with_present:
+        return payload + perf + governor + idle_skip + mouth_cache
+    present = struct.pack(
+        "<IIBBBB",
+        9500,  # flush_us_avg
+        6100,  # overlap_us_avg
+        64,  # overlap_pct
+        2,  # canvas_buffers
+        1,  # direct_present
+        0,  # reserved
+    )
+    return payload + perf + governor + idle_skip + mouth_cache + present
 
 
 def test_face_heartbeat_payload_without_perf_tail() -> None:
@@ -97,6 +141,61 @@ def test_face_heartbeat_payload_with_perf_tail() -> None:
     assert hb.perf_sample_div == 8
     assert hb.perf_dirty_rect_enabled == 1
     assert hb.perf_afterglow_downsample == 2
+    assert hb.perf_frame_us_p95 == 0
+    assert hb.perf_quality_level == 0
+
+
+def test_face_heartbeat_payload_with_governor_fields() -> None:
+    hb = FaceHeartbeatPayload.unpack(_heartbeat_payload(with_perf=True, with_governor=True))
+    assert hb.perf_afterglow_downsample == 2
+    assert hb.perf_frame_us_p95 == 38000
+    assert hb.perf_pace_overruns == 4
+    assert hb.perf_quality_level == 2
+    assert hb.perf_quality_shed == 0x03
+    assert hb.perf_quality_changes == 1
+    assert hb.perf_idle_skip_frames == 0
+
+
+def test_face_heartbeat_payload_with_idle_skip_fields() -> None:
+    hb = FaceHeartbeatPayload.unpack(
+        _heartbeat_payload(with_perf=True, with_governor=True, with_idle_skip=True)
+    )
+    assert hb.perf_quality_changes == 1
+    assert hb.perf_idle_skip_frames == 12
+    assert hb.perf_idle_skip_pct == 40
+    assert hb.perf_mouth_cache_hits == 0
+
+
+def test_face_heartbeat_payload_with_mouth_cache_fields() -> None:
+    hb = FaceHeartbeatPayload.unpack(
+        _heartbeat_payload(
+            with_perf=True, with_governor=True, with_idle_skip=True, with_mouth_cache=True
+        )
+    )
+    assert hb.perf_idle_skip_pct == 40
+    assert hb.perf_mouth_cache_hits == 290
+    assert hb.perf_mouth_cache_misses == 10
+    assert hb.perf_mouth_cache_bytes == 3072
+    assert hb.perf_mouth_cache_bytes_total == 8192
+    assert hb.perf_flush_us_avg == 0
+
+
+def test_face_heartbeat_payload_with_present_fields() -> None:
+    hb = FaceHeartbeatPayload.unpack(
+        _heartbeat_payload(
+            with_perf=True,
+            with_governor=True,
+            with_idle_skip=True,
+            with_mouth_cache=True,
+            with_present=True,
+        )
+    )
+    assert hb.perf_mouth_cache_bytes_total == 8192
+    assert hb.perf_flush_us_avg == 9500
+    assert hb.perf_overlap_us_avg == 6100
+    assert hb.perf_overlap_pct == 64
+    assert hb.perf_canvas_buffers == 2
+    assert hb.perf_direct_present == 1
 
 
 def test_protocol_capture_decode_face_status_v2_fields() -> None:
@@ -118,3 +217,57 @@ def test_protocol_capture_decode_heartbeat_perf_tail() -> None:
     assert decoded["perf"]["window_frames"] == 33
     assert decoded["perf"]["sample_div"] == 8
     assert decoded["perf"]["dirty_rect_enabled"] is True
+    assert "quality_level" not in decoded["perf"]
+
+
+def test_protocol_capture_decode_heartbeat_governor_fields() -> None:
+    decoded = _decode_fields(0x93, _heartbeat_payload(with_perf=True, with_governor=True))
+    assert decoded["perf"]["frame_us_p95"] == 38000
+    assert decoded["perf"]["pace_overruns"] == 4
+    assert decoded["perf"]["quality_level"] == 2
+    assert decoded["perf"]["quality_shed"] == "0x03"
+    assert decoded["perf"]["quality_changes"] == 1
+    assert "idle_skip_pct" not in decoded["perf"]
+
+
+def test_protocol_capture_decode_heartbeat_idle_skip_fields() -> None:
+    decoded = _decode_fields(
+        0x93, _heartbeat_payload(with_perf=True, with_governor=True, with_idle_skip=True)
+    )
+    assert decoded["perf"]["idle_skip_frames"] == 12
+    assert decoded["perf"]["idle_skip_pct"] == 40
+    assert "mouth_cache_hits" not in decoded["perf"]
+
+
+def test_protocol_capture_decode_heartbeat_mouth_cache_fields() -> None:
+    decoded = _decode_fields(
+        0x93,
+        _heartbeat_payload(
+            with_perf=True, with_governor=True, with_idle_skip=True, with_mouth_cache=True
+        ),
+    )
+    assert decoded["perf"]["idle_skip_pct"] == 40
+    assert decoded["perf"]["mouth_cache_hits"] == 290
+    assert decoded["perf"]["mouth_cache_misses"] == 10
+    assert decoded["perf"]["mouth_cache_bytes"] == 3072
+    assert decoded["perf"]["mouth_cache_bytes_total"] == 8192
+    assert "flush_us_avg" not in decoded["perf"]
+
+
+def test_protocol_capture_decode_heartbeat_present_fields() -> None:
+    decoded = _decode_fields(
+        0x93,
+        _heartbeat_payload(
+            with_perf=True,
+            with_governor=True,
+            with_idle_skip=True,
+            with_mouth_cache=True,
+            with_present=True,
+        ),
+    )
+    assert decoded["perf"]["mouth_cache_hits"] == 290
+    assert decoded["perf"]["flush_us_avg"] == 9500
+    assert decoded["perf"]["overlap_us_avg"] == 6100
+    assert decoded["perf"]["overlap_pct"] == 64
+    assert decoded["perf"]["canvas_buffers"] == 2
+    assert decoded["perf"]["direct_present"] is True